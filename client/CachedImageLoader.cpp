@@ -1,9 +1,10 @@
 #include "CachedImageLoader.h"
 
 #include <QBuffer>
-#include <QImage>
+#include <QFutureWatcher>
 #include <QImageReader>
-#include <QUrl>
+#include <QThreadPool>
+#include <QtConcurrent>
 
 #include "ImageCache.h"
 #include "NetworkFileLoader.h"
@@ -11,10 +12,13 @@
 
 
 CachedImageLoader::CachedImageLoader( ImageCache*      imageCache,
+                                      QThreadPool*     decodeThreadPool,
                                       Logging::Config  loggingConfig,
                                       QObject*         parent )
   : QObject( parent ),
     mImageCache( imageCache ),
+    mDecodeThreadPool( decodeThreadPool ),
+    mCancelled( std::make_shared<QAtomicInt>( 0 ) ),
     mLogger( loggingConfig.createLogger() )
 {
     mNetworkFileLoader = new NetworkFileLoader( loggingConfig.createChildConfig( "netloader" ), this );
@@ -22,34 +26,102 @@ CachedImageLoader::CachedImageLoader( ImageCache*      imageCache,
 }
 
 
-void
-CachedImageLoader::loadImage( const QUrl& url, const QVariant& token )
+CachedImageLoader::~CachedImageLoader()
 {
-    QImage image;
+    // Decodes still queued for this loader will skip their work.  Their
+    // watchers are children and go away with us, so nothing is emitted.
+    mCancelled->store( 1 );
+}
+
 
-    // Try reading from the cache; if we find something we're done.
+void
+CachedImageLoader::loadImage( const QUrl& url, const QVariant& token, float zoomFactor )
+{
+    // Try reading from the cache; if that fails fall back to the network.
     if( mImageCache != 0 )
     {
         QString cacheImageName = getCacheImageName( token );
         if( !cacheImageName.isEmpty() )
         {
-            bool readResult = mImageCache->tryReadFromCache( getCacheImageName( token ), image );
-            if( readResult )
-            {
-                emit imageLoaded( token, image );
-                return;
-            }
+            watchDecode( QtConcurrent::run( mDecodeThreadPool, &CachedImageLoader::readFromCache,
+                                            mImageCache, cacheImageName, zoomFactor, mCancelled ),
+                         token, zoomFactor, url );
+            return;
         }
     }
 
-    // Start a network image load.
-    mNetworkFileLoader->loadFile( url, token );
+    // Start a network image load.  The zoom factor rides along with the
+    // token until the file is loaded.
+    mNetworkFileLoader->loadFile( url, QVariantList() << token << zoomFactor );
 }
 
 
 void
-CachedImageLoader::networkFileLoaded( const QVariant& token, const QByteArray& fileData )
+CachedImageLoader::networkFileLoaded( const QVariant& networkToken, const QByteArray& fileData )
 {
+    const QVariantList networkTokenList = networkToken.toList();
+    const QVariant token = networkTokenList.value( 0 );
+    const float zoomFactor = networkTokenList.value( 1 ).toFloat();
+
+    const QString cacheImageName = (mImageCache != nullptr) ? getCacheImageName( token ) : QString();
+    watchDecode( QtConcurrent::run( mDecodeThreadPool, &CachedImageLoader::decodeFileData,
+                                    mImageCache, cacheImageName, fileData, zoomFactor, mCancelled ),
+                 token, zoomFactor, QUrl() );
+}
+
+
+void
+CachedImageLoader::watchDecode( const QFuture<DecodeResult>& future,
+                                const QVariant&              token,
+                                float                        zoomFactor,
+                                const QUrl&                  networkUrl )
+{
+    QFutureWatcher<DecodeResult>* watcher = new QFutureWatcher<DecodeResult>( this );
+    connect( watcher, &QFutureWatcher<DecodeResult>::finished, this, [=]() {
+            const DecodeResult result = watcher->result();
+            watcher->deleteLater();
+
+            if( result.success )
+            {
+                emit imageLoaded( token, result.image, result.scaledImage, zoomFactor );
+            }
+            else if( networkUrl.isValid() )
+            {
+                mNetworkFileLoader->loadFile( networkUrl, QVariantList() << token << zoomFactor );
+            }
+            else
+            {
+                mLogger->warn( "Failed to read image from network data" );
+            }
+        } );
+    watcher->setFuture( future );
+}
+
+
+CachedImageLoader::DecodeResult
+CachedImageLoader::readFromCache( ImageCache*                 imageCache,
+                                  const QString&              cacheImageName,
+                                  float                       zoomFactor,
+                                  std::shared_ptr<QAtomicInt> cancelled )
+{
+    DecodeResult result;
+    if( cancelled->load() ) return result;
+
+    result.success = imageCache->tryReadFromCache( cacheImageName, result.image );
+    if( result.success && !cancelled->load() ) scaleImage( result, zoomFactor );
+    return result;
+}
+
+
+CachedImageLoader::DecodeResult
+CachedImageLoader::decodeFileData( ImageCache*                 imageCache,
+                                   const QString&              cacheImageName,
+                                   const QByteArray&           fileData,
+                                   float                       zoomFactor,
+                                   std::shared_ptr<QAtomicInt> cancelled )
+{
+    DecodeResult result;
+
     QBuffer buf;
     buf.setData( fileData );
     QImageReader imgReader;
@@ -59,21 +131,34 @@ CachedImageLoader::networkFileLoaded( const QVariant& token, const QByteArray& f
     QString extension = "." + imgReader.format();
     if( extension == ".jpeg" ) extension = ".jpg";
 
-    QImage image;
-    if( imgReader.read( &image ) )
+    // Even if nobody wants the image anymore, it's worth caching.
+    if( cancelled->load() )
     {
-        if( (mImageCache != nullptr) && !image.isNull() )
+        if( (imageCache != nullptr) && !cacheImageName.isEmpty() && imgReader.canRead() )
         {
-            const QString cacheImageName = getCacheImageName( token );
-            if( !cacheImageName.isEmpty() )
-            {
-                mImageCache->tryWriteToCache( cacheImageName, extension, fileData );
-            }
+            imageCache->tryWriteToCache( cacheImageName, extension, fileData );
         }
-        emit imageLoaded( token, image );
+        return result;
     }
-    else
+
+    if( imgReader.read( &result.image ) && !result.image.isNull() )
     {
-        mLogger->warn( "Failed to read image from network data" );
+        if( (imageCache != nullptr) && !cacheImageName.isEmpty() )
+        {
+            imageCache->tryWriteToCache( cacheImageName, extension, fileData );
+        }
+        result.success = true;
+        if( !cancelled->load() ) scaleImage( result, zoomFactor );
     }
+    return result;
+}
+
+
+void
+CachedImageLoader::scaleImage( DecodeResult& result, float zoomFactor )
+{
+    if( (zoomFactor == 1.0f) || (zoomFactor <= 0.0f) ) return;
+
+    QSize scaledSize = result.image.size() * zoomFactor;
+    result.scaledImage = result.image.scaled( scaledSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation );
 }
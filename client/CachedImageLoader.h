@@ -2,22 +2,42 @@
 #define CACHEDIMAGELOADER_H
 
 #include <QObject>
+#include <QAtomicInt>
+#include <QFuture>
+#include <QImage>
+#include <QUrl>
+#include <memory>
 
 class ImageCache;
 class NetworkFileLoader;
 
+QT_BEGIN_NAMESPACE
+class QThreadPool;
+QT_END_NAMESPACE
+
 #include "Logging.h"
 
 // This is an abstract base class used to handle cache management and
 // loading of network images.  Derived classes must implement
 // getCacheImageName() to return the cache image name given a token
 // like the one submitted to loadImage().
+//
+// Cache file I/O, image decoding and scaling run on a thread pool so the
+// GUI thread never blocks on them.  Loads still in progress when the
+// loader is destroyed are abandoned and never signalled.
 class CachedImageLoader : public QObject
 {
     Q_OBJECT
 
+public:
+
+    virtual ~CachedImageLoader();
+
 signals:
-    void imageLoaded( const QVariant& token, const QImage& image );
+
+    // The scaled image is the image pre-scaled by the zoom factor passed
+    // to loadImage(), or a null image if that factor was 1.
+    void imageLoaded( const QVariant& token, const QImage& image, const QImage& scaledImage, float zoomFactor );
 
 private slots:
     void networkFileLoaded( const QVariant& token, const QByteArray& fileData );
@@ -25,10 +45,11 @@ private slots:
 protected:
 
     CachedImageLoader( ImageCache*     imageCache,
+                       QThreadPool*    decodeThreadPool,
                        Logging::Config loggingConfig = Logging::Config(),
                        QObject*        parent = 0 );
 
-    void loadImage( const QUrl& url, const QVariant& token );
+    void loadImage( const QUrl& url, const QVariant& token, float zoomFactor = 1.0f );
 
     // Get cache image name for token.  Derived classes must implement this
     // to complete support for cache read/wrote.  Return an empty string if
@@ -37,8 +58,40 @@ protected:
 
 private:
 
-    ImageCache* const        mImageCache;
-    NetworkFileLoader*       mNetworkFileLoader;
+    struct DecodeResult
+    {
+        DecodeResult() : success( false ) {}
+
+        bool   success;
+        QImage image;
+        QImage scaledImage;
+    };
+
+    // Thread pool functions.
+    static DecodeResult readFromCache( ImageCache*                 imageCache,
+                                       const QString&              cacheImageName,
+                                       float                       zoomFactor,
+                                       std::shared_ptr<QAtomicInt> cancelled );
+    static DecodeResult decodeFileData( ImageCache*                 imageCache,
+                                        const QString&              cacheImageName,
+                                        const QByteArray&           fileData,
+                                        float                       zoomFactor,
+                                        std::shared_ptr<QAtomicInt> cancelled );
+    static void scaleImage( DecodeResult& result, float zoomFactor );
+
+    // Emit the decode result when finished.  If the decode fails and the
+    // url is valid, load the image from the network instead.
+    void watchDecode( const QFuture<DecodeResult>& future,
+                      const QVariant&              token,
+                      float                        zoomFactor,
+                      const QUrl&                  networkUrl );
+
+    ImageCache* const               mImageCache;
+    QThreadPool* const              mDecodeThreadPool;
+    NetworkFileLoader*              mNetworkFileLoader;
+
+    // Set when the loader is destroyed so that queued decodes are skipped.
+    std::shared_ptr<QAtomicInt>     mCancelled;
 
     std::shared_ptr<spdlog::logger> mLogger;
 };
@@ -4,27 +4,28 @@
 #include <QVariant>
 
 CardImageLoader::CardImageLoader( ImageCache*      imageCache,
+                                  QThreadPool*     decodeThreadPool,
                                   const QString&   urlTemplateStr,
                                   Logging::Config  loggingConfig,
                                   QObject*         parent )
-  : CachedImageLoader( imageCache, loggingConfig, parent ),
+  : CachedImageLoader( imageCache, decodeThreadPool, loggingConfig, parent ),
     mUrlTemplateStr( urlTemplateStr ),
     mLogger( loggingConfig.createLogger() )
 {
-    connect( this, &CachedImageLoader::imageLoaded, [this](const QVariant& token, const QImage& image) {
-            emit imageLoaded( token.toInt(), image );
+    connect( this, &CachedImageLoader::imageLoaded, [this](const QVariant& token, const QImage& image, const QImage& scaledImage, float zoomFactor) {
+            emit imageLoaded( token.toInt(), image, scaledImage, zoomFactor );
         } );
 
 }
 
 
 void
-CardImageLoader::loadImage( int multiverseId )
+CardImageLoader::loadImage( int multiverseId, float zoomFactor )
 {
     QString imageUrlStr( mUrlTemplateStr );
     imageUrlStr.replace( "%muid%", QString::number( multiverseId ) );
     QUrl url( imageUrlStr );
-    CachedImageLoader::loadImage( url, QVariant( multiverseId ) );
+    CachedImageLoader::loadImage( url, QVariant( multiverseId ), zoomFactor );
 }
 
 
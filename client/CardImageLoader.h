@@ -14,14 +14,16 @@ class CardImageLoader : public CachedImageLoader
 
 public:
     CardImageLoader( ImageCache*     imageCache,
+                     QThreadPool*    decodeThreadPool,
                      const QString&  urlTemplateStr,
                      Logging::Config loggingConfig = Logging::Config(),
                      QObject*        parent = 0 );
 
-    void loadImage( int multiverseId );
+    // The image is also delivered pre-scaled by zoomFactor unless it is 1.
+    void loadImage( int multiverseId, float zoomFactor = 1.0f );
 
 signals:
-    void imageLoaded( int multiverseId, const QImage& image );
+    void imageLoaded( int multiverseId, const QImage& image, const QImage& scaledImage, float zoomFactor );
 
 
 protected:
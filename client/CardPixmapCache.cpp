@@ -0,0 +1,144 @@
+#include "CardPixmapCache.h"
+
+#include <QImage>
+#include <QTransform>
+
+
+uint
+qHash( const CardPixmapCache::Key& key, uint seed )
+{
+    return qHash( key.muid, seed ) ^ qHash( (key.zoomPercent << 16) | (key.rotation & 0xffff), seed );
+}
+
+
+static int
+getZoomPercent( float zoomFactor )
+{
+    return qMax( qRound( zoomFactor * 100.0f ), 1 );
+}
+
+
+static quint64
+getPixmapBytes( const QPixmap& pixmap )
+{
+    return quint64( pixmap.width() ) * pixmap.height() * pixmap.depth() / 8;
+}
+
+
+CardPixmapCache::CardPixmapCache( quint64         maxBytes,
+                                  Logging::Config loggingConfig )
+  : mMaxBytes( maxBytes ),
+    mCurrentBytes( 0 ),
+    mLogger( loggingConfig.createLogger() )
+{}
+
+
+void
+CardPixmapCache::setMaxBytes( quint64 maxBytes )
+{
+    mMaxBytes = maxBytes;
+    evict();
+}
+
+
+QPixmap
+CardPixmapCache::insert( int multiverseId, const QImage& image, float zoomFactor )
+{
+    const Key key( multiverseId, getZoomPercent( zoomFactor ), 0 );
+
+    // Another widget may have loaded the same card in the meantime.
+    QPixmap pixmap = lookup( key );
+    if( pixmap.isNull() )
+    {
+        pixmap = QPixmap::fromImage( image );
+        add( key, pixmap );
+    }
+    return pixmap;
+}
+
+
+QPixmap
+CardPixmapCache::get( int multiverseId, float zoomFactor, int rotation )
+{
+    rotation = ((rotation % 360) + 360) % 360;
+    const Key key( multiverseId, getZoomPercent( zoomFactor ), rotation );
+
+    QPixmap pixmap = lookup( key );
+    if( !pixmap.isNull() ) return pixmap;
+
+    // Derive the variant from the unscaled pixmap.
+    QPixmap basePixmap = lookup( Key( multiverseId, 100, 0 ) );
+    if( basePixmap.isNull() ) return pixmap;
+
+    pixmap = basePixmap;
+    if( key.zoomPercent != 100 )
+    {
+        QSize scaledSize = basePixmap.size() * (key.zoomPercent / 100.0);
+        pixmap = pixmap.scaled( scaledSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation );
+    }
+    if( key.rotation != 0 )
+    {
+        QTransform transform;
+        transform.rotate( key.rotation );
+        pixmap = pixmap.transformed( transform );
+    }
+
+    add( key, pixmap );
+    return pixmap;
+}
+
+
+QPixmap
+CardPixmapCache::lookup( const Key& key )
+{
+    auto iter = mEntries.find( key );
+    if( iter == mEntries.end() ) return QPixmap();
+
+    mLruList.splice( mLruList.begin(), mLruList, iter->lruIter );
+    return iter->pixmap;
+}
+
+
+void
+CardPixmapCache::add( const Key& key, const QPixmap& pixmap )
+{
+    mLruList.push_front( key );
+
+    Entry entry;
+    entry.pixmap = pixmap;
+    entry.bytes = getPixmapBytes( pixmap );
+    entry.lruIter = mLruList.begin();
+    mEntries.insert( key, entry );
+    mCurrentBytes += entry.bytes;
+
+    mLogger->debug( "added pixmap muid={} zoom={}% rot={} ({} bytes, {} total)",
+            key.muid, key.zoomPercent, key.rotation, entry.bytes, mCurrentBytes );
+
+    evict();
+}
+
+
+void
+CardPixmapCache::evict()
+{
+    // Walk from least-recently used, skipping pixmaps that are still
+    // shared with a widget; evicting those wouldn't free anything.
+    auto lruIter = mLruList.end();
+    while( (mCurrentBytes > mMaxBytes) && (lruIter != mLruList.begin()) )
+    {
+        --lruIter;
+        auto iter = mEntries.find( *lruIter );
+        if( !iter->pixmap.isDetached() ) continue;
+
+        mLogger->debug( "evicting pixmap muid={} zoom={}% rot={}",
+                iter.key().muid, iter.key().zoomPercent, iter.key().rotation );
+        mCurrentBytes -= iter->bytes;
+        mEntries.erase( iter );
+        lruIter = mLruList.erase( lruIter );
+    }
+
+    if( mCurrentBytes > mMaxBytes )
+    {
+        mLogger->debug( "pixmaps in use exceed cache limit: {} bytes", mCurrentBytes );
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef CARDPIXMAPCACHE_H
+#define CARDPIXMAPCACHE_H
+
+#include <QHash>
+#include <QPixmap>
+#include <list>
+
+#include "Logging.h"
+
+QT_BEGIN_NAMESPACE
+class QImage;
+QT_END_NAMESPACE
+
+// In-memory cache of decoded card pixmaps shared by all card widgets.
+//
+// Pixmaps are keyed by multiverse id, zoom (bucketed to whole percents)
+// and rotation.  The unscaled pixmap for a card is inserted once when its
+// image is loaded; scaled and rotated variants are derived from it on
+// first request, so duplicate cards share one decode and one scale.
+//
+// Entries are reference-counted through QPixmap's implicit sharing: a
+// pixmap handed out is still in use while any copy is alive.  When the
+// cache grows past its byte limit the least-recently-used entries that
+// are no longer in use are evicted.
+class CardPixmapCache
+{
+public:
+
+    CardPixmapCache( quint64         maxBytes,
+                     Logging::Config loggingConfig = Logging::Config() );
+
+    int getCount() const { return mEntries.size(); }
+    quint64 getCurrentBytes() const { return mCurrentBytes; }
+
+    void setMaxBytes( quint64 maxBytes );
+
+    // Insert the image for a card at a zoom factor and return its pixmap.
+    // The unscaled image (zoom factor 1) must be inserted for other zoom
+    // factors and rotations to be derived.
+    QPixmap insert( int multiverseId, const QImage& image, float zoomFactor = 1.0f );
+
+    // Return the pixmap for a card at a zoom factor and rotation (in
+    // degrees), or a null pixmap if no image was inserted for the card.
+    QPixmap get( int multiverseId, float zoomFactor = 1.0f, int rotation = 0 );
+
+private:
+
+    struct Key
+    {
+        Key( int muid, int zoomPercent, int rotation )
+          : muid( muid ), zoomPercent( zoomPercent ), rotation( rotation ) {}
+
+        bool operator==( const Key& other ) const
+        {
+            return (muid == other.muid) && (zoomPercent == other.zoomPercent) && (rotation == other.rotation);
+        }
+
+        int muid;
+        int zoomPercent;
+        int rotation;
+    };
+    friend uint qHash( const Key& key, uint seed );
+
+    typedef std::list<Key> LruList;
+
+    struct Entry
+    {
+        QPixmap           pixmap;
+        quint64           bytes;
+        LruList::iterator lruIter;
+    };
+
+    QPixmap lookup( const Key& key );
+    void add( const Key& key, const QPixmap& pixmap );
+    void evict();
+
+    QHash<Key,Entry>                mEntries;
+
+    // Most recently used at the front.
+    LruList                         mLruList;
+
+    quint64                         mMaxBytes;
+    quint64                         mCurrentBytes;
+
+    std::shared_ptr<spdlog::logger> mLogger;
+};
+
+#endif  // CARDPIXMAPCACHE_H
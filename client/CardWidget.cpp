@@ -130,18 +130,12 @@ CardWidget::updateScaling()
     {
         setStyleSheet( "" );
 
-        if( mZoomFactor == 1.0f )
-        {
-            setPixmap( mPixmap );
-            setFixedSize( mPixmap.size() );
-        }
-        else
-        {
-            QSize scaledSize = mPixmap.size() * mZoomFactor;
-            QPixmap scaledPixmap = mPixmap.scaled( scaledSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation );
-            setPixmap( scaledPixmap );
-            setFixedSize( scaledSize );
-        }
+        // Scaled pixmaps are shared with other widgets showing the same card.
+        QPixmap scaledPixmap = mImageLoaderFactory->getCardPixmapCache()->get(
+                mCardDataSharedPtr->getMultiverseId(), mZoomFactor );
+        if( scaledPixmap.isNull() ) scaledPixmap = mPixmap;
+        setPixmap( scaledPixmap );
+        setFixedSize( scaledPixmap.size() );
     }
 
     adjustSize();
@@ -195,11 +189,20 @@ CardWidget::loadImage()
         return;
     }
 
+    // Skip loading entirely if another widget already has this card.
+    QPixmap pixmap = mImageLoaderFactory->getCardPixmapCache()->get( muid );
+    if( !pixmap.isNull() )
+    {
+        mPixmap = pixmap;
+        updateScaling();
+        return;
+    }
+
     if( mCardImageLoader != 0 ) mCardImageLoader->deleteLater();
     mCardImageLoader = mImageLoaderFactory->createCardImageLoader(
             mLoggingConfig.createChildConfig( "imageloader" ), this );
     connect( mCardImageLoader, &CardImageLoader::imageLoaded, this, &CardWidget::handleImageLoaded );
-    mCardImageLoader->loadImage( muid );
+    mCardImageLoader->loadImage( muid, mZoomFactor );
 }
 
 
@@ -246,13 +249,17 @@ CardWidget::mouseMoveEvent( QMouseEvent *event )
 
 
 void
-CardWidget::handleImageLoaded( int multiverseId, const QImage &image )
+CardWidget::handleImageLoaded( int multiverseId, const QImage &image, const QImage& scaledImage, float zoomFactor )
 {
     mLogger->debug( "image {} loaded", multiverseId );
 
     if( mCardDataSharedPtr->getMultiverseId() == multiverseId )
     {
-        mPixmap = QPixmap::fromImage( image );
+        // The loader scaled the image off the GUI thread; seed the pixmap
+        // cache with it so updateScaling() doesn't scale again.
+        CardPixmapCache* pixmapCache = mImageLoaderFactory->getCardPixmapCache();
+        mPixmap = pixmapCache->insert( multiverseId, image );
+        if( !scaledImage.isNull() ) pixmapCache->insert( multiverseId, scaledImage, zoomFactor );
         updateScaling();
     }
     else
@@ -278,9 +285,9 @@ CardWidget::enterEvent( QEvent* event )
         // show a normal tooltip if the view is zoomed out.
         if( mCardDataSharedPtr->isSplit() )
         {
-            QTransform transform;
-            transform.rotate( 90 );
-            QPixmap rotatedPixmap = mPixmap.transformed( transform );
+            QPixmap rotatedPixmap = mImageLoaderFactory->getCardPixmapCache()->get(
+                    mCardDataSharedPtr->getMultiverseId(), 1.0f, 90 );
+            if( rotatedPixmap.isNull() ) rotatedPixmap = mPixmap;
             mToolTipStr = qtutils::getPixmapAsHtmlText( rotatedPixmap );
         }
         else if( mZoomFactor < 1.0f )
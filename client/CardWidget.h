@@ -63,7 +63,7 @@ protected:
     virtual bool event( QEvent* event ) override;
 
 private slots:
-    void handleImageLoaded( int multiverseId, const QImage &image );
+    void handleImageLoaded( int multiverseId, const QImage &image, const QImage& scaledImage, float zoomFactor );
 
 private:
 
@@ -78,7 +78,8 @@ private:
     QSize             mDefaultSize;
     float             mZoomFactor;
 
-    // A copy of the original-sized pixmap obtained from ImageLoader.
+    // The original-sized pixmap, shared with the pixmap cache.  Holding it
+    // keeps the card's entry from being evicted.
     QPixmap           mPixmap;
 
     // The string for the default tooltip.
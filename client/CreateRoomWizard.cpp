@@ -26,6 +26,7 @@
 
 #include "ImageLoaderFactory.h"
 #include "ExpSymImageLoader.h"
+#include "CustomCardListHash.h"
 
 #include "qtutils_core.h"
 #include "qtutils_widget.h"
@@ -94,6 +95,7 @@ CreateRoomWizard::fillRoomConfig( proto::RoomConfig* roomConfig ) const
             cardQty->set_set_code( c.getSetCode() );
             cardQty->set_quantity( qty );
         }
+        ccl->set_content_hash( computeCustomCardListHash( *ccl ) );
     }
 
 
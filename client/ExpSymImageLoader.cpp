@@ -6,11 +6,12 @@
 #include "AllSetsData.h"
 
 ExpSymImageLoader::ExpSymImageLoader( ImageCache*          imageCache,
+                                      QThreadPool*         decodeThreadPool,
                                       const QString&       urlTemplateStr,
                                       AllSetsDataSharedPtr allSetsData,
                                       Logging::Config      loggingConfig,
                                       QObject*             parent )
-  : CachedImageLoader( imageCache, loggingConfig, parent ),
+  : CachedImageLoader( imageCache, decodeThreadPool, loggingConfig, parent ),
     mUrlTemplateStr( urlTemplateStr ),
     mAllSetsData( allSetsData ),
     mLogger( loggingConfig.createLogger() )
@@ -12,6 +12,7 @@ class ExpSymImageLoader : public CachedImageLoader
 
 public:
     ExpSymImageLoader( ImageCache*          imageCache,
+                       QThreadPool*         decodeThreadPool,
                        const QString&       urlTemplateStr,
                        AllSetsDataSharedPtr allSetsData,
                        Logging::Config      loggingConfig = Logging::Config(),
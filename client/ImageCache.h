@@ -9,6 +9,8 @@ class QImage;
 class QString;
 QT_END_NAMESPACE
 
+// Image loaders read and write from a thread pool, so implementations
+// must be safe to call from multiple threads at once.
 class ImageCache
 {
 public:
@@ -3,6 +3,9 @@
 #include "CardImageLoader.h"
 #include "ExpSymImageLoader.h"
 
+// Enough for a few hundred full-size card images plus scaled variants.
+static const quint64 CARD_PIXMAP_CACHE_MAX_BYTES = 256 * 1024 * 1024;
+
 ImageLoaderFactory::ImageLoaderFactory( AllSetsDataSharedPtr allSetsData,
                                         ImageCache*          cardImageCache,
                                         const QString&       cardImageUrlTemplateStr,
@@ -14,7 +17,8 @@ ImageLoaderFactory::ImageLoaderFactory( AllSetsDataSharedPtr allSetsData,
     mCardImageCache( cardImageCache ),
     mCardImageUrlTemplateStr( cardImageUrlTemplateStr ),
     mExpSymImageCache( expSymImageCache ),
-    mExpSymImageUrlTemplateStr( expSymImageUrlTemplateStr )
+    mExpSymImageUrlTemplateStr( expSymImageUrlTemplateStr ),
+    mCardPixmapCache( CARD_PIXMAP_CACHE_MAX_BYTES )
 {}
 
 
@@ -22,7 +26,7 @@ CardImageLoader*
 ImageLoaderFactory::createCardImageLoader( Logging::Config loggingConfig,
                                            QObject*        parent )
 {
-    return new CardImageLoader( mCardImageCache, mCardImageUrlTemplateStr, loggingConfig, parent );
+    return new CardImageLoader( mCardImageCache, &mDecodeThreadPool, mCardImageUrlTemplateStr, loggingConfig, parent );
 }
 
 
@@ -30,5 +34,5 @@ ExpSymImageLoader*
 ImageLoaderFactory::createExpSymImageLoader( Logging::Config loggingConfig,
                                              QObject*        parent )
 {
-    return new ExpSymImageLoader( mExpSymImageCache, mExpSymImageUrlTemplateStr, mAllSetsData, loggingConfig, parent );
+    return new ExpSymImageLoader( mExpSymImageCache, &mDecodeThreadPool, mExpSymImageUrlTemplateStr, mAllSetsData, loggingConfig, parent );
 }
@@ -2,8 +2,10 @@
 #define IMAGELOADERFACTORY_H
 
 #include <QObject>
+#include <QThreadPool>
 #include "Logging.h"
 #include "clienttypes.h"
+#include "CardPixmapCache.h"
 
 class ImageCache;
 class CardImageLoader;
@@ -28,6 +30,10 @@ public:
 
     ExpSymImageLoader* createExpSymImageLoader( Logging::Config loggingConfig = Logging::Config(),
                                                 QObject*        parent = 0 );
+
+    // Decoded card pixmaps shared by everything using this factory.
+    CardPixmapCache* getCardPixmapCache() { return &mCardPixmapCache; }
+
 private:
 
     AllSetsDataSharedPtr     mAllSetsData;
@@ -35,6 +41,11 @@ private:
     const QString            mCardImageUrlTemplateStr;
     ImageCache* const        mExpSymImageCache;
     const QString            mExpSymImageUrlTemplateStr;
+    CardPixmapCache          mCardPixmapCache;
+
+    // Decodes images for all loaders.  Destroying the pool waits for
+    // running decodes to finish.
+    QThreadPool              mDecodeThreadPool;
 };
 
 #endif  // IMAGELOADERFACTORY_H
@@ -3,9 +3,11 @@
 #include <QFile>
 #include <QTextStream>
 #include "qtutils_core.h"
+#include "MtgJsonAllSetsData.h"
 
 static const QString ALLSETS_FILENAME( "AllSets.json" );
 static const QString ALLSETS_VERSION_FILENAME( ".allsets_version" );
+static const QString ALLSETS_SNAPSHOT_FILENAME( "AllSets.snapshot" );
 
 QString
 MtgJsonAllSetsFileCache::getCachedFilePath( const AllSetsUpdateChannel::ChannelType& channel ) const
@@ -15,6 +17,14 @@ MtgJsonAllSetsFileCache::getCachedFilePath( const AllSetsUpdateChannel::ChannelT
 }
 
 
+QString
+MtgJsonAllSetsFileCache::getCachedSnapshotFilePath( const AllSetsUpdateChannel::ChannelType& channel ) const
+{
+    const QDir channelDir = getChannelDir( channel );
+    return channelDir.filePath( ALLSETS_SNAPSHOT_FILENAME );
+}
+
+
 QString
 MtgJsonAllSetsFileCache::getCachedFileVersion( const AllSetsUpdateChannel::ChannelType& channel ) const
 {
@@ -136,6 +146,50 @@ recover_allsets_file:
 }
 
 
+bool
+MtgJsonAllSetsFileCache::commitSnapshot( const AllSetsUpdateChannel::ChannelType& channel, const MtgJsonAllSetsData& allSetsData, const QString& version )
+{
+    const QDir channelDir = getChannelDir( channel );
+    const QString snapshotFilePath( channelDir.filePath( ALLSETS_SNAPSHOT_FILENAME ) );
+    const QString newSnapshotFilePath( channelDir.filePath( ALLSETS_SNAPSHOT_FILENAME + ".new" ) );
+
+    if( !channelDir.exists() )
+    {
+        mLogger->warn( "set data channel cache directory does not exist" );
+        return false;
+    }
+
+    // Write to a new file and swap it into place so a reader never maps a
+    // partially-written snapshot.
+    const std::string newSnapshotFilePathStr = newSnapshotFilePath.toStdString();
+    FILE* fp = fopen( newSnapshotFilePathStr.c_str(), "wb" );
+    if( fp == NULL )
+    {
+        mLogger->warn( "error opening snapshot file {}", newSnapshotFilePath );
+        return false;
+    }
+    bool writeOk = allSetsData.writeSnapshot( fp, version.toStdString() );
+    fclose( fp );
+    if( !writeOk )
+    {
+        mLogger->warn( "error writing snapshot file {}", newSnapshotFilePath );
+        QFile::remove( newSnapshotFilePath );
+        return false;
+    }
+
+    QFile::remove( snapshotFilePath );
+    if( !QFile::rename( newSnapshotFilePath, snapshotFilePath ) )
+    {
+        mLogger->warn( "error renaming {} to {}", newSnapshotFilePath, snapshotFilePath );
+        QFile::remove( newSnapshotFilePath );
+        return false;
+    }
+
+    mLogger->debug( "committed snapshot for version {}", version );
+    return true;
+}
+
+
 QDir
 MtgJsonAllSetsFileCache::getChannelDir( const AllSetsUpdateChannel::ChannelType& channel ) const
 {
@@ -5,6 +5,8 @@
 #include "Logging.h"
 #include "AllSetsUpdateChannel.h"
 
+class MtgJsonAllSetsData;
+
 class MtgJsonAllSetsFileCache
 {
 
@@ -19,9 +21,17 @@ public:
     QString getCachedFilePath( const AllSetsUpdateChannel::ChannelType& channel ) const;
     QString getCachedFileVersion( const AllSetsUpdateChannel::ChannelType& channel ) const;
 
+    // Path of the precompiled snapshot of the cached file.  The snapshot
+    // is tagged with the version it was written for.
+    QString getCachedSnapshotFilePath( const AllSetsUpdateChannel::ChannelType& channel ) const;
+
     // Commit file and version info to the application's storage area.
     bool commit( const AllSetsUpdateChannel::ChannelType& channel, const QString& filePath, const QString& version );
 
+    // Write a snapshot of parsed data for a version to the application's
+    // storage area.
+    bool commitSnapshot( const AllSetsUpdateChannel::ChannelType& channel, const MtgJsonAllSetsData& allSetsData, const QString& version );
+
 private:
 
     QDir getChannelDir( const AllSetsUpdateChannel::ChannelType& channel ) const;
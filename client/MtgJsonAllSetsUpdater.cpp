@@ -584,6 +584,11 @@ MtgJsonAllSetsUpdater::parsingFinished()
     if( mMtgJsonAllSetsFileCache != nullptr )
     {
         cached = mMtgJsonAllSetsFileCache->commit( mUpdateChannel, mTmpFile->fileName(), mUpdateVersion );
+        if( cached && !mMtgJsonAllSetsFileCache->commitSnapshot( mUpdateChannel, *mParseAllSetsDataPtr, mUpdateVersion ) )
+        {
+            // Not fatal, the next startup will parse and try again.
+            mLogger->notice( "failed to cache AllSets snapshot" );
+        }
     }
 
     if( cached )
@@ -1,28 +1,32 @@
 #include "SizedImageCache.h"
 
+#include <QDataStream>
 #include <QImageReader>
-#include <QFile>
-#include <QSet>
+#include <QSaveFile>
+#include <QtConcurrent>
 #include "qtutils_core.h"
 
-static const QString CACHE_INDEX_FILENAME  = ".cacheindex";
-static const quint32 CACHE_INDEX_MAGIC_NUM = 0x000CAC3E;
-static const quint16 CACHE_INDEX_VERSION   = 0x0100;      // 16-bit version: 8 bits major, 8 bits minor
+static const QString CACHE_JOURNAL_FILENAME  = ".cachejournal";
+static const quint32 CACHE_JOURNAL_MAGIC_NUM = 0x000CAC3F;
+static const quint16 CACHE_JOURNAL_VERSION   = 0x0100;      // 16-bit version: 8 bits major, 8 bits minor
 
+// Index file written by older versions; replaced by the journal.
+static const QString LEGACY_CACHE_INDEX_FILENAME = ".cacheindex";
 
-QDataStream& operator<<( QDataStream &stream, const SizedImageCache::IndexEntry &entry )
-{
-    stream << entry.fileName;
-    stream << entry.fileAccessDateTime;
-    return stream;
-}
+// Buffered journal records are written out once there are this many.
+static const int JOURNAL_FLUSH_RECORDS = 64;
+
+// The journal is compacted once it holds this many times more records
+// than there are entries (but never below the minimum).
+static const int JOURNAL_COMPACT_RATIO       = 4;
+static const int JOURNAL_COMPACT_MIN_RECORDS = 1024;
 
 
-QDataStream& operator>>( QDataStream &stream, SizedImageCache::IndexEntry &entry )
+static QString
+getNameWithoutExt( const QString& fileName )
 {
-    stream >> entry.fileName;
-    stream >> entry.fileAccessDateTime;
-    return stream;
+    const int dotIndex = fileName.lastIndexOf( '.' );
+    return (dotIndex < 0) ? fileName : fileName.left( dotIndex );
 }
 
 
@@ -32,101 +36,149 @@ SizedImageCache::SizedImageCache( const QDir&     imageCacheDir,
   : mCacheDir( imageCacheDir ),
     mCacheMaxBytes( maxBytes ),
     mCacheCurrentBytes( 0 ),
+    mHead( nullptr ),
+    mTail( nullptr ),
+    mJournalBufferedRecords( 0 ),
+    mJournalRecords( 0 ),
     mLogger( loggingConfig.createLogger() )
 {
-    deserializeCacheIndex();
-    mLogger->debug( "deserialized image cache index: {} entries", mCacheIndex.size() );
-
-    // Figure out which files are present or not preset by starting with
-    // the index and removing all files that match in the cache.
-    QSet<QString> rollCallFileNamesSet;
-    for( auto entry : mCacheIndex ) rollCallFileNamesSet.insert( entry.fileName );
-
-    // Get the list of all actual files in the cache directory.  If there
-    // are files present that aren't in the index, append them to the index.
-    // Appending will also maintain the ordering of newest to oldest.
-    QFileInfoList fileInfoList( mCacheDir.entryInfoList( QStringList(), QDir::Files ) );
-    mLogger->debug( "image cache contains {} files", fileInfoList.size() );
-    for( QFileInfo info : fileInfoList )
-    {
-        // Skip the cache file itself.
-        if( info.fileName() == CACHE_INDEX_FILENAME ) continue;
+    QMutexLocker locker( &mMutex );
 
-        mCacheCurrentBytes += info.size();
+    mJournalFile.setFileName( mCacheDir.filePath( CACHE_JOURNAL_FILENAME ) );
 
-        if( rollCallFileNamesSet.contains( info.fileName() ) )
-        {
-            // File is accounted for.
-            rollCallFileNamesSet.remove( info.fileName() );
-        }
-        else
-        {
-            // File appeared in the cache without being indexed.  Add to
-            // the cache with the oldest possible timestamp.
-            IndexEntry entry;
-            entry.fileName = info.fileName();
-            entry.fileAccessDateTime = QDateTime::fromTime_t( 0 );
-            mCacheIndex.append( entry );
-        }
+    if( mCacheDir.exists( LEGACY_CACHE_INDEX_FILENAME ) )
+    {
+        mLogger->debug( "removing legacy image cache index" );
+        mCacheDir.remove( LEGACY_CACHE_INDEX_FILENAME );
     }
 
-    // Remove entries in the index that weren't accounted for.
-    for( auto fileName : rollCallFileNamesSet )
+    bool truncated = false;
+    const bool replayed = replayJournal( truncated );
+    if( replayed )
     {
-        auto iter = mCacheIndex.begin();
-        while( iter != mCacheIndex.end() )
-        {
-            if( fileName == iter->fileName )
-            {
-                mCacheIndex.erase( iter );
-                break;
-            }
-            ++iter;
-        }
+        mLogger->debug( "replayed image cache journal: {} entries, {} bytes", mEntries.size(), mCacheCurrentBytes );
+    }
+    else
+    {
+        // No usable journal; the directory is all there is to go on.
+        scanDirectory();
+        mLogger->debug( "image cache contains {} files, {} bytes", mEntries.size(), mCacheCurrentBytes );
     }
 
-    mLogger->debug( "image cache contains {} bytes", mCacheCurrentBytes );
-    mLogger->debug( "image cache index has {} entries after resolving cache", mCacheIndex.size() );
+    // Rewrite the journal if appending to it would be lost or wasteful.
+    if( !replayed || truncated || (mJournalRecords > qMax( mEntries.size() * JOURNAL_COMPACT_RATIO, JOURNAL_COMPACT_MIN_RECORDS )) )
+    {
+        compactJournal();
+    }
+    else if( !mJournalFile.open( QIODevice::WriteOnly | QIODevice::Append ) )
+    {
+        mLogger->warn( "error opening image cache journal for writing" );
+    }
 
     // Ensure the cache is right-sized.
     resizeCache( mCacheMaxBytes );
+    flushJournal();
+
+    // Pick up files that were added or removed behind the journal's back,
+    // but don't hold up startup for it.
+    if( replayed )
+    {
+        mReconcileFuture = QtConcurrent::run( this, &SizedImageCache::reconcileDirectory, mCacheDir.path() );
+    }
 }
 
 
 SizedImageCache::~SizedImageCache()
 {
-    mLogger->debug( "serializing image cache index: {} entries", mCacheIndex.size() );
-    serializeCacheIndex();
+    waitForReconciliation();
+
+    QMutexLocker locker( &mMutex );
+    flushJournal();
+    mJournalFile.close();
+
+    Entry* entry = mHead;
+    while( entry != nullptr )
+    {
+        Entry* next = entry->next;
+        delete entry;
+        entry = next;
+    }
+}
+
+
+unsigned int
+SizedImageCache::getCount() const
+{
+    QMutexLocker locker( &mMutex );
+    return mEntries.size();
+}
+
+
+quint64
+SizedImageCache::getCurrentBytes() const
+{
+    QMutexLocker locker( &mMutex );
+    return mCacheCurrentBytes;
 }
 
 
 void
 SizedImageCache::setMaxBytes( quint64 maxBytes )
 {
+    QMutexLocker locker( &mMutex );
     mCacheMaxBytes = maxBytes;
     resizeCache( mCacheMaxBytes );
+    flushJournal();
+}
+
+
+void
+SizedImageCache::waitForReconciliation()
+{
+    mReconcileFuture.waitForFinished();
 }
 
 
 bool
 SizedImageCache::tryReadFromCache( const QString& nameWithoutExt, QImage& image )
 {
-    if( !mCacheDir.exists() )
-        return false;
+    QString imageReaderFilename;
+    bool indexed;
+    {
+        QMutexLocker locker( &mMutex );
 
-    // Construct the filename with no extension.  QImageReader will try all
-    // extensions it knows to read the file.
-    const QString imageReaderFilename = mCacheDir.filePath( nameWithoutExt );
+        if( !mCacheDir.exists() )
+            return false;
 
+        // Use the indexed file name if there is one.  Otherwise construct
+        // the filename with no extension; QImageReader will try all
+        // extensions it knows to read the file.
+        Entry* entry = mEntries.value( nameWithoutExt );
+        indexed = (entry != nullptr);
+        imageReaderFilename = mCacheDir.filePath( indexed ? entry->fileName : nameWithoutExt );
+    }
+
+    // Decode without holding the lock.
     QImageReader reader( imageReaderFilename );
     image = reader.read();
 
+    QMutexLocker locker( &mMutex );
+    Entry* entry = mEntries.value( nameWithoutExt );
+
     if( image.isNull() )
     {
         // There was a file error of some kind.
         if( reader.error() == QImageReader::FileNotFoundError )
         {
             mLogger->debug( "cache miss loading image {}", imageReaderFilename );
+
+            // The indexed file is gone; forget about it.
+            if( indexed && (entry != nullptr) && (mCacheDir.filePath( entry->fileName ) == imageReaderFilename) )
+            {
+                appendJournal( JOURNAL_OP_REMOVE, entry->fileName );
+                removeEntry( entry );
+                flushJournal();
+            }
         }
         else
         {
@@ -137,19 +189,19 @@ SizedImageCache::tryReadFromCache( const QString& nameWithoutExt, QImage& image
 
     mLogger->debug( "loaded image file {} from cache", imageReaderFilename );
 
-    // Update the cache access time.
-    QString imageReaderActualFileName = QFileInfo( reader.fileName() ).fileName();
-    for( auto iter = mCacheIndex.begin(); iter != mCacheIndex.end(); ++iter )
+    if( entry != nullptr )
     {
-        if( iter->fileName == imageReaderActualFileName )
-        {
-            // Update time stamp and move to front of index.
-            IndexEntry entry = *iter;
-            entry.fileAccessDateTime = QDateTime::currentDateTime();
-            mCacheIndex.erase( iter );
-            mCacheIndex.prepend( entry );
-            break;
-        }
+        // Move to front of index.  Touches are written behind.
+        touchEntry( entry );
+        appendJournal( JOURNAL_OP_TOUCH, entry->fileName );
+    }
+    else
+    {
+        // The file hasn't been reconciled into the index yet.
+        QFileInfo info( reader.fileName() );
+        entry = addEntry( info.fileName(), info.size(), true );
+        appendJournal( JOURNAL_OP_ADD, entry->fileName, entry->bytes );
+        flushJournal();
     }
 
     return true;
@@ -159,6 +211,8 @@ SizedImageCache::tryReadFromCache( const QString& nameWithoutExt, QImage& image
 bool
 SizedImageCache::tryWriteToCache( const QString& nameWithoutExt, const QString& extension, const QByteArray& imageData )
 {
+    QMutexLocker locker( &mMutex );
+
     if( !mCacheDir.exists() )
         return false;
 
@@ -171,136 +225,363 @@ SizedImageCache::tryWriteToCache( const QString& nameWithoutExt, const QString&
         return false;
     }
 
+    // Replace any existing entry for the image.
+    Entry* entry = mEntries.value( nameWithoutExt );
+    if( entry != nullptr )
+    {
+        if( entry->fileName != cacheFileName ) mCacheDir.remove( entry->fileName );
+        appendJournal( JOURNAL_OP_REMOVE, entry->fileName );
+        removeEntry( entry );
+    }
+
     // Resize the cache (if necessary) to fit the new file.
-    resizeCache( mCacheMaxBytes - imageData.size() );
+    const quint64 imageBytes = imageData.size();
+    resizeCache( (imageBytes < mCacheMaxBytes) ? mCacheMaxBytes - imageBytes : 0 );
 
     // Write the file.
     cacheFile.write( imageData );
     cacheFile.close();
     mLogger->debug( "wrote image file {} to cache", cacheFile.fileName() );
 
-    // Create a new cache index entry and place at front of index.
-    IndexEntry entry;
-    entry.fileName = cacheFileName;
-    entry.fileAccessDateTime = QDateTime::currentDateTime();
-    mCacheIndex.prepend( entry );
-    mCacheCurrentBytes += imageData.size();
+    // Create a new index entry at the front of the index.
+    addEntry( cacheFileName, imageBytes, true );
+    appendJournal( JOURNAL_OP_ADD, cacheFileName, imageBytes );
+    flushJournal();
 
     return true;
 }
 
 
+SizedImageCache::Entry*
+SizedImageCache::addEntry( const QString& fileName, quint64 bytes, bool mostRecent )
+{
+    Entry* entry = new Entry();
+    entry->fileName = fileName;
+    entry->bytes = bytes;
+    if( mostRecent ) linkFront( entry ); else linkBack( entry );
+
+    mEntries.insert( getNameWithoutExt( fileName ), entry );
+    mCacheCurrentBytes += bytes;
+    return entry;
+}
+
+
+void
+SizedImageCache::removeEntry( Entry* entry )
+{
+    unlink( entry );
+    mEntries.remove( getNameWithoutExt( entry->fileName ) );
+    mCacheCurrentBytes -= entry->bytes;
+    delete entry;
+}
+
+
+void
+SizedImageCache::touchEntry( Entry* entry )
+{
+    if( entry == mHead ) return;
+    unlink( entry );
+    linkFront( entry );
+}
+
+
+void
+SizedImageCache::linkFront( Entry* entry )
+{
+    entry->prev = nullptr;
+    entry->next = mHead;
+    if( mHead != nullptr ) mHead->prev = entry;
+    mHead = entry;
+    if( mTail == nullptr ) mTail = entry;
+}
+
+
+void
+SizedImageCache::linkBack( Entry* entry )
+{
+    entry->prev = mTail;
+    entry->next = nullptr;
+    if( mTail != nullptr ) mTail->next = entry;
+    mTail = entry;
+    if( mHead == nullptr ) mHead = entry;
+}
+
+
+void
+SizedImageCache::unlink( Entry* entry )
+{
+    if( entry->prev != nullptr ) entry->prev->next = entry->next; else mHead = entry->next;
+    if( entry->next != nullptr ) entry->next->prev = entry->prev; else mTail = entry->prev;
+    entry->prev = nullptr;
+    entry->next = nullptr;
+}
+
+
 bool
-SizedImageCache::deserializeCacheIndex()
+SizedImageCache::resizeCache( quint64 maxSize )
+{
+    const quint64 startTotalBytes = mCacheCurrentBytes;
+
+    //
+    // Purge from the back of the index until the cache size is under the
+    // limit.  Sizes come from the index so nothing needs to be stat'ed.
+    //
+
+    while( (mTail != nullptr) && (mCacheCurrentBytes > maxSize) )
+    {
+        Entry* oldestEntry = mTail;
+
+        mLogger->debug( "purging cached image file {}", oldestEntry->fileName );
+
+        // Try to delete the file.  It may already be gone.
+        if( !mCacheDir.remove( oldestEntry->fileName ) && mCacheDir.exists( oldestEntry->fileName ) )
+        {
+            mLogger->warn( "resizeCache: failed to delete file {}", oldestEntry->fileName );
+            return false;
+        }
+
+        appendJournal( JOURNAL_OP_REMOVE, oldestEntry->fileName );
+        removeEntry( oldestEntry );
+    }
+
+    if( mCacheCurrentBytes < startTotalBytes )
+    {
+        mLogger->debug( "image cache reduced from {} to {} total bytes", startTotalBytes, mCacheCurrentBytes );
+    }
+
+    return true;
+}
+
+
+bool
+SizedImageCache::replayJournal( bool& truncated )
 {
-    QFile file( mCacheDir.filePath( CACHE_INDEX_FILENAME ) );
-    mLogger->debug( "deserializing image cache index file: {}", file.fileName() );
+    mLogger->debug( "replaying image cache journal file: {}", mJournalFile.fileName() );
 
-    if( !file.exists() )
+    if( !mJournalFile.exists() )
     {
-        mLogger->info( "image cache index file not found" );
+        mLogger->info( "image cache journal file not found" );
         return false;
     }
 
-    if( !file.open( QIODevice::ReadOnly ) )
+    if( !mJournalFile.open( QIODevice::ReadOnly ) )
     {
-        mLogger->warn( "error opening image cache index file" );
+        mLogger->warn( "error opening image cache journal file" );
         return false;
     }
 
-    QDataStream in( &file );
+    QDataStream in( &mJournalFile );
 
     // Read and check the magic number.
     quint32 magic;
     in >> magic;
-    if( magic != CACHE_INDEX_MAGIC_NUM )
+    if( magic != CACHE_JOURNAL_MAGIC_NUM )
     {
-        mLogger->warn( "bad magic number in image cache index file" );
+        mLogger->warn( "bad magic number in image cache journal file" );
+        mJournalFile.close();
         return false;
     }
 
     // Read and check the version.
     quint16 version;
     in >> version;
-    if( version != CACHE_INDEX_VERSION )
+    if( version != CACHE_JOURNAL_VERSION )
     {
-        mLogger->warn( "unrecognized version in image cache index file" );
+        mLogger->warn( "unrecognized version in image cache journal file" );
+        mJournalFile.close();
         return false;
     }
 
     in.setVersion(QDataStream::Qt_5_2);
 
-    // Read the list.
-    in >> mCacheIndex;
+    while( !in.atEnd() )
+    {
+        quint8 op;
+        QString fileName;
+        quint64 bytes = 0;
+        in >> op >> fileName;
+        if( op == JOURNAL_OP_ADD ) in >> bytes;
+
+        // A record cut short by a crash ends the journal.
+        if( in.status() != QDataStream::Ok )
+        {
+            mLogger->notice( "image cache journal truncated after {} records", mJournalRecords );
+            truncated = true;
+            break;
+        }
+
+        Entry* entry = mEntries.value( getNameWithoutExt( fileName ) );
+        switch( op )
+        {
+            case JOURNAL_OP_ADD:
+                if( entry != nullptr ) removeEntry( entry );
+                addEntry( fileName, bytes, true );
+                break;
+            case JOURNAL_OP_TOUCH:
+                if( entry != nullptr ) touchEntry( entry );
+                break;
+            case JOURNAL_OP_REMOVE:
+                if( entry != nullptr ) removeEntry( entry );
+                break;
+            default:
+                mLogger->warn( "unknown image cache journal op {}", int( op ) );
+                break;
+        }
+        mJournalRecords++;
+    }
 
+    mJournalFile.close();
     return true;
 }
 
 
-bool
-SizedImageCache::serializeCacheIndex()
+void
+SizedImageCache::appendJournal( JournalOp op, const QString& fileName, quint64 bytes )
 {
-    QFile file( mCacheDir.filePath( CACHE_INDEX_FILENAME ) );
-    mLogger->debug( "serializing image cache index file: {}", file.fileName() );
-    file.open( QIODevice::WriteOnly );
-    QDataStream out( &file );
+    QDataStream out( &mJournalBuffer, QIODevice::WriteOnly | QIODevice::Append );
+    out.setVersion(QDataStream::Qt_5_2);
+    out << quint8( op ) << fileName;
+    if( op == JOURNAL_OP_ADD ) out << bytes;
 
-    // Write a header with a "magic number" and a version
-    out << CACHE_INDEX_MAGIC_NUM;
-    out << CACHE_INDEX_VERSION;
+    mJournalRecords++;
+    if( ++mJournalBufferedRecords >= JOURNAL_FLUSH_RECORDS ) flushJournal();
+}
 
-    out.setVersion(QDataStream::Qt_5_2);
 
-    // Write the list.
-    out << mCacheIndex;
+void
+SizedImageCache::flushJournal()
+{
+    if( mJournalRecords > qMax( mEntries.size() * JOURNAL_COMPACT_RATIO, JOURNAL_COMPACT_MIN_RECORDS ) )
+    {
+        compactJournal();
+        return;
+    }
+
+    if( mJournalBuffer.isEmpty() ) return;
 
-    return true;
+    if( mJournalFile.isOpen() )
+    {
+        mJournalFile.write( mJournalBuffer );
+        mJournalFile.flush();
+    }
+    mJournalBuffer.clear();
+    mJournalBufferedRecords = 0;
 }
 
 
-bool
-SizedImageCache::resizeCache( quint64 maxSize )
+void
+SizedImageCache::compactJournal()
 {
-    const quint32 startTotalBytes = mCacheCurrentBytes;
+    mLogger->debug( "compacting image cache journal: {} records, {} entries", mJournalRecords, mEntries.size() );
 
-    //
-    // Iterate backwards through the index, deleting files and index
-    // entries until the cache size is under the limit.
-    //
+    mJournalFile.close();
+    mJournalBuffer.clear();
+    mJournalBufferedRecords = 0;
 
-    while( !mCacheIndex.isEmpty() && (mCacheCurrentBytes > maxSize) )
+    // Write the index as adds from least to most recently used so that
+    // replaying it restores the order.  The new journal replaces the old
+    // one atomically.
+    QSaveFile file( mJournalFile.fileName() );
+    if( file.open( QIODevice::WriteOnly ) )
     {
-        // Remove the oldest index item.
-        IndexEntry oldestIndexEntry = mCacheIndex.takeLast();
+        QDataStream out( &file );
 
-        mLogger->debug( "purging cached image file {}", oldestIndexEntry.fileName );
+        // Write a header with a "magic number" and a version
+        out << CACHE_JOURNAL_MAGIC_NUM;
+        out << CACHE_JOURNAL_VERSION;
 
-        // Get QFileInfo for the item.
-        QFileInfo oldestFileInfo( mCacheDir.filePath( oldestIndexEntry.fileName ) );
+        out.setVersion(QDataStream::Qt_5_2);
 
-        if( !oldestFileInfo.exists() )
+        for( Entry* entry = mTail; entry != nullptr; entry = entry->prev )
         {
-            mLogger->notice( "resizeCache: indexed file {} no longer exists", oldestIndexEntry.fileName );
-            continue;
+            out << quint8( JOURNAL_OP_ADD ) << entry->fileName << entry->bytes;
         }
 
-        quint64 oldestFileSize = oldestFileInfo.size();
-
-        // Try to delete the file.
-        if( !mCacheDir.remove( oldestIndexEntry.fileName ) )
+        if( !file.commit() )
         {
-            mLogger->warn( "resizeCache: failed to delete file {}", oldestIndexEntry.fileName );
-            return false;
+            mLogger->warn( "error writing image cache journal file" );
         }
+    }
+    else
+    {
+        mLogger->warn( "error opening image cache journal file for compaction" );
+    }
+
+    mJournalRecords = mEntries.size();
 
-        // Reduce the overall size by the file just deleted.
-        mCacheCurrentBytes -= oldestFileSize;
+    if( !mJournalFile.open( QIODevice::WriteOnly | QIODevice::Append ) )
+    {
+        mLogger->warn( "error opening image cache journal for writing" );
     }
+}
 
-    if( mCacheCurrentBytes < startTotalBytes )
+
+void
+SizedImageCache::scanDirectory()
+{
+    // Oldest first, so the newest files end up most recently used.
+    QFileInfoList fileInfoList( mCacheDir.entryInfoList( QStringList(), QDir::Files, QDir::Time | QDir::Reversed ) );
+    for( const QFileInfo& info : fileInfoList )
     {
-        mLogger->debug( "image cache reduced from {} to {} total bytes", startTotalBytes, mCacheCurrentBytes );
+        // Skip the journal and other bookkeeping files.
+        if( info.fileName().startsWith( '.' ) ) continue;
+
+        Entry* entry = mEntries.value( getNameWithoutExt( info.fileName() ) );
+        if( entry != nullptr ) removeEntry( entry );
+        addEntry( info.fileName(), info.size(), true );
     }
+}
 
-    return true;
+
+void
+SizedImageCache::reconcileDirectory( const QString& cacheDirPath )
+{
+    // List the directory without holding the lock.  A private QDir is used
+    // since QDir caches listings internally.
+    QDir dir( cacheDirPath );
+    QFileInfoList fileInfoList( dir.entryInfoList( QStringList(), QDir::Files ) );
+    QHash<QString,QFileInfo> unindexedFiles;
+    for( const QFileInfo& info : fileInfoList )
+    {
+        if( info.fileName().startsWith( '.' ) ) continue;
+        unindexedFiles.insert( info.fileName(), info );
+    }
+
+    QMutexLocker locker( &mMutex );
+    bool changed = false;
+
+    // Drop entries whose files are gone.  Files written since the listing
+    // was taken are checked individually.
+    Entry* entry = mHead;
+    while( entry != nullptr )
+    {
+        Entry* next = entry->next;
+        if( unindexedFiles.remove( entry->fileName ) == 0 && !dir.exists( entry->fileName ) )
+        {
+            mLogger->debug( "reconcile: indexed file {} no longer exists", entry->fileName );
+            removeEntry( entry );
+            changed = true;
+        }
+        entry = next;
+    }
+
+    // Files that appeared without being indexed are treated as the least
+    // recently used.
+    for( const QFileInfo& info : unindexedFiles )
+    {
+        if( mEntries.contains( getNameWithoutExt( info.fileName() ) ) ) continue;
+        mLogger->debug( "reconcile: adding unindexed file {}", info.fileName() );
+        addEntry( info.fileName(), info.size(), false );
+        changed = true;
+    }
+
+    // Appends can't express additions at the back of the index, so the
+    // journal is rewritten.
+    if( changed )
+    {
+        mLogger->debug( "image cache reconciled: {} entries, {} bytes", mEntries.size(), mCacheCurrentBytes );
+        compactJournal();
+        resizeCache( mCacheMaxBytes );
+        flushJournal();
+    }
 }
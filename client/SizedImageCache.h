@@ -3,11 +3,28 @@
 
 #include "ImageCache.h"
 
+#include <QByteArray>
 #include <QDir>
-#include <QDateTime>
+#include <QFile>
+#include <QFuture>
+#include <QHash>
+#include <QMutex>
 
 #include "Logging.h"
 
+// Image cache limited to a maximum number of bytes on disk.  The least
+// recently used images are purged to make room for new ones.
+//
+// The index is a hash of entries threaded on an intrusive LRU list, each
+// entry carrying its file's size, so hits and purges are constant-time
+// and never touch the filesystem beyond the image file itself.  Changes
+// to the index are appended to a journal in the cache directory (touches
+// are buffered and written behind) which is compacted once it grows
+// well past the size of the index.
+//
+// On startup the journal is replayed and the directory is reconciled
+// against it in the background.  Without a journal the directory is
+// scanned up front.
 class SizedImageCache : public ImageCache
 {
 public:
@@ -17,32 +34,73 @@ public:
                      Logging::Config loggingConfig = Logging::Config() );
     virtual ~SizedImageCache();
 
-    unsigned int getCount() const { return mCacheIndex.size(); }
-    quint64 getCurrentBytes() const { return mCacheCurrentBytes; }
+    unsigned int getCount() const;
+    quint64 getCurrentBytes() const;
 
     void setMaxBytes( quint64 maxBytes );
 
+    // Block until background reconciliation with the directory is done.
+    void waitForReconciliation();
+
     virtual bool tryReadFromCache( const QString& nameWithoutExt, QImage& image ) override;
     virtual bool tryWriteToCache( const QString& nameWithoutExt, const QString& extension, const QByteArray& byteArray ) override;
 
-    // Would be private except for stream operators.
-    struct IndexEntry
+private:
+
+    struct Entry
     {
-        QString   fileName;
-        QDateTime fileAccessDateTime;
+        QString fileName;
+        quint64 bytes;
+        Entry*  prev;
+        Entry*  next;
     };
 
-private:
+    enum JournalOp
+    {
+        JOURNAL_OP_ADD,
+        JOURNAL_OP_TOUCH,
+        JOURNAL_OP_REMOVE
+    };
 
-    bool deserializeCacheIndex();
-    bool serializeCacheIndex();
+    // All of these must be called with the mutex held.
+    Entry* addEntry( const QString& fileName, quint64 bytes, bool mostRecent );
+    void removeEntry( Entry* entry );
+    void touchEntry( Entry* entry );
+    void linkFront( Entry* entry );
+    void linkBack( Entry* entry );
+    void unlink( Entry* entry );
     bool resizeCache( quint64 maxSize );
 
+    bool replayJournal( bool& truncated );
+    void appendJournal( JournalOp op, const QString& fileName, quint64 bytes = 0 );
+    void flushJournal();
+    void compactJournal();
+
+    void scanDirectory();
+    void reconcileDirectory( const QString& cacheDirPath );
+
+    // Guards everything below; images are read and written from loader
+    // threads.
+    mutable QMutex                  mMutex;
+
     QDir                            mCacheDir;
     quint64                         mCacheMaxBytes;
-    QList<IndexEntry>               mCacheIndex;
     quint64                         mCacheCurrentBytes;
 
+    // Keyed by file name without extension.
+    QHash<QString,Entry*>           mEntries;
+
+    // Most recently used at the head.
+    Entry*                          mHead;
+    Entry*                          mTail;
+
+    QFile                           mJournalFile;
+    QByteArray                      mJournalBuffer;
+    int                             mJournalBufferedRecords;
+    int                             mJournalRecords;
+
+    QFuture<void>                   mReconcileFuture;
+
     std::shared_ptr<spdlog::logger> mLogger;
 
 };
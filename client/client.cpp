@@ -725,49 +725,62 @@ Client::initStateMachine()
 CardDataSharedPtr
 Client::createCardData( const std::string& setCode, const std::string& name )
 {
-    CardData* cardData  = nullptr;
+    return createCardData( std::vector<SimpleCardData>( 1, SimpleCardData( name, setCode ) ) ).front();
+}
+
+
+std::vector<CardDataSharedPtr>
+Client::createCardData( const std::vector<SimpleCardData>& cards )
+{
+    std::vector<AllSetsData::CardResolution> resolutions;
     if( mAllSetsData )
     {
-        cardData = mAllSetsData->createCardData( setCode, name );
-        if( !cardData )
+        resolutions = mAllSetsData->resolveCards( cards );
+    }
+
+    std::vector<CardDataSharedPtr> cardDataList;
+    cardDataList.reserve( cards.size() );
+    std::weak_ptr<CardServerSetCodeMap> mapWeakPtr( mCardServerSetCodeMap );
+    for( std::size_t i = 0; i < cards.size(); ++i )
+    {
+        const std::string setCode = cards[i].getSetCode();
+
+        CardData* cardData = nullptr;
+        if( !resolutions.empty() && resolutions[i].isResolved() )
         {
-            // Couldn't find the card by name in the set specified by the
+            cardData = mAllSetsData->createCardData( resolutions[i].handle );
+
+            // If the card wasn't found by name in the set specified by the
             // server, either because the server used a set code we don't
-            // know about, or more likely an empty set code.  Try to find
-            // a usable set code for the card name so we can reference
-            // real card information.
-            std::string newSetCode = mAllSetsData->findSetCode( name );
-            if( !newSetCode.empty() )
+            // know about or more likely an empty set code, it was resolved
+            // in another set so we can reference real card information.
+            // Important: the server will still be expecting its set code
+            // when this card is referenced, so that set code is saved
+            // into a map here.
+            if( cardData && (resolutions[i].setCode != setCode) )
             {
-                // Create card data with the found set code.
-                cardData = mAllSetsData->createCardData( newSetCode, name );
-
-                // Important: the server will still be expecting its set
-                // code when this card is referenced, so that set code
-                // is saved into a map here.
                 mCardServerSetCodeMap->insert( cardData, setCode );
             }
         }
-    }
 
-    if( !cardData )
-    {
-        // Could not create normally, so create a simple placeholder.
-        cardData = new SimpleCardData( name, setCode );
-    }
+        if( !cardData )
+        {
+            // Could not create normally, so create a simple placeholder.
+            cardData = new SimpleCardData( cards[i].getName(), setCode );
+        }
 
-    // Create a shared pointer with a custom deleter that cleans up the
-    // server set code association with the card from the map.  The weak
-    // pointer to the map is used to avoid accessing the map when cards
-    // are being cleaned up after the map is destroyed.
-    std::weak_ptr<CardServerSetCodeMap> mapWeakPtr( mCardServerSetCodeMap );
-    CardDataSharedPtr sptr( cardData, [mapWeakPtr]( CardData* ptr ) {
-            std::shared_ptr<CardServerSetCodeMap> mapSharedPtr = mapWeakPtr.lock();
-            if( mapSharedPtr ) mapSharedPtr->remove( ptr );
-            delete ptr;
-        } );
+        // Create a shared pointer with a custom deleter that cleans up the
+        // server set code association with the card from the map.  The weak
+        // pointer to the map is used to avoid accessing the map when cards
+        // are being cleaned up after the map is destroyed.
+        cardDataList.push_back( CardDataSharedPtr( cardData, [mapWeakPtr]( CardData* ptr ) {
+                std::shared_ptr<CardServerSetCodeMap> mapSharedPtr = mapWeakPtr.lock();
+                if( mapSharedPtr ) mapSharedPtr->remove( ptr );
+                delete ptr;
+            } ) );
+    }
 
-    return sptr;
+    return cardDataList;
 }
 
 
@@ -1060,6 +1073,7 @@ Client::handleMessageFromServer( const proto::ServerToClientMsg& msg )
         const proto::CreateRoomSuccessRsp& rsp = msg.create_room_success_rsp();
         const int roomId = rsp.room_id();
         mLogger->debug( "CreateRoomSuccessRsp: roomId={}", roomId );
+        mCreateRoomReq.Clear();
 
         // The room has been created on the server but it's up to the
         // client to join their own room.
@@ -1076,6 +1090,19 @@ Client::handleMessageFromServer( const proto::ServerToClientMsg& msg )
         const proto::CreateRoomFailureRsp::ResultType result = rsp.result();
         mLogger->debug( "CreateRoomFailureRsp: result={}", result );
 
+        // The server doesn't have a custom card list sent by hash; send it
+        // in full.
+        if( (result == proto::CreateRoomFailureRsp::RESULT_UNKNOWN_CUSTOM_CARD_LIST) &&
+                mCreateRoomReq.has_room_config() )
+        {
+            mLogger->debug( "resending CreateRoomReq with custom card lists" );
+            proto::ClientToServerMsg msg;
+            msg.mutable_create_room_req()->Swap( &mCreateRoomReq );
+            mCreateRoomReq.Clear();
+            mServerConn->sendProtoMsg( msg );
+            return;
+        }
+
         // Bring up a warning dialog.
         const QMap<proto::CreateRoomFailureRsp::ResultType,QString> lookup = {
                 { proto::CreateRoomFailureRsp::RESULT_INVALID_SET_CODE, "A set code was invalid." },
@@ -1398,10 +1425,9 @@ Client::processMessageFromServer( const proto::PlayerInventoryInd& ind )
                              std::back_inserter( newCardList ) );
 
         // Add all new cards to the local card zone.
-        for( auto card : newCardList )
+        mLogger->debug( "adding {} cards", newCardList.size() );
+        for( const CardDataSharedPtr& cardDataSharedPtr : createCardData( newCardList ) )
         {
-            mLogger->debug( "adding card  {}", card.getName() );
-            CardDataSharedPtr cardDataSharedPtr = createCardData( card.getSetCode(), card.getName() );
             mCardsList[zone].push_back( cardDataSharedPtr );
         }
 
@@ -1524,7 +1550,7 @@ Client::processMessageFromServer( const proto::PublicStateInd& ind )
 void
 Client::processMessageFromServer( const proto::BoosterDraftStateInd& ind )
 {
-    mLogger->debug( "BoosterDraftStateInd: chairs={}", ind.chairs_size() );
+    mLogger->debug( "BoosterDraftStateInd: chairs={}, delta={}", ind.chairs_size(), ind.delta() );
 
     // Update room state.
     mRoomStateAccumulator.setPublicDraftType( false );
@@ -1562,6 +1588,15 @@ Client::processMessageFromServer( const proto::BoosterDraftStateInd& ind )
         }
     }
 
+    // Chairs left out of a delta count down locally, so keep the timer
+    // running.  Re-align it on full updates or if it isn't running yet.
+    if( !ind.delta() || !mServerAlignedDraftTimer->isActive() )
+    {
+        mServerAlignedDraftTimer->stop();
+        mServerAlignedDraftTimer->setSingleShot( true );
+        mServerAlignedDraftTimer->start( ind.millis_until_next_sec() );
+    }
+
     // Update the ticker player status widget with room state.
     mTickerPlayerStatusWidget->update( mRoomStateAccumulator );
 
@@ -2061,6 +2096,21 @@ Client::handleCreateRoomRequest()
             }
             proto::RoomConfig* roomConfig = req->mutable_room_config();
             mCreateRoomWizard->fillRoomConfig( roomConfig );
+            mCreateRoomReq = *req;
+
+            // Servers that register custom card lists only need the hash
+            // of a list they've seen; the full list is sent if they haven't.
+            const bool serverRegistersLists =
+                    (mServerProtoVersion.getMajor() == proto::PROTOCOL_VERSION_MAJOR) &&
+                    (mServerProtoVersion.getMinor() >= 1);
+            if( serverRegistersLists )
+            {
+                proto::DraftConfig* draftConfig = roomConfig->mutable_draft_config();
+                for( int i = 0; i < draftConfig->custom_card_lists_size(); ++i )
+                {
+                    draftConfig->mutable_custom_card_lists( i )->clear_card_quantities();
+                }
+            }
 
             mLogger->debug( "sending CreateRoomReq" );
             mServerConn->sendProtoMsg( msg );
@@ -40,6 +40,7 @@ class TickerPlayerStatusWidget;
 class TickerPostRoundTimerWidget;
 class ServerConnection;
 class SettingsDialog;
+class SimpleCardData;
 
 #include "messages.pb.h"
 #include "Logging.h"
@@ -120,6 +121,10 @@ private:
     // handles cases of null AllSetsData or unknown cards in AllSetsData.
     CardDataSharedPtr createCardData( const std::string& setCode, const std::string& name );
 
+    // Create card data shared pointers for a batch of cards (name and set
+    // code), resolved together.
+    std::vector<CardDataSharedPtr> createCardData( const std::vector<SimpleCardData>& cards );
+
     void connectToServer( const QString& host, int port );
     void disconnectFromServer();
 
@@ -263,6 +268,10 @@ private:
     CardZoneType mDraftedCardDestZone;
     std::string mCreatedRoomPassword;
 
+    // Full request kept while custom card lists are sent by hash, in case
+    // the server doesn't know them.
+    proto::CreateRoomReq mCreateRoomReq;
+
     bool mUnsavedChanges;
 
     Logging::Config mLoggingConfig;
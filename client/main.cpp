@@ -11,6 +11,7 @@
 #include "SizedImageCache.h"
 #include "UnlimitedImageCache.h"
 #include "MtgJsonAllSetsData.h"
+#include "SnapshotAllSetsData.h"
 #include "MtgJsonAllSetsFileCache.h"
 #include "MtgJsonAllSetsUpdater.h"
 #include "qtutils_core.h"
@@ -22,6 +23,7 @@ int main(int argc, char *argv[])
     Logging::Config loggingConfig;
     loggingConfig.setName( "client" );
     loggingConfig.setStdoutLogging( true );
+    loggingConfig.setAsyncLogging( true );
     loggingConfig.setLevel( spdlog::level::info );
 
     std::shared_ptr<spdlog::logger> logger = loggingConfig.createLogger();
@@ -220,8 +222,27 @@ int main(int argc, char *argv[])
 
     AllSetsDataSharedPtr allSetsDataSptr;
 
+    // Prefer a snapshot written for the cached file's version; it loads
+    // without parsing.  Fall back to parsing the cached file and write a
+    // snapshot for next time.
+    const QString allSetsVersion = allSetsFileCache.getCachedFileVersion( settings.getAllSetsUpdateChannel() );
+    if( !allSetsVersion.isEmpty() )
+    {
+        const std::string snapshotFilePath = allSetsFileCache.getCachedSnapshotFilePath( settings.getAllSetsUpdateChannel() ).toStdString();
+        SnapshotAllSetsData* snapshotAllSetsDataPtr = new SnapshotAllSetsData( loggingConfig.createChildConfig( "snapshot" ) );
+        if( snapshotAllSetsDataPtr->load( snapshotFilePath, allSetsVersion.toStdString() ) )
+        {
+            allSetsDataSptr.reset( snapshotAllSetsDataPtr );
+        }
+        else
+        {
+            logger->notice( "no usable AllSets snapshot at {}", snapshotFilePath );
+            delete snapshotAllSetsDataPtr;
+        }
+    }
+
     const std::string allSetsFilePath = allSetsFileCache.getCachedFilePath( settings.getAllSetsUpdateChannel() ).toStdString();
-    FILE* allSetsDataFile = fopen( allSetsFilePath.c_str(), "r" );
+    FILE* allSetsDataFile = allSetsDataSptr ? NULL : fopen( allSetsFilePath.c_str(), "r" );
     if( allSetsDataFile != NULL )
     {
         // Create the JSON set data instance.
@@ -231,6 +252,10 @@ int main(int argc, char *argv[])
         if( parseResult )
         {
             allSetsDataSptr.reset( mtgJsonAllSetsDataPtr );
+            if( !allSetsVersion.isEmpty() )
+            {
+                allSetsFileCache.commitSnapshot( settings.getAllSetsUpdateChannel(), *mtgJsonAllSetsDataPtr, allSetsVersion );
+            }
         }
         else
         {
@@ -238,7 +263,7 @@ int main(int argc, char *argv[])
             delete mtgJsonAllSetsDataPtr;
         }
     }
-    else
+    else if( !allSetsDataSptr )
     {
         // This may be normal, e.g. first session.
         logger->notice( "failed to open cached AllSets file at {}", allSetsFilePath );
@@ -172,7 +172,9 @@ CATCH_TEST_CASE( "ImageCache - no existing files, existing index", "[imagecache]
     CATCH_REQUIRE( dir.remove( "1.png" ) );
     CATCH_REQUIRE( dir.remove( "2.png" ) );
 
+    // Missing files are found by background reconciliation.
     SizedImageCache imageCache( dir.path(), DEFAULT_MAX_BYTES, TestHelper::getInstance()->getLoggingConfig() );
+    imageCache.waitForReconciliation();
     CATCH_REQUIRE( imageCache.getCount() == 0 );
     CATCH_REQUIRE( imageCache.getCurrentBytes() == 0 );
 
@@ -241,6 +243,62 @@ CATCH_TEST_CASE( "ImageCache - Cache ordering and purging", "[imagecache]" )
 }
 
 
+CATCH_TEST_CASE( "SizedImageCache - Journal", "[imagecache]" )
+{
+    // Create temporary directory.  This will self-delete at end of scope.
+    QTemporaryDir tempDir;
+    CATCH_REQUIRE( tempDir.isValid() );
+    QDir dir( tempDir.path() );
+
+    const unsigned int smallSize = TestHelper::getInstance()->getImagePNGSize( TestHelper::IMAGE_SMALL );
+    const QByteArray smallData = TestHelper::getInstance()->getImagePNGByteArray( TestHelper::IMAGE_SMALL );
+
+    // Write three files and make the first most recently used.
+    {
+        SizedImageCache imageCache( dir.path(), DEFAULT_MAX_BYTES, TestHelper::getInstance()->getLoggingConfig() );
+        CATCH_REQUIRE( imageCache.tryWriteToCache( "0", ".png", smallData ) );
+        CATCH_REQUIRE( imageCache.tryWriteToCache( "1", ".png", smallData ) );
+        CATCH_REQUIRE( imageCache.tryWriteToCache( "2", ".png", smallData ) );
+
+        QImage tmpImage;
+        CATCH_REQUIRE( imageCache.tryReadFromCache( "0", tmpImage ) );
+    }
+
+    CATCH_SECTION( "Order survives reopening" )
+    {
+        SizedImageCache imageCache( dir.path(), smallSize * 3, TestHelper::getInstance()->getLoggingConfig() );
+        imageCache.waitForReconciliation();
+        CATCH_REQUIRE( imageCache.getCount() == 3 );
+        CATCH_REQUIRE( imageCache.getCurrentBytes() == smallSize * 3 );
+
+        // Writing a fourth purges the least recently used.
+        QImage tmpImage;
+        CATCH_REQUIRE( imageCache.tryWriteToCache( "3", ".png", smallData ) );
+        CATCH_REQUIRE_FALSE( imageCache.tryReadFromCache( "1", tmpImage ) );
+        CATCH_REQUIRE( imageCache.tryReadFromCache( "0", tmpImage ) );
+        CATCH_REQUIRE( imageCache.tryReadFromCache( "2", tmpImage ) );
+        CATCH_REQUIRE( imageCache.tryReadFromCache( "3", tmpImage ) );
+    }
+
+    CATCH_SECTION( "Unindexed files are reconciled as least recently used" )
+    {
+        QFile extraFile( dir.filePath( "4.png" ) );
+        CATCH_REQUIRE( extraFile.open( QIODevice::WriteOnly ) );
+        extraFile.write( smallData );
+        extraFile.close();
+
+        SizedImageCache imageCache( dir.path(), DEFAULT_MAX_BYTES, TestHelper::getInstance()->getLoggingConfig() );
+        imageCache.waitForReconciliation();
+        CATCH_REQUIRE( imageCache.getCount() == 4 );
+        CATCH_REQUIRE( imageCache.getCurrentBytes() == smallSize * 4 );
+
+        imageCache.setMaxBytes( smallSize * 3 );
+        CATCH_REQUIRE( imageCache.getCount() == 3 );
+        CATCH_REQUIRE_FALSE( dir.exists( "4.png" ) );
+    }
+}
+
+
 CATCH_TEST_CASE( "UnlimitedImageCache", "[imagecache]" )
 {
     // Create temporary directory.  This will self-delete at end of scope.
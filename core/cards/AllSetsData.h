@@ -4,6 +4,8 @@
 #include "SetDataTypes.h"
 #include "CardDataTypes.h"
 #include "CardData.h"
+#include "SimpleCardData.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
@@ -12,6 +14,32 @@ class AllSetsData
 {
 public:
 
+    // Stable handle to a card entry in a set, valid for the lifetime of
+    // the set data.
+    struct CardHandle
+    {
+        static const uint32_t INVALID_INDEX = 0xffffffff;
+
+        CardHandle() : setIndex( INVALID_INDEX ), cardIndex( INVALID_INDEX ) {}
+        CardHandle( uint32_t s, uint32_t c ) : setIndex( s ), cardIndex( c ) {}
+
+        bool isValid() const { return setIndex != INVALID_INDEX; }
+
+        uint32_t setIndex;
+        uint32_t cardIndex;
+    };
+
+    // Result of resolving a card by name and set code.  A card is resolved
+    // in its set if possible, otherwise in the set findSetCode() would
+    // choose for its name.  The set code is the set it was resolved in.
+    struct CardResolution
+    {
+        bool isResolved() const { return handle.isValid(); }
+
+        CardHandle  handle;
+        std::string setCode;
+    };
+
     virtual ~AllSetsData() {}
 
     virtual std::vector<std::string> getSetCodes() const = 0;
@@ -28,7 +56,15 @@ public:
     virtual CardData* createCardData( const std::string& code, const std::string& name ) const = 0;
     virtual CardData* createCardData( int multiverseId ) const = 0;
 
+    // Returns nullptr for an invalid handle.
+    virtual CardData* createCardData( const CardHandle& handle ) const = 0;
+
     virtual std::string findSetCode( const std::string& name ) const = 0;
+
+    // Resolve a batch of cards (name and set code) in one pass, e.g. a
+    // whole cube or pack.  Returns a resolution for each card in order;
+    // cards whose names aren't found in any set are unresolved.
+    virtual std::vector<CardResolution> resolveCards( const std::vector<SimpleCardData>& cards ) const = 0;
 };
 
 #endif  // ALLSETSDATA_H
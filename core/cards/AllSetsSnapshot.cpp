@@ -0,0 +1,126 @@
+#include "AllSetsSnapshot.h"
+
+#include <cstring>
+
+using namespace AllSetsSnapshot;
+
+// Hash tables are kept at most half full.
+static uint32_t hashCapacity( size_t entries )
+{
+    uint32_t capacity = 16;
+    while( capacity < entries * 2 ) capacity <<= 1;
+    return capacity;
+}
+
+
+Builder::Builder()
+  : mDataVersion()
+{}
+
+
+StringRef
+Builder::addString( const std::string& str )
+{
+    auto iter = mStringMap.find( str );
+    if( iter != mStringMap.end() ) return iter->second;
+
+    const StringRef ref { static_cast<uint32_t>( mStrings.size() ),
+                          static_cast<uint32_t>( str.size() ) };
+    mStrings.append( str );
+    mStringMap.insert( std::make_pair( str, ref ) );
+    return ref;
+}
+
+
+int
+Builder::addType( const std::string& type )
+{
+    auto iter = mTypeMap.find( type );
+    if( iter != mTypeMap.end() ) return iter->second;
+
+    if( mTypes.size() >= MAX_TYPES ) return -1;
+
+    const int bit = mTypes.size();
+    mTypes.push_back( addString( type ) );
+    mTypeMap.insert( std::make_pair( type, bit ) );
+    return bit;
+}
+
+
+bool
+Builder::write( FILE* fp ) const
+{
+    // Build the open-addressing name hash table.
+    std::vector<uint32_t> nameHash( hashCapacity( nameKeys.size() ), 0 );
+    const uint32_t nameMask = nameHash.size() - 1;
+    for( uint32_t i = 0; i < nameKeys.size(); ++i )
+    {
+        const StringRef& key = nameKeys[i].key;
+        uint32_t slot = hashName( mStrings.data() + key.offset, key.length ) & nameMask;
+        while( nameHash[slot] != 0 ) slot = (slot + 1) & nameMask;
+        nameHash[slot] = i + 1;
+    }
+
+    // Build the open-addressing multiverse id hash table.
+    const MuidRecord emptyMuid { 0, EMPTY_CARD_INDEX };
+    std::vector<MuidRecord> muidHash( hashCapacity( muids.size() ), emptyMuid );
+    const uint32_t muidMask = muidHash.size() - 1;
+    for( const MuidRecord& muid : muids )
+    {
+        uint32_t slot = hashMultiverseId( muid.multiverseId ) & muidMask;
+        while( muidHash[slot].cardIndex != EMPTY_CARD_INDEX ) slot = (slot + 1) & muidMask;
+        muidHash[slot] = muid;
+    }
+
+    // Lay out the sections after the header.
+    Header header;
+    std::memset( &header, 0, sizeof(header) );
+    std::memcpy( header.magic, MAGIC, sizeof(header.magic) );
+    header.formatVersion = FORMAT_VERSION;
+    header.endianCheck = ENDIAN_CHECK;
+    header.dataVersion = mDataVersion;
+
+    uint32_t offset = sizeof(Header);
+    auto layout = [&offset]( Section& section, size_t count, size_t recordSize ) {
+        offset = (offset + 7) & ~7u;
+        section.offset = offset;
+        section.count = count;
+        offset += count * recordSize;
+    };
+    layout( header.strings,       mStrings.size(),      1 );
+    layout( header.types,         mTypes.size(),        sizeof(StringRef) );
+    layout( header.sets,          sets.size(),          sizeof(SetRecord) );
+    layout( header.setPriorities, setPriorities.size(), sizeof(uint32_t) );
+    layout( header.slots,         slots.size(),         sizeof(uint32_t) );
+    layout( header.cards,         cards.size(),         sizeof(CardRecord) );
+    layout( header.nameKeys,      nameKeys.size(),      sizeof(NameKeyRecord) );
+    layout( header.postings,      postings.size(),      sizeof(PostingRecord) );
+    layout( header.nameHash,      nameHash.size(),      sizeof(uint32_t) );
+    layout( header.muidHash,      muidHash.size(),      sizeof(MuidRecord) );
+
+    // Write everything out, padding up to each section offset.
+    uint32_t pos = 0;
+    auto writeSection = [fp,&pos]( const Section& section, const void* data, size_t recordSize ) {
+        static const char padding[8] = { 0 };
+        if( std::fwrite( padding, 1, section.offset - pos, fp ) != section.offset - pos ) return false;
+        const size_t bytes = section.count * recordSize;
+        if( (bytes > 0) && (std::fwrite( data, 1, bytes, fp ) != bytes) ) return false;
+        pos = section.offset + bytes;
+        return true;
+    };
+
+    if( std::fwrite( &header, sizeof(header), 1, fp ) != 1 ) return false;
+    pos = sizeof(header);
+
+    return writeSection( header.strings,       mStrings.data(),      1 ) &&
+           writeSection( header.types,         mTypes.data(),        sizeof(StringRef) ) &&
+           writeSection( header.sets,          sets.data(),          sizeof(SetRecord) ) &&
+           writeSection( header.setPriorities, setPriorities.data(), sizeof(uint32_t) ) &&
+           writeSection( header.slots,         slots.data(),         sizeof(uint32_t) ) &&
+           writeSection( header.cards,         cards.data(),         sizeof(CardRecord) ) &&
+           writeSection( header.nameKeys,      nameKeys.data(),      sizeof(NameKeyRecord) ) &&
+           writeSection( header.postings,      postings.data(),      sizeof(PostingRecord) ) &&
+           writeSection( header.nameHash,      nameHash.data(),      sizeof(uint32_t) ) &&
+           writeSection( header.muidHash,      muidHash.data(),      sizeof(MuidRecord) ) &&
+           (std::fflush( fp ) == 0);
+}
@@ -0,0 +1,180 @@
+#ifndef ALLSETSSNAPSHOT_H
+#define ALLSETSSNAPSHOT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <map>
+
+//
+// Precompiled binary snapshot of AllSets data.  A snapshot is written
+// once after a successful parse of the MTG JSON data and is then loaded
+// by memory-mapping the file, with no parsing at all.
+//
+// The file is a fixed header followed by sections of fixed-size records.
+// All strings live in a single interned string table and are referenced
+// by offset/length.  Sections are 8-byte aligned and all records are made
+// of 32-bit fields so they can be used in place from the mapping.  The
+// file is only valid on a platform with the same endianness as the writer.
+//
+
+namespace AllSetsSnapshot
+{
+    const char     MAGIC[8] = { 'T', 'H', 'K', 'S', 'N', 'A', 'P', '\0' };
+    const uint32_t FORMAT_VERSION = 2;
+    const uint32_t ENDIAN_CHECK = 0x01020304;
+
+    // Maximum number of distinct card types (one bit each in a card record).
+    const unsigned int MAX_TYPES = 32;
+
+    struct StringRef
+    {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    struct Section
+    {
+        uint32_t offset;
+        uint32_t count;
+    };
+
+    struct Header
+    {
+        char      magic[8];
+        uint32_t  formatVersion;
+        uint32_t  endianCheck;
+        StringRef dataVersion;
+        Section   strings;        // char[]
+        Section   types;          // StringRef[], bit index -> type name
+        Section   sets;           // SetRecord[], alphabetical by code
+        Section   setPriorities;  // uint32_t[], set indexes in search order
+        Section   slots;          // uint32_t[], SlotType values
+        Section   cards;          // CardRecord[], grouped by set in file order
+        Section   nameKeys;       // NameKeyRecord[]
+        Section   postings;       // PostingRecord[]
+        Section   nameHash;       // uint32_t[], name key index + 1 (0 is empty)
+        Section   muidHash;       // MuidRecord[]
+    };
+
+    enum SetFlags
+    {
+        SET_FLAG_GATHERER_CODE = 0x01,
+        SET_FLAG_BOOSTER       = 0x02
+    };
+
+    struct SetRecord
+    {
+        StringRef code;
+        StringRef name;
+        StringRef gathererCode;
+        uint32_t  flags;
+        uint32_t  priority;     // position in search order
+        uint32_t  firstCard;
+        uint32_t  cardCount;
+        uint32_t  firstSlot;
+        uint32_t  slotCount;
+    };
+
+    enum CardFlags
+    {
+        CARD_FLAG_SPLIT   = 0x01,
+        CARD_FLAG_IN_POOL = 0x02    // counted once in the set's card pool
+    };
+
+    struct CardRecord
+    {
+        StringRef name;
+        int32_t   multiverseId;
+        int32_t   cmc;
+        uint32_t  typesMask;
+        uint8_t   rarity;
+        uint8_t   colorsMask;
+        uint8_t   flags;
+        uint8_t   reserved;
+    };
+
+    enum NameKeyFlags
+    {
+        NAME_KEY_FLAG_SPLIT = 0x01  // full split card name, e.g. "fire // ice"
+    };
+
+    // A case-folded lookup name and the cards it refers to.  Postings are
+    // ordered by set search priority with at most one card per set.  The
+    // same key can appear once as a card name and once as a split name.
+    struct NameKeyRecord
+    {
+        StringRef key;
+        uint32_t  flags;
+        uint32_t  firstPosting;
+        uint32_t  postingCount;
+    };
+
+    struct PostingRecord
+    {
+        uint32_t setIndex;
+        uint32_t cardIndex;
+    };
+
+    const uint32_t EMPTY_CARD_INDEX = 0xFFFFFFFF;
+
+    struct MuidRecord
+    {
+        int32_t  multiverseId;
+        uint32_t cardIndex;     // EMPTY_CARD_INDEX if slot unused
+    };
+
+    // FNV-1a hash used for the name hash table.
+    inline uint32_t hashName( const char* str, size_t len )
+    {
+        uint32_t h = 2166136261u;
+        for( size_t i = 0; i < len; ++i )
+        {
+            h ^= static_cast<unsigned char>( str[i] );
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    inline uint32_t hashMultiverseId( int32_t muid )
+    {
+        return static_cast<uint32_t>( muid ) * 2654435761u;
+    }
+
+    // Accumulates snapshot content and writes the file.  Sets and cards
+    // must be added in final order; hash tables are built at write time.
+    class Builder
+    {
+    public:
+
+        Builder();
+
+        StringRef addString( const std::string& str );
+
+        // Returns the type bit index or -1 if there are too many types.
+        int addType( const std::string& type );
+
+        void setDataVersion( const std::string& version ) { mDataVersion = addString( version ); }
+
+        std::vector<SetRecord>     sets;
+        std::vector<uint32_t>      setPriorities;
+        std::vector<uint32_t>      slots;
+        std::vector<CardRecord>    cards;
+        std::vector<NameKeyRecord> nameKeys;
+        std::vector<PostingRecord> postings;
+        std::vector<MuidRecord>    muids;
+
+        bool write( FILE* fp ) const;
+
+    private:
+
+        std::string                     mStrings;
+        std::map<std::string,StringRef> mStringMap;
+        std::vector<StringRef>          mTypes;
+        std::map<std::string,int>       mTypeMap;
+        StringRef                       mDataVersion;
+    };
+}
+
+#endif  // ALLSETSSNAPSHOT_H
@@ -0,0 +1,49 @@
+#include "BoosterTemplate.h"
+
+
+BoosterTemplate::BoosterTemplate( const std::string&           setCode,
+                                  const std::vector<SlotType>& boosterSlots,
+                                  const SetRarityToCardMap&    cardPool )
+  : mSetCode( setCode ),
+    mBoosterSlots( boosterSlots ),
+    mCardCount( cardPool.size() )
+{
+    for( auto kv : cardPool )
+    {
+        mCards[kv.first].push_back( kv.second );
+    }
+}
+
+
+BoosterTemplateCache::BoosterTemplateCache( const std::shared_ptr<const AllSetsData>& allSetsData,
+                                            const Logging::Config&                    loggingConfig )
+  : mAllSetsData( allSetsData ),
+    mCacheHits( 0 ),
+    mCacheMisses( 0 ),
+    mLogger( loggingConfig.createLogger() )
+{}
+
+
+std::shared_ptr<const BoosterTemplate>
+BoosterTemplateCache::getBoosterTemplate( const std::string& setCode ) const
+{
+    std::lock_guard<std::mutex> lock( mMutex );
+
+    auto iter = mTemplates.find( setCode );
+    if( iter != mTemplates.end() )
+    {
+        mCacheHits++;
+        return iter->second;
+    }
+    mCacheMisses++;
+
+    mLogger->debug( "building booster template for set {}", setCode );
+    auto boosterTemplate = std::make_shared<const BoosterTemplate>( setCode,
+            mAllSetsData->getBoosterSlots( setCode ), mAllSetsData->getCardPool( setCode ) );
+
+    if( !boosterTemplate->getBoosterSlots().empty() && (boosterTemplate->getCardCount() > 0) )
+    {
+        mTemplates.insert( std::make_pair( setCode, boosterTemplate ) );
+    }
+    return boosterTemplate;
+}
@@ -0,0 +1,76 @@
+#ifndef BOOSTERTEMPLATE_H
+#define BOOSTERTEMPLATE_H
+
+#include "AllSetsData.h"
+#include "SetDataTypes.h"
+#include "CardDataTypes.h"
+
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Logging.h"
+
+// Immutable booster generation data for a set: the booster slots and the
+// set's card pool split into contiguous per-rarity name arrays.
+class BoosterTemplate
+{
+public:
+
+    typedef std::multimap<RarityType,std::string> SetRarityToCardMap;
+
+    BoosterTemplate( const std::string&           setCode,
+                     const std::vector<SlotType>& boosterSlots,
+                     const SetRarityToCardMap&    cardPool );
+
+    const std::string& getSetCode() const { return mSetCode; }
+    const std::vector<SlotType>& getBoosterSlots() const { return mBoosterSlots; }
+
+    // Names of all pool cards of a rarity.
+    const std::vector<std::string>& getCards( RarityType rarity ) const { return mCards[rarity]; }
+
+    unsigned int getCardCount() const { return mCardCount; }
+
+private:
+
+    const std::string                                    mSetCode;
+    const std::vector<SlotType>                          mBoosterSlots;
+    std::array<std::vector<std::string>,RARITY_UNKNOWN+1> mCards;
+    unsigned int                                         mCardCount;
+};
+
+
+// Builds booster templates on first use and shares them.  Safe to use
+// from multiple threads.
+class BoosterTemplateCache
+{
+public:
+
+    BoosterTemplateCache( const std::shared_ptr<const AllSetsData>& allSetsData,
+                          const Logging::Config&                    loggingConfig = Logging::Config() );
+
+    const std::shared_ptr<const AllSetsData>& getAllSetsData() const { return mAllSetsData; }
+
+    // Get the template for a set.  Templates without booster slots or
+    // cards (e.g. unknown set codes) are returned but not cached.
+    std::shared_ptr<const BoosterTemplate> getBoosterTemplate( const std::string& setCode ) const;
+
+    unsigned int getCacheHits() const { return mCacheHits; }
+    unsigned int getCacheMisses() const { return mCacheMisses; }
+
+private:
+
+    const std::shared_ptr<const AllSetsData> mAllSetsData;
+
+    mutable std::mutex                                                   mMutex;
+    mutable std::map<std::string,std::shared_ptr<const BoosterTemplate>> mTemplates;
+    mutable unsigned int                                                 mCacheHits;
+    mutable unsigned int                                                 mCacheMisses;
+
+    std::shared_ptr<spdlog::logger> mLogger;
+};
+
+#endif  // BOOSTERTEMPLATE_H
@@ -1,62 +1,97 @@
 #include "CardPoolSelector.h"
 
-#include <map>
-#include <set>
+#include <algorithm>
+#include <numeric>
+
+CardPoolSelector::CardPoolSelector( const std::shared_ptr<const BoosterTemplate>& boosterTemplate,
+                                    std::shared_ptr<RandGen>&                     rng,
+                                    float                                         mythicRareProbability,
+                                    const Logging::Config&                        loggingConfig )
+      : mMythicRareProbability( mythicRareProbability ), 
+        mTemplate( boosterTemplate ),
+        mRng( rng ),
+        mLogger( loggingConfig.createLogger() )
+{
+    for( RarityType rarity : gRarityTypeArray )
+    {
+        std::vector<unsigned int>& indexes = mCardPool[rarity];
+        indexes.resize( mTemplate->getCards( rarity ).size() );
+        std::iota( indexes.begin(), indexes.end(), 0 );
+        mPoolSizes[rarity] = indexes.size();
+    }
+}
+
 
 CardPoolSelector::CardPoolSelector( const SetRarityToCardMap& cardPool,
                                     std::shared_ptr<RandGen>& rng,
                                     float                     mythicRareProbability,
                                     const Logging::Config&    loggingConfig )
-      : mMythicRareProbability( mythicRareProbability ), 
-        mCardPool( cardPool ),
-        mRng( rng ),
-        mLogger( loggingConfig.createLogger() )
+      : CardPoolSelector( std::make_shared<const BoosterTemplate>( std::string(), std::vector<SlotType>(), cardPool ),
+                          rng, mythicRareProbability, loggingConfig )
 {}
 
 
 void
 CardPoolSelector::resetCardPool()
 {
-    for( auto item : mCardsRemovedFromPool )
+    // Removed cards are all past the partition point; the order of the
+    // permutation doesn't matter for random selection.
+    for( RarityType rarity : gRarityTypeArray )
+    {
+        mPoolSizes[rarity] = mCardPool[rarity].size();
+    }
+}
+
+
+int
+CardPoolSelector::getPoolSize() const
+{
+    int size = 0;
+    for( unsigned int poolSize : mPoolSizes )
     {
-        mLogger->debug( "resetCardPool(): putting back {}", item.second );
-        mCardPool.insert( item );
+        size += poolSize;
     }
-    mCardsRemovedFromPool.clear();
+    return size;
 }
 
 
 bool
 CardPoolSelector::selectCard( const SlotType& slot, std::string& selectedCard )
 {
-    bool result;
-    RarityType rarity;
-    result = getRarityForSlot( slot, rarity );
-    if( !result )
+    const std::string* card = selectCard( slot );
+    if( card == nullptr )
     {
         return false;
     }
+    selectedCard = *card;
+    return true;
+}
 
-    // Find range of items that match desired rarity.
-    auto iterPair = mCardPool.equal_range( rarity );
 
-    // If the range is empty then return the default.
-    if( iterPair.first == iterPair.second )
+const std::string*
+CardPoolSelector::selectCard( const SlotType& slot )
+{
+    RarityType rarity;
+    if( !getRarityForSlot( slot, rarity ) )
     {
-        return false;
+        return nullptr;
     }
 
-    // Otherwise return a random selection from the range.
-    auto itemIter = iterPair.first;
-    const int randAdv = mRng->generateInRange(
-            0, std::distance( iterPair.first, iterPair.second ) - 1 );
-    std::advance( itemIter, randAdv );
-    auto mapItem = *itemIter;
-    mCardPool.erase( itemIter );
-    mCardsRemovedFromPool.insert( mapItem );
-    selectedCard = mapItem.second;
+    // If there are no cards left of the desired rarity then fail.
+    unsigned int& poolSize = mPoolSizes[rarity];
+    if( poolSize == 0 )
+    {
+        return nullptr;
+    }
 
-    return true;
+    // Otherwise return a random selection from the remaining cards and
+    // move it past the partition point.
+    std::vector<unsigned int>& indexes = mCardPool[rarity];
+    const int randIdx = mRng->generateInRange( 0, poolSize - 1 );
+    poolSize--;
+    std::swap( indexes[randIdx], indexes[poolSize] );
+
+    return &mTemplate->getCards( rarity )[indexes[poolSize]];
 }
 
 
@@ -3,10 +3,13 @@
 
 #include "SetDataTypes.h"
 #include "CardDataTypes.h"
+#include "BoosterTemplate.h"
 
+#include <array>
 #include <map>
 #include <random>
 #include <memory>
+#include <vector>
 
 #include "RandGen.h"
 #include "Logging.h"
@@ -14,7 +17,13 @@
 class CardPoolSelector
 {
 public:
-    typedef std::multimap<RarityType,std::string> SetRarityToCardMap;
+    typedef BoosterTemplate::SetRarityToCardMap SetRarityToCardMap;
+
+    // Select from the card pool of a shared booster template.
+    CardPoolSelector( const std::shared_ptr<const BoosterTemplate>& boosterTemplate,
+                      std::shared_ptr<RandGen>&                     rng,
+                      float                                         mythicRareProbability = 0.125,
+                      const Logging::Config&                        loggingConfig = Logging::Config() );
 
     CardPoolSelector( const SetRarityToCardMap& cardPool,
                       std::shared_ptr<RandGen>& rng,
@@ -24,21 +33,31 @@ public:
     void setMythicRareProbability( const float& prob ) { mMythicRareProbability = prob; }
     float getMythicRareProbability() const { return mMythicRareProbability; }
 
-    // Reset the card pool.
+    // Reset the card pool.  Constant time per rarity.
     void resetCardPool();
 
     // Select a card randomly based on slot type and remove it from the card pool.
     bool selectCard( const SlotType& slot, std::string& selectedCard );
 
-    int getPoolSize() { return mCardPool.size(); }
+    // As above, but returns the name from the template without copying, or
+    // nullptr if no card could be selected.  Constant time; does not allocate.
+    const std::string* selectCard( const SlotType& slot );
+
+    int getPoolSize() const;
 
 private:
 
     bool getRarityForSlot( const SlotType& slot, RarityType& rarity ) const;
 
     float mMythicRareProbability;
-    SetRarityToCardMap mCardPool;
-    SetRarityToCardMap mCardsRemovedFromPool;
+    std::shared_ptr<const BoosterTemplate> mTemplate;
+
+    // Per-rarity permutation of template card indexes.  The first
+    // mPoolSizes[rarity] entries are still in the pool; selected cards are
+    // swapped to the end so a reset only has to restore the size.
+    std::array<std::vector<unsigned int>,RARITY_UNKNOWN+1> mCardPool;
+    std::array<unsigned int,RARITY_UNKNOWN+1>              mPoolSizes;
+
     std::shared_ptr<RandGen> mRng;
     std::shared_ptr<spdlog::logger> mLogger;
 };
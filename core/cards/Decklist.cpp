@@ -1,7 +1,17 @@
 #include "Decklist.h"
-#include "StringUtil.h"
+#include <algorithm>
+#include <limits>
 #include <sstream>
-#include <regex>
+
+
+// Any value past the largest quantity will do.
+static const unsigned long QTY_SATURATED = 0x10000;
+
+static bool isTrimmable( char c ) { return (c == ' ') || (c == '\t'); }
+static bool isPrintable( char c ) { return (c >= 0x20) && (c <= 0x7e); }
+static bool isSpace( char c ) { return (c == ' ') || ((c >= '\t') && (c <= '\r')); }
+static bool isDigit( char c ) { return (c >= '0') && (c <= '9'); }
+static bool isAlnum( char c ) { return isDigit( c ) || ((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')); }
 
 
 bool
@@ -143,97 +153,86 @@ Decklist::parse( const std::string& deckStr )
 {
     ParseResult result;
 
-    std::stringstream ss( deckStr );
-    std::string rawLine;
-    std::string line;
-
-    // Printable regex: All characters printable.
-    std::regex printableRegex( "^[[:print:]]*$" );
-
-    // Comment regex: Two forward slashes followed by anything
-    std::regex commentRegex( "^//.*$" );
-
-    // MWDECK regex
-    std::regex mwdeckRegex( // "SB", case-insensitive with optional colon
-                            "^([sS][bB]:?[[:space:]]*)?"
-
-                            // qty with optional case-insensitive 'x'
-                            "(([[:digit:]]+)[xX]?[[:space:]]*)?"
-
-                            // set in brackets
-                            "\\[([[:alnum:]]*)\\]?[[:space:]]*"
-
-                            // name
-                            "(.*)$" );
-
-    // DEC regex
-    std::regex decRegex( // "SB", case-insensitive with optional colon
-                         "^([sS][bB]:?[[:space:]]*)?"
-
-                         // qty with optional case-insensitive 'x'
-                         "(([[:digit:]]+)[xX]?[[:space:]]*)?"
-
-                         // name
-                         "(.*)$" );
-
+    // Lines are tokenized in place in a single pass.  After trimming, a
+    // line is either a comment (starting with "//") or:
+    //
+    //   [ "SB" [":"] space* ] [ digit+ ["x"] space* ] [ "[" alnum* ["]"] space* ] name
+    //
+    // where "SB" and "x" are case-insensitive and the bracketed set code
+    // is the MWDECK extension to DEC format.  Character classes are
+    // those of the classic locale.
+
+    const char* const deckEnd = deckStr.data() + deckStr.size();
+    const char* next = deckStr.data();
     unsigned int lineNum = 0;
-    while( std::getline( ss, rawLine ) )
+    while( next < deckEnd )
     {
+        const char* const rawBegin = next;
+        const char* const rawEnd = std::find( rawBegin, deckEnd, '\n' );
+        next = (rawEnd < deckEnd) ? rawEnd + 1 : deckEnd;
         lineNum++;
-        std::smatch match;
 
-        line = StringUtil::trim( rawLine );
+        // Trim spaces and tabs.
+        const char* p = rawBegin;
+        const char* end = rawEnd;
+        while( (p < end) && isTrimmable( *p ) ) ++p;
+        while( (end > p) && isTrimmable( *(end - 1) ) ) --end;
 
-        bool sb = false;
-        std::string qtyStr;
-        std::string nameStr;
-        std::string setStr;
-
-        if( line.empty() )
+        if( p == end )
         {
             continue;
         }
-        else if( !std::regex_match( line, match, printableRegex ) )
+        else if( !std::all_of( p, end, isPrintable ) )
         {
             result.errors.push_back( ParseResult::Error( lineNum, "<binary data>", "Contains binary data" ) );
             continue;
         }
-        else if( std::regex_match( line, match, commentRegex ) )
+        else if( (end - p >= 2) && (p[0] == '/') && (p[1] == '/') )
         {
             continue;
         }
-        else if( std::regex_match( line, match, mwdeckRegex ) )
-        {
-            sb = !match[1].str().empty();
-            qtyStr = match[3].str();
-            setStr = match[4].str();
-            nameStr = match[5].str();
-        }
-        else if( std::regex_match( line, match, decRegex ) )
+
+        bool sb = false;
+        if( (end - p >= 2) && ((p[0] == 's') || (p[0] == 'S')) && ((p[1] == 'b') || (p[1] == 'B')) )
         {
-            sb = !match[1].str().empty();
-            qtyStr = match[3].str();
-            nameStr = match[4].str();
+            sb = true;
+            p += 2;
+            if( (p < end) && (*p == ':') ) ++p;
+            while( (p < end) && isSpace( *p ) ) ++p;
         }
-        else
+
+        // Quantities too large saturate, as with stream extraction.
+        uint16_t qty = 1;
+        if( (p < end) && isDigit( *p ) )
         {
-            result.errors.push_back( ParseResult::Error( lineNum, rawLine, "Unrecognized format" ) );
-            continue;
+            unsigned long value = 0;
+            while( (p < end) && isDigit( *p ) )
+            {
+                value = std::min( value * 10 + (*p - '0'), QTY_SATURATED );
+                ++p;
+            }
+            qty = static_cast<uint16_t>( std::min( value, (unsigned long) std::numeric_limits<uint16_t>::max() ) );
+            if( (p < end) && ((*p == 'x') || (*p == 'X')) ) ++p;
+            while( (p < end) && isSpace( *p ) ) ++p;
         }
 
-        if( nameStr.empty() )
+        std::string setStr;
+        if( (p < end) && (*p == '[') )
         {
-            result.errors.push_back( ParseResult::Error( lineNum, rawLine, "Missing name field" ) );
-            continue;
+            const char* const setBegin = ++p;
+            while( (p < end) && isAlnum( *p ) ) ++p;
+            setStr.assign( setBegin, p );
+            if( (p < end) && (*p == ']') ) ++p;
+            while( (p < end) && isSpace( *p ) ) ++p;
         }
 
-        SimpleCardData c( nameStr, setStr );
-        uint16_t qty = 1;
-        if( !qtyStr.empty() )
+        if( p == end )
         {
-            std::istringstream( qtyStr ) >> qty;
+            result.errors.push_back( ParseResult::Error( lineNum, std::string( rawBegin, rawEnd ), "Missing name field" ) );
+            continue;
         }
 
+        SimpleCardData c( std::string( p, end ), setStr );
         if( sb )
         {
             mCardQtySideboardMap[c] = qty;
@@ -246,4 +245,3 @@ Decklist::parse( const std::string& deckStr )
 
     return result;
 }
-
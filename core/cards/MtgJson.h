@@ -4,7 +4,6 @@
 #include "CardDataTypes.h"
 #include <string>
 #include <vector>
-#include "rapidjson/document.h"
 
 namespace MtgJson
 {
@@ -24,30 +23,13 @@ namespace MtgJson
             return RARITY_UNKNOWN;
     }
 
-    inline bool isSplitCard( const rapidjson::Value& cardValue )
-    {
-        rapidjson::Value::ConstMemberIterator itr = cardValue.FindMember( "layout" );
-        if( itr != cardValue.MemberEnd() )
-        {
-            if( itr->value.IsString() )
-            {
-                std::string layoutStr( itr->value.GetString() );
-                return ( layoutStr == "split" );
-            }
-        }
-        return false;
-    }
-
-    inline std::string createSplitCardName( const rapidjson::Value& namesValue )
+    inline std::string createSplitCardName( const std::vector<std::string>& names )
     {
         std::string name;
-        if( namesValue.IsArray() && !namesValue.Empty() )
+        for( unsigned int i = 0; i < names.size(); ++i )
         {
-            for( unsigned int i = 0; i < namesValue.Size(); ++i )
-            {
-                if( i != 0 ) name += " // ";
-                if( namesValue[i].IsString() ) name += namesValue[i].GetString();
-            }
+            if( i != 0 ) name += " // ";
+            name += names[i];
         }
         return name;
     }
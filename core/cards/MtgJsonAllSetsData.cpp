@@ -1,19 +1,16 @@
 #include "MtgJsonAllSetsData.h"
-#include "MtgJsonCardData.h"
+#include "MtgJson.h"
+#include "AllSetsSnapshot.h"
 
 #include "StringUtil.h"
 
-#include "rapidjson/document.h"
-#include "rapidjson/filereadstream.h"
-#include "rapidjson/error/en.h"
-
+#include <algorithm>
 #include <map>
 
-using namespace rapidjson;
-
 MtgJsonAllSetsData::MtgJsonAllSetsData( unsigned int    cacheSize,
                                         Logging::Config loggingConfig )
-  : mCardLookupLRUCache( cacheSize ),
+  : mStore( loggingConfig.createChildConfig( "store" ) ),
+    mCardLookupLRUCache( cacheSize ),
     mCardLookupLRUCacheHits( 0 ),
     mCardLookupLRUCacheMisses( 0 ),
     mSetCodeLookupLRUCache( cacheSize ),
@@ -26,15 +23,9 @@ MtgJsonAllSetsData::MtgJsonAllSetsData( unsigned int    cacheSize,
 bool
 MtgJsonAllSetsData::parse( FILE* fp )
 {
-    char readBuffer[65536];
-    FileReadStream is( fp, readBuffer, sizeof(readBuffer) );
-    mLogger->debug( "parsing mtgjson file" );
-    mDoc.ParseStream( is );
-
-    if( mDoc.HasParseError() )
+    // The store does all JSON verification up front so future calls are easy.
+    if( !mStore.parse( fp ) )
     {
-        mLogger->error( "json parsing error (offset {}): {}",
-                mDoc.GetErrorOffset(), GetParseError_En( mDoc.GetParseError() ) );
         return false;
     }
 
@@ -44,65 +35,34 @@ MtgJsonAllSetsData::parse( FILE* fp )
     SetCodesByReleaseDateMap scrdMapLo;
     std::vector<std::string> setCodesNoReleaseDate;
 
-    // Do all JSON verification up front so future calls are easy.
-    for( Value::ConstMemberIterator setIter = mDoc.MemberBegin(); setIter != mDoc.MemberEnd(); ++setIter )
+    for( const MtgJsonCardStore::Set& set : mStore.getSets() )
     {
-        const std::string setCode = setIter->name.GetString();
-        const Value& setValue = setIter->value;
-        if( !setValue.IsObject() )
-        {
-            mLogger->warn( "set value for {} is not an object", setCode );
-            continue;
-        }
-
-        if( !setValue.HasMember("name") )
-        {
-            mLogger->warn( "set value for {} has no 'name' member, ignoring set", setCode );
-            continue;
-        }
-        if( !setValue["name"].IsString() )
-        {
-            mLogger->warn( "'name' member for {} is not a string", setCode );
-            continue;
-        }
-
-        if( !setValue.HasMember("cards") )
-        {
-            mLogger->warn( "set value for {} has no 'cards' member, ignoring set", setCode );
-            continue;
-        }
-        if( !setValue["cards"].IsArray() )
-        {
-            mLogger->warn( "'cards' member for {} is not an array", setCode );
-            continue;
-        }
+        const std::string& setCode = set.code;
 
         // Note that inserting the code into the set will lose file ordering of the sets;
         // the set codes will be ordered alphabetically.
         mAllSetCodes.insert( setCode );
 
         // Accumulate sets in the release date multimap.
-        if( setValue.HasMember("releaseDate") && setValue["releaseDate"].IsString() )
+        if( set.hasReleaseDate )
         {
-            const std::string& relDateStr = setValue["releaseDate"].GetString();
-            if( setValue.HasMember("type") && setValue["type"].IsString() )
+            if( set.hasType )
             {
                 // Type "expansion" or "core" sets are higher-priority.
-                const std::string& typeStr = setValue["type"].GetString();
-                if( (typeStr == "expansion") || (typeStr == "core") )
+                if( (set.type == "expansion") || (set.type == "core") )
                 {
-                    scrdMapHi.insert( std::make_pair( relDateStr, setCode ) );
+                    scrdMapHi.insert( std::make_pair( set.releaseDate, setCode ) );
                 }
                 else
                 {
-                    scrdMapLo.insert( std::make_pair( relDateStr, setCode ) );
+                    scrdMapLo.insert( std::make_pair( set.releaseDate, setCode ) );
                 }
             }
             else
             {
                 // No type for set - treat as low priority.
                 mLogger->notice( "'type' member not present or invalid for {}", setCode );
-                scrdMapLo.insert( std::make_pair( relDateStr, setCode ) );
+                scrdMapLo.insert( std::make_pair( set.releaseDate, setCode ) );
             }
         }
         else
@@ -111,21 +71,10 @@ MtgJsonAllSetsData::parse( FILE* fp )
             setCodesNoReleaseDate.push_back( setCode );
         }
 
-        if( !setValue.HasMember("booster") )
-        {
-            // This is expected for some sets so it's not a warning.
-            mLogger->debug( "set value for {} has no 'booster' member", setCode );
-            continue;
-        }
-        if( !setValue["booster"].IsArray() )
+        if( set.hasBooster )
         {
-            mLogger->warn( "'booster' member for {} is not an array", setCode );
-            continue;
+            mBoosterSetCodes.insert( setCode );
         }
-
-        // Note that inserting the code into the set will lose file ordering of the sets;
-        // the set codes will be ordered alphabetically.
-        mBoosterSetCodes.insert( setCode );
     }
 
     // Assemble the prioritized set code vector.  This is the high priority
@@ -148,6 +97,207 @@ MtgJsonAllSetsData::parse( FILE* fp )
         mSearchPrioritizedAllSetCodes.push_back( sc );
     }
 
+    buildIndexes();
+
+    return true;
+}
+
+
+void
+MtgJsonAllSetsData::buildIndexes()
+{
+    mLogger->debug( "building card indexes" );
+
+    std::map<std::string,const MtgJsonCardStore::Set*> setsByCode;
+    for( const MtgJsonCardStore::Set& set : mStore.getSets() )
+    {
+        setsByCode.insert( std::make_pair( set.code, &set ) );
+    }
+
+    mSearchPrioritizedSets.reserve( mSearchPrioritizedAllSetCodes.size() );
+    for( unsigned int setIndex = 0; setIndex < mSearchPrioritizedAllSetCodes.size(); ++setIndex )
+    {
+        const std::string& setCode = mSearchPrioritizedAllSetCodes[setIndex];
+        mSetIndexMap[setCode] = setIndex;
+
+        const MtgJsonCardStore::Set* set = setsByCode.at( setCode );
+        mSearchPrioritizedSets.push_back( set );
+
+        // Sets are visited in priority order and cards in file order, so
+        // postings come out sorted and the first card per set wins, same
+        // as a linear search would.
+        for( uint32_t card = set->firstCard; card < set->firstCard + set->cardCount; ++card )
+        {
+            const CardRef ref { setIndex, card };
+
+            const uint32_t nameKey = mStore.getNameKey( card );
+            if( nameKey == MtgJsonCardStore::NO_STRING )
+            {
+                continue;
+            }
+            addNamePosting( mNameIndex, mStore.getString( nameKey ), ref );
+
+            // Cards with multiple names (i.e. split cards) are also indexed
+            // by their full split card name, separately so that normalized
+            // names only ever match split cards.
+            const uint32_t splitNameKey = mStore.getSplitNameKey( card );
+            if( splitNameKey != MtgJsonCardStore::NO_STRING )
+            {
+                addNamePosting( mSplitNameIndex, mStore.getString( splitNameKey ), ref );
+            }
+        }
+    }
+
+    // Multiverse ids are indexed in alphabetical set order so that the
+    // first match is the same as a search through mAllSetCodes.
+    for( const std::string& setCode : mAllSetCodes )
+    {
+        const unsigned int setIndex = mSetIndexMap[setCode];
+        const MtgJsonCardStore::Set* set = mSearchPrioritizedSets[setIndex];
+        for( uint32_t card = set->firstCard; card < set->firstCard + set->cardCount; ++card )
+        {
+            const int multiverseId = mStore.getMultiverseId( card );
+            if( multiverseId != -1 )
+            {
+                const CardRef ref { setIndex, card };
+                mMultiverseIdIndex.emplace( multiverseId, ref );
+            }
+        }
+    }
+
+    mLogger->debug( "indexed {} names, {} split names, {} multiverse ids",
+            mNameIndex.size(), mSplitNameIndex.size(), mMultiverseIdIndex.size() );
+}
+
+
+void
+MtgJsonAllSetsData::addNamePosting( NameIndex& index, const std::string& key, const CardRef& ref )
+{
+    CardPostings& postings = index[key];
+    if( postings.empty() || (postings.back().setIndex != ref.setIndex) )
+    {
+        postings.push_back( ref );
+    }
+}
+
+
+bool
+MtgJsonAllSetsData::writeSnapshot( FILE* fp, const std::string& dataVersion ) const
+{
+    using namespace AllSetsSnapshot;
+
+    mLogger->debug( "writing snapshot for data version {}", dataVersion );
+
+    Builder builder;
+    builder.setDataVersion( dataVersion );
+
+    // Snapshot sets are ordered alphabetically, so track where each
+    // search-prioritized set and its cards end up.
+    std::vector<uint32_t> snapshotSetIndexes( mSearchPrioritizedAllSetCodes.size() );
+    std::vector<uint32_t> snapshotFirstCardIndexes( mSearchPrioritizedAllSetCodes.size() );
+
+    for( const std::string& setCode : mAllSetCodes )
+    {
+        const unsigned int setIndex = mSetIndexMap.at( setCode );
+        const MtgJsonCardStore::Set* set = mSearchPrioritizedSets[setIndex];
+
+        SetRecord setRecord;
+        setRecord.code = builder.addString( setCode );
+        setRecord.name = builder.addString( set->name );
+        setRecord.gathererCode = builder.addString( set->gathererCode );
+        setRecord.flags = set->hasGathererCode ? SET_FLAG_GATHERER_CODE : 0;
+        setRecord.priority = setIndex;
+
+        setRecord.firstSlot = builder.slots.size();
+        if( set->hasBooster )
+        {
+            setRecord.flags |= SET_FLAG_BOOSTER;
+            for( SlotType slot : set->boosterSlots )
+            {
+                builder.slots.push_back( slot );
+            }
+        }
+        setRecord.slotCount = builder.slots.size() - setRecord.firstSlot;
+
+        setRecord.firstCard = builder.cards.size();
+        for( uint32_t card = set->firstCard; card < set->firstCard + set->cardCount; ++card )
+        {
+            CardRecord cardRecord;
+            cardRecord.name = builder.addString( mStore.getName( card ) );
+            cardRecord.multiverseId = mStore.getMultiverseId( card );
+            cardRecord.cmc = mStore.getCMC( card );
+            cardRecord.rarity = mStore.getRarity( card );
+            cardRecord.colorsMask = mStore.getColorsMask( card );
+            cardRecord.reserved = 0;
+
+            cardRecord.flags = 0;
+            if( mStore.getFlags( card ) & MtgJsonCardStore::CARD_FLAG_SPLIT )   cardRecord.flags |= CARD_FLAG_SPLIT;
+            if( mStore.getFlags( card ) & MtgJsonCardStore::CARD_FLAG_IN_POOL ) cardRecord.flags |= CARD_FLAG_IN_POOL;
+
+            // Store type bits are remapped onto the snapshot's type table.
+            cardRecord.typesMask = 0;
+            for( const std::string& type : mStore.getTypes( card ) )
+            {
+                const int bit = builder.addType( type );
+                if( bit < 0 )
+                {
+                    mLogger->error( "too many card types for snapshot" );
+                    return false;
+                }
+                cardRecord.typesMask |= (1u << bit);
+            }
+
+            builder.cards.push_back( cardRecord );
+        }
+        setRecord.cardCount = builder.cards.size() - setRecord.firstCard;
+
+        snapshotSetIndexes[setIndex] = builder.sets.size();
+        snapshotFirstCardIndexes[setIndex] = setRecord.firstCard;
+        builder.sets.push_back( setRecord );
+    }
+
+    for( uint32_t snapshotSetIndex : snapshotSetIndexes )
+    {
+        builder.setPriorities.push_back( snapshotSetIndex );
+    }
+
+    for( const NameIndex* index : { &mNameIndex, &mSplitNameIndex } )
+    {
+        const uint32_t flags = (index == &mSplitNameIndex) ? NAME_KEY_FLAG_SPLIT : 0;
+        for( const auto& kv : *index )
+        {
+            NameKeyRecord nameKeyRecord;
+            nameKeyRecord.key = builder.addString( kv.first );
+            nameKeyRecord.flags = flags;
+            nameKeyRecord.firstPosting = builder.postings.size();
+            nameKeyRecord.postingCount = kv.second.size();
+            for( const CardRef& ref : kv.second )
+            {
+                const uint32_t cardOffset = ref.cardIndex - mSearchPrioritizedSets[ref.setIndex]->firstCard;
+                const PostingRecord posting { snapshotSetIndexes[ref.setIndex],
+                                              snapshotFirstCardIndexes[ref.setIndex] + cardOffset };
+                builder.postings.push_back( posting );
+            }
+            builder.nameKeys.push_back( nameKeyRecord );
+        }
+    }
+
+    for( const auto& kv : mMultiverseIdIndex )
+    {
+        const CardRef& ref = kv.second;
+        const uint32_t cardOffset = ref.cardIndex - mSearchPrioritizedSets[ref.setIndex]->firstCard;
+        const MuidRecord muidRecord { kv.first, snapshotFirstCardIndexes[ref.setIndex] + cardOffset };
+        builder.muids.push_back( muidRecord );
+    }
+
+    if( !builder.write( fp ) )
+    {
+        mLogger->error( "error writing snapshot" );
+        return false;
+    }
+
+    mLogger->debug( "wrote snapshot: {} sets, {} cards, {} names",
+            builder.sets.size(), builder.cards.size(), builder.nameKeys.size() );
     return true;
 }
 
@@ -167,35 +317,34 @@ MtgJsonAllSetsData::getSetCodes() const
 std::string
 MtgJsonAllSetsData::getSetName( const std::string& code, const std::string& defaultName ) const
 {
-    if( mAllSetCodes.count(code) == 0 )
+    const MtgJsonCardStore::Set* set = findSet( code );
+    if( set == nullptr )
     {
         mLogger->warn( "Unable to find set {}, returning default name", code );
         return defaultName;
     }
-    const Value& nameValue = mDoc[code]["name"];
-    return nameValue.GetString();
+    return set->name;
 }
 
 
 std::string
 MtgJsonAllSetsData::getSetGathererCode( const std::string& code, const std::string& defaultVal ) const
 {
-    if( mAllSetCodes.count(code) == 0 )
+    const MtgJsonCardStore::Set* set = findSet( code );
+    if( set == nullptr )
     {
         mLogger->warn( "Unable to find set {}, returning default gatherer code", code );
         return defaultVal;
     }
 
     // Gatherer code may not be present.
-    const Value& setValue = mDoc[code];
-    if( !setValue.HasMember("gathererCode") )
+    if( !set->hasGathererCode )
     {
         mLogger->debug( "Unable to find gatherer code for set {}, returning default gatherer code", code );
         return defaultVal;
     }
 
-    const Value& gathererCodeValue = mDoc[code]["gathererCode"];
-    return gathererCodeValue.GetString();
+    return set->gathererCode;
 }
 
 
@@ -209,66 +358,14 @@ MtgJsonAllSetsData::hasBoosterSlots( const std::string& code ) const
 std::vector<SlotType>
 MtgJsonAllSetsData::getBoosterSlots( const std::string& code ) const
 {
-    std::vector<SlotType> boosterSlots;
-
     if( mBoosterSetCodes.count(code) == 0 )
     {
         mLogger->warn( "No booster member in set {}, returning empty booster slots", code );
-        return boosterSlots;
+        return std::vector<SlotType>();
     }
 
-    // In parse() this was vetted to be safe and yield an Array-type value.
-    const Value& boosterValue = mDoc[code]["booster"];
-
-    mLogger->debug( "{:-^40}", "assembling booster slots" );
-    for( Value::ConstValueIterator iter = boosterValue.Begin(); iter != boosterValue.End(); ++iter )
-    {
-        if( iter->IsArray() )
-        {
-            // create a set of any strings in the array
-            std::set<std::string> slotArraySet;
-            for( unsigned i = 0; i < iter->Size(); ++i )
-            {
-                const Value& val = (*iter)[i];
-                if( val.IsString() )
-                {
-                    slotArraySet.insert( val.GetString() );
-                    mLogger->debug( "booster slot array[{}]: {}", i, val.GetString() );
-                }
-                else
-                {
-                    mLogger->warn( "Non-string in booster slot array, ignoring!" );
-                }
-            }
-            const std::set<std::string> rareMythicRareSlot { "rare", "mythic rare" };
-            if( slotArraySet == rareMythicRareSlot )
-                boosterSlots.push_back( SLOT_RARE_OR_MYTHIC_RARE );
-            else
-                mLogger->warn( "Unrecognized booster slot array, ignoring!" );
-        }
-        else if( iter->IsString() )
-        {
-            std::string slotStr( iter->GetString() );
-            mLogger->debug( "booster slot string: {}", slotStr );
-            if( slotStr == "common" )
-                boosterSlots.push_back( SLOT_COMMON );
-            else if( slotStr == "uncommon" )
-                boosterSlots.push_back( SLOT_UNCOMMON );
-            else if( slotStr == "rare" )
-                boosterSlots.push_back( SLOT_RARE );
-            else if( slotStr == "timeshifted purple" )
-                boosterSlots.push_back( SLOT_TIMESHIFTED_PURPLE );
-            else if( slotStr == "land" )      { /* do nothing */ }
-            else if( slotStr == "marketing" ) { /* do nothing */ }
-            else
-                mLogger->warn( "Unrecognized booster slot type {}, ignoring!", slotStr );
-        }
-        else
-        {
-            mLogger->warn( "Non-string booster slot type, ignoring!" );
-        }
-    }
-    return boosterSlots;
+    // Slots were translated when the store was built.
+    return findSet( code )->boosterSlots;
 }
 
 
@@ -277,75 +374,22 @@ MtgJsonAllSetsData::getCardPool( const std::string& code ) const
 {
     std::multimap<RarityType,std::string> rarityMap;
 
-    if( mAllSetCodes.count(code) == 0 )
+    const MtgJsonCardStore::Set* set = findSet( code );
+    if( set == nullptr )
     {
         mLogger->warn( "Unable to find set {}, returning empty card pool", code );
         return rarityMap;
     }
 
-    // In parse() this was vetted to be safe and yield an Array-type value.
-    const Value& cardsValue = mDoc[code]["cards"];
-
+    // Entries that should be counted once in the pool (i.e. not duplicate
+    // entries for split/flip/double-sided cards or card variations) were
+    // flagged when the store was built.
     mLogger->debug( "{:-^40}", "assembling card pool" );
-    for( Value::ConstValueIterator iter = cardsValue.Begin(); iter != cardsValue.End(); ++iter )
+    for( uint32_t card = set->firstCard; card < set->firstCard + set->cardCount; ++card )
     {
-        Value::ConstMemberIterator nameIter = iter->FindMember( "name" );
-        Value::ConstMemberIterator rarityIter = iter->FindMember( "rarity" );
-
-        if( nameIter != iter->MemberEnd() && nameIter->value.IsString() &&
-            rarityIter != iter->MemberEnd() && rarityIter->value.IsString() )
-        {
-            std::string nameStr( nameIter->value.GetString() );
-            std::string rarityStr( rarityIter->value.GetString() );
-            mLogger->debug( "json: {} : {}", nameStr, rarityStr );
-
-            // Some cards have multiple entries (i.e. split/flip/double-sided),
-            // so make sure they are only represented once.  Done by skipping
-            // over cards whose name doesn't match the first entry of the
-            // 'names' array (if it exists).
-            if( iter->HasMember("names") )
-            {
-                const Value& names = (*iter)["names"];
-                if( names.IsArray() && !names.Empty() && (nameStr != names[0]) )
-                {
-                    continue;
-                }
-
-                // Modify the name for split cards.
-                if( MtgJson::isSplitCard( *iter ) )
-                {
-                    nameStr = MtgJson::createSplitCardName( names );
-                }
-
-            }
-
-            // Some cards have variations with multiple entries that should
-            // only be counted once.  Done by checking if there are
-            // variations and checking a card's number for a non-digit,
-            // non-'a' ending.
-            if( iter->HasMember("variations") && iter->HasMember("number") )
-            {
-                const Value& numberValue = (*iter)["number"];
-                if( numberValue.IsString() )
-                {
-                    const std::string numberStr( numberValue.GetString() );
-                    const char c = numberStr.back();
-                    if( !std::isdigit( c ) && (c != 'a') )
-                    {
-                        continue;
-                    }
-                }
-            }
-
-            RarityType rarity = MtgJson::getRarityFromString( rarityStr );
-            if( rarity != RARITY_UNKNOWN )
-                rarityMap.insert( std::make_pair( rarity, nameStr ) );
-            else
-                mLogger->warn( "Unknown rarity type {}, ignoring!", rarityStr );
-        }
-        else
+        if( mStore.getFlags( card ) & MtgJsonCardStore::CARD_FLAG_IN_POOL )
         {
-            mLogger->notice( "card entry without name or rarity in set {}", code );
+            rarityMap.insert( std::make_pair( mStore.getRarity( card ), mStore.getName( card ) ) );
         }
     }
 
@@ -361,8 +405,7 @@ MtgJsonAllSetsData::createCardData( const std::string& code, const std::string&
     if( mCardLookupLRUCache.exists( cardLookupCacheKey ) )
     {
         mCardLookupLRUCacheHits++;
-        Value::ConstValueIterator iter = mCardLookupLRUCache.get( cardLookupCacheKey );
-        return new MtgJsonCardData( code, *iter );
+        return mStore.createCardData( mCardLookupLRUCache.get( cardLookupCacheKey ), code );
     }
     mCardLookupLRUCacheMisses++;
 
@@ -372,16 +415,12 @@ MtgJsonAllSetsData::createCardData( const std::string& code, const std::string&
         return nullptr;
     }
 
-    // In parse() this was vetted to be safe and yield an Array-type value.
-    const Value& cardsValue = mDoc[code]["cards"];
-
-    Value::ConstValueIterator iter = findCardValueByName(
-            cardsValue.Begin(), cardsValue.End(), name );
-    if( iter != cardsValue.End() )
+    const CardRef* ref = findCardRef( name, mSetIndexMap.at( code ) );
+    if( ref != nullptr )
     {
         mLogger->debug( "found name {}", name );
-        mCardLookupLRUCache.put( cardLookupCacheKey, iter );
-        return new MtgJsonCardData( code, *iter );
+        mCardLookupLRUCache.put( cardLookupCacheKey, ref->cardIndex );
+        return mStore.createCardData( ref->cardIndex, code );
     }
 
     mLogger->debug( "unable to find card name {}", name );
@@ -392,30 +431,12 @@ MtgJsonAllSetsData::createCardData( const std::string& code, const std::string&
 CardData*
 MtgJsonAllSetsData::createCardData( int multiverseId ) const
 {
-    // Unfortunately this is a slow linear search.
-    for( const std::string& setCode : mAllSetCodes )
+    auto iter = mMultiverseIdIndex.find( multiverseId );
+    if( iter != mMultiverseIdIndex.end() )
     {
-        // In parse() this was vetted to be safe and yield an Array-type value.
-        const Value& cardsValue = mDoc[setCode]["cards"];
-
-        // This is a linear search looking for the multiverse id.
-        for( Value::ConstValueIterator iter = cardsValue.Begin();
-                iter != cardsValue.End(); ++iter )
-        {
-            if( iter->HasMember("multiverseid") )
-            {
-                const Value& multiverseIdValue = (*iter)["multiverseid"];
-                if( multiverseIdValue.IsInt() )
-                {
-                    int muid = multiverseIdValue.GetInt();
-                    if( muid == multiverseId )
-                    {
-                        mLogger->debug( "found muid ", muid );
-                        return new MtgJsonCardData( setCode, *iter );
-                    }
-                }
-            }
-        }
+        mLogger->debug( "found muid {}", multiverseId );
+        const CardRef& ref = iter->second;
+        return mStore.createCardData( ref.cardIndex, mSearchPrioritizedAllSetCodes[ref.setIndex] );
     }
 
     mLogger->warn( "unable to find card multiverseId {}", multiverseId );
@@ -423,6 +444,18 @@ MtgJsonAllSetsData::createCardData( int multiverseId ) const
 }
 
 
+CardData*
+MtgJsonAllSetsData::createCardData( const CardHandle& handle ) const
+{
+    if( (handle.setIndex >= mSearchPrioritizedAllSetCodes.size()) ||
+        (handle.cardIndex >= mStore.getCardCount()) )
+    {
+        return nullptr;
+    }
+    return mStore.createCardData( handle.cardIndex, mSearchPrioritizedAllSetCodes[handle.setIndex] );
+}
+
+
 std::string
 MtgJsonAllSetsData::findSetCode( const std::string& name ) const
 {
@@ -435,18 +468,10 @@ MtgJsonAllSetsData::findSetCode( const std::string& name ) const
     mSetCodeLookupLRUCacheMisses++;
 
     std::string retSetCode;
-    for( const std::string& setCode : mSearchPrioritizedAllSetCodes )
+    const CardRef* ref = findCardRef( name );
+    if( ref != nullptr )
     {
-        // In parse() this was vetted to be safe and yield an Array-type value.
-        const Value& cardsValue = mDoc[setCode]["cards"];
-
-        Value::ConstValueIterator iter = findCardValueByName(
-                cardsValue.Begin(), cardsValue.End(), name );
-        if( iter != cardsValue.End() )
-        {
-            retSetCode = setCode;
-            break;
-        }
+        retSetCode = mSearchPrioritizedAllSetCodes[ref->setIndex];
     }
 
     // Cache the search result and return.
@@ -455,37 +480,95 @@ MtgJsonAllSetsData::findSetCode( const std::string& name ) const
 }
 
 
-Value::ConstValueIterator
-MtgJsonAllSetsData::findCardValueByName( Value::ConstValueIterator first,
-                                         Value::ConstValueIterator last,
-                                         const std::string&        name ) const
+std::vector<AllSetsData::CardResolution>
+MtgJsonAllSetsData::resolveCards( const std::vector<SimpleCardData>& cards ) const
 {
-    Value::ConstValueIterator iter = first;
-
-    for( Value::ConstValueIterator iter = first; iter != last; ++iter )
+    std::vector<CardResolution> resolutions( cards.size() );
+    unsigned int unresolvedCount = 0;
+
+    // Lists repeat cards (often heavily in packs), so each distinct card
+    // is looked up once.
+    std::unordered_map<SimpleCardData,std::size_t> firstIndexMap;
+    firstIndexMap.reserve( cards.size() );
+    for( std::size_t i = 0; i < cards.size(); ++i )
     {
-        std::string nameStr( (*iter)["name"].GetString() );
-        if( StringUtil::icompare( nameStr, name ) )
+        auto firstIndexResult = firstIndexMap.insert( std::make_pair( cards[i], i ) );
+        if( !firstIndexResult.second )
         {
-            mLogger->debug( "found name {}", name );
-            return iter;
+            resolutions[i] = resolutions[firstIndexResult.first->second];
+            if( !resolutions[i].isResolved() ) unresolvedCount++;
+            continue;
         }
-        else if( iter->HasMember("names") )
+
+        const std::string name = cards[i].getName();
+        auto setIndexIter = mSetIndexMap.find( cards[i].getSetCode() );
+        const CardRef* ref = (setIndexIter != mSetIndexMap.end()) ? findCardRef( name, setIndexIter->second ) : nullptr;
+        if( ref == nullptr ) ref = findCardRef( name );
+
+        if( ref != nullptr )
+        {
+            resolutions[i].handle = CardHandle( ref->setIndex, ref->cardIndex );
+            resolutions[i].setCode = mSearchPrioritizedAllSetCodes[ref->setIndex];
+        }
+        else
         {
-            // Here we check if the card has multiple names, i.e. split
-            // cards.  If so, create a split card name and normalize the
-            // name parameter and see if they match.
+            unresolvedCount++;
+        }
+    }
 
-            std::string splitCardName = MtgJson::createSplitCardName( (*iter)["names"] );
-            std::string nameNormalized = MtgJson::normalizeSplitCardName( name );
+    mLogger->debug( "resolved {} cards ({} distinct), {} unresolved",
+            cards.size(), firstIndexMap.size(), unresolvedCount );
+    return resolutions;
+}
 
-            if( StringUtil::icompare( nameNormalized, splitCardName ) )
-            {
-                mLogger->debug( "found split name {}", name );
-                return iter;
-            }
+
+const MtgJsonAllSetsData::CardRef*
+MtgJsonAllSetsData::findCardRef( const std::string& name, int setIndex ) const
+{
+    // Look up the card name directly, and also normalize the name in case
+    // it is a split card name.  Normalized names are only matched against
+    // split card names; the best match is the one a linear search would
+    // have found first.
+    const std::pair<const NameIndex*,std::string> lookups[] = {
+        { &mNameIndex,      StringUtil::toLower( name ) },
+        { &mSplitNameIndex, StringUtil::toLower( MtgJson::normalizeSplitCardName( name ) ) } };
+
+    const CardRef* bestRef = nullptr;
+    for( const auto& lookup : lookups )
+    {
+        auto postingsIter = lookup.first->find( lookup.second );
+        if( postingsIter == lookup.first->end() ) continue;
+        const CardPostings& postings = postingsIter->second;
+
+        const CardRef* ref = nullptr;
+        if( setIndex < 0 )
+        {
+            ref = &postings.front();
+        }
+        else
+        {
+            const unsigned int idx = setIndex;
+            auto iter = std::lower_bound( postings.begin(), postings.end(), idx,
+                    []( const CardRef& r, unsigned int i ) { return r.setIndex < i; } );
+            if( (iter == postings.end()) || (iter->setIndex != idx) ) continue;
+            ref = &(*iter);
+        }
+
+        if( (bestRef == nullptr) ||
+            (ref->setIndex < bestRef->setIndex) ||
+            ((ref->setIndex == bestRef->setIndex) && (ref->cardIndex < bestRef->cardIndex)) )
+        {
+            bestRef = ref;
         }
     }
 
-    return last;
+    return bestRef;
+}
+
+
+const MtgJsonCardStore::Set*
+MtgJsonAllSetsData::findSet( const std::string& code ) const
+{
+    auto iter = mSetIndexMap.find( code );
+    return (iter != mSetIndexMap.end()) ? mSearchPrioritizedSets[iter->second] : nullptr;
 }
@@ -3,10 +3,12 @@
 
 #include "AllSetsData.h"
 #include "SimpleCardData.h"
-#include "rapidjson/document.h"
+#include "MtgJsonCardStore.h"
 #include "lrucache.hpp"
 #include <string>
 #include <set>
+#include <map>
+#include <unordered_map>
 #include <vector>
 #include "Logging.h"
 
@@ -26,6 +28,10 @@ public:
 
     bool parse( FILE* fp );
 
+    // Write a precompiled snapshot of the parsed data, tagged with a data
+    // version, for fast loading by SnapshotAllSetsData.
+    bool writeSnapshot( FILE* fp, const std::string& dataVersion ) const;
+
     virtual std::vector<std::string> getSetCodes() const override;
     virtual std::string getSetName( const std::string& code, const std::string& defaultName = "" ) const override;
     virtual std::string getSetGathererCode( const std::string& code, const std::string& defaultVal ="" ) const override;
@@ -40,11 +46,17 @@ public:
 
     virtual CardData* createCardData( int multiverseId ) const override;
 
+    virtual CardData* createCardData( const CardHandle& handle ) const override;
+
     // Given a card name, find a set code for it if possible.  Set codes are prioritized by
     // being an expansion or core set first, then by release date in reverse-chron order.
     // Returns empty string if no set code found.
     virtual std::string findSetCode( const std::string& name ) const;
 
+    // Resolves directly against the name index, bypassing the lookup
+    // caches, with duplicate cards resolved once.
+    virtual std::vector<CardResolution> resolveCards( const std::vector<SimpleCardData>& cards ) const override;
+
     unsigned int getCardLookupCacheHits() const { return mCardLookupLRUCacheHits; }
     unsigned int getCardLookupCacheMisses() const { return mCardLookupLRUCacheMisses; }
 
@@ -53,24 +65,53 @@ public:
 
 private:
 
-    // Cache for card lookup by set and name: [set/name] -> [json card value iterator]
-    using CardLookupLRUCache = cache::lru_cache<SimpleCardData,rapidjson::Value::ConstValueIterator>;
+    // Cache for card lookup by set and name: [set/name] -> [card store index]
+    using CardLookupLRUCache = cache::lru_cache<SimpleCardData,uint32_t>;
 
     // Cache for set code lookup by name: [card name] -> [set code]
     using SetCodeLookupLRUCache = cache::lru_cache<std::string,std::string>;
 
-    // Find a card name given a range of rapidjson value iterators.  Returns
-    // iterator to found element or last if not found.
-    rapidjson::Value::ConstValueIterator findCardValueByName(
-                           rapidjson::Value::ConstValueIterator first,
-                           rapidjson::Value::ConstValueIterator last,
-                           const std::string&                   name ) const;
+    // Reference to a card entry: index into the search-prioritized set
+    // code vector and index of the card in the card store.
+    struct CardRef
+    {
+        unsigned int setIndex;
+        uint32_t     cardIndex;
+    };
+
+    // Card references for a single lookup key, ordered by set search
+    // priority.  Only the first card entry per set is kept.
+    using CardPostings = std::vector<CardRef>;
+    using NameIndex = std::unordered_map<std::string,CardPostings>;
+
+    // Build the multiverse id and name indexes.  Called at the end of parse().
+    void buildIndexes();
 
-    rapidjson::Document mDoc;
+    // Add a card reference to a name index under a case-folded key.
+    static void addNamePosting( NameIndex& index, const std::string& key, const CardRef& ref );
+
+    // Find the best card reference for a name, either by exact
+    // (case-insensitive) card name or, for split cards only, by normalized
+    // split card name.  If
+    // setIndex is non-negative the search is restricted to that set.
+    // Returns nullptr if not found.
+    const CardRef* findCardRef( const std::string& name, int setIndex = -1 ) const;
+
+    // Returns store entry for a set code or nullptr if not found.
+    const MtgJsonCardStore::Set* findSet( const std::string& code ) const;
+
+    MtgJsonCardStore mStore;
     std::set<std::string> mAllSetCodes;
     std::vector<std::string> mSearchPrioritizedAllSetCodes;
     std::set<std::string> mBoosterSetCodes;
 
+    // Indexes built during parse().
+    std::vector<const MtgJsonCardStore::Set*> mSearchPrioritizedSets;
+    std::map<std::string,unsigned int> mSetIndexMap;
+    std::unordered_map<int,CardRef> mMultiverseIdIndex;
+    NameIndex mNameIndex;
+    NameIndex mSplitNameIndex;
+
     mutable CardLookupLRUCache mCardLookupLRUCache;
     mutable unsigned int mCardLookupLRUCacheHits;
     mutable unsigned int mCardLookupLRUCacheMisses;
@@ -0,0 +1,768 @@
+#include "MtgJsonCardStore.h"
+#include "MtgJson.h"
+#include "SimpleCardData.h"
+#include "StringUtil.h"
+
+#include "rapidjson/reader.h"
+#include "rapidjson/filereadstream.h"
+#include "rapidjson/error/en.h"
+
+#include <cctype>
+#include <climits>
+#include <set>
+
+using namespace rapidjson;
+
+//
+// SAX handler that picks the interesting fields out of the AllSets
+// stream.  A context stack tracks where we are in the document; any
+// value that isn't of interest is skipped by depth counting.  Set and
+// card fields are accumulated and committed to the store when their
+// enclosing object ends, applying the same validity rules a DOM-based
+// reader would.
+//
+class MtgJsonCardStore::SaxHandler : public BaseReaderHandler<UTF8<>, SaxHandler>
+{
+public:
+
+    SaxHandler( MtgJsonCardStore& store )
+      : mStore( store ),
+        mSkipDepth( 0 ),
+        mField( FIELD_OTHER )
+    {}
+
+    bool Null()             { return scalar( SCALAR_OTHER ); }
+    bool Bool( bool )       { return scalar( SCALAR_OTHER ); }
+    bool Int( int i )       { mInt = i; return scalar( SCALAR_INT ); }
+    bool Uint( unsigned u )
+    {
+        if( u > INT_MAX ) return scalar( SCALAR_OTHER );
+        mInt = u;
+        return scalar( SCALAR_INT );
+    }
+    bool Int64( int64_t )   { return scalar( SCALAR_OTHER ); }
+    bool Uint64( uint64_t ) { return scalar( SCALAR_OTHER ); }
+    bool Double( double )   { return scalar( SCALAR_OTHER ); }
+    bool String( const char* str, SizeType length, bool )
+    {
+        if( mSkipDepth == 0 ) mStr.assign( str, length );
+        return scalar( SCALAR_STRING );
+    }
+    bool Key( const char* str, SizeType length, bool );
+    bool StartObject()           { return start( true ); }
+    bool EndObject( SizeType )   { return end(); }
+    bool StartArray()            { return start( false ); }
+    bool EndArray( SizeType )    { return end(); }
+
+    bool isRootObject() const { return mRootSeen; }
+
+private:
+
+    enum Context
+    {
+        CONTEXT_ROOT,
+        CONTEXT_SET,
+        CONTEXT_BOOSTER,
+        CONTEXT_BOOSTER_SLOT_ARRAY,
+        CONTEXT_CARDS,
+        CONTEXT_CARD,
+        CONTEXT_CARD_NAMES,
+        CONTEXT_CARD_COLORS,
+        CONTEXT_CARD_TYPES
+    };
+
+    enum Field
+    {
+        FIELD_OTHER,
+
+        // set fields
+        FIELD_SET_NAME,
+        FIELD_SET_TYPE,
+        FIELD_SET_RELEASE_DATE,
+        FIELD_SET_GATHERER_CODE,
+        FIELD_SET_BOOSTER,
+        FIELD_SET_CARDS,
+
+        // card fields
+        FIELD_CARD_NAME,
+        FIELD_CARD_NAMES,
+        FIELD_CARD_LAYOUT,
+        FIELD_CARD_RARITY,
+        FIELD_CARD_MULTIVERSEID,
+        FIELD_CARD_CMC,
+        FIELD_CARD_COLORS,
+        FIELD_CARD_TYPES,
+        FIELD_CARD_NUMBER,
+        FIELD_CARD_VARIATIONS
+    };
+
+    enum ScalarType
+    {
+        SCALAR_STRING,
+        SCALAR_INT,
+        SCALAR_OTHER
+    };
+
+    // Presence and value of an optional field.
+    struct StringField
+    {
+        bool        present;
+        bool        isString;
+        std::string value;
+        void reset() { present = false; isString = false; value.clear(); }
+        void set( ScalarType type, const std::string& str ) { present = true; isString = (type == SCALAR_STRING); if( isString ) value = str; }
+    };
+
+    struct PendingSet
+    {
+        std::string           code;
+        StringField           name;
+        StringField           type;
+        StringField           releaseDate;
+        StringField           gathererCode;
+        bool                  hasBooster;
+        bool                  boosterIsArray;
+        bool                  hasCards;
+        bool                  cardsIsArray;
+        std::vector<SlotType> boosterSlots;
+        std::set<std::string> boosterSlotArray;
+        uint32_t              firstCard;
+    };
+
+    struct PendingCard
+    {
+        StringField              name;
+        StringField              layout;
+        StringField              rarity;
+        StringField              number;
+        bool                     hasNames;
+        bool                     namesIsArray;
+        bool                     firstNameIsString;
+        std::vector<std::string> names;
+        bool                     hasMultiverseId;
+        int                      multiverseId;
+        bool                     hasCMC;
+        int                      cmc;
+        bool                     hasVariations;
+        uint8_t                  colorsMask;
+        uint32_t                 typesMask;
+    };
+
+    bool start( bool isObject );
+    bool end();
+    bool scalar( ScalarType type );
+
+    void beginSet();
+    void endSet();
+    void addBoosterSlot( const std::string& slotStr );
+    void endBoosterSlotArray();
+    void beginCard();
+    void endCard();
+
+    MtgJsonCardStore&    mStore;
+    std::vector<Context> mContexts;
+    unsigned int         mSkipDepth;
+    bool                 mRootSeen = false;
+    Field                mField;
+    std::string          mKey;
+    std::string          mStr;
+    int                  mInt = 0;
+    PendingSet           mSet;
+    PendingCard          mCard;
+};
+
+
+bool
+MtgJsonCardStore::SaxHandler::Key( const char* str, SizeType length, bool )
+{
+    if( mSkipDepth > 0 ) return true;
+
+    const std::string key( str, length );
+    mField = FIELD_OTHER;
+    switch( mContexts.back() )
+    {
+        case CONTEXT_ROOT:
+            mKey = key;
+            break;
+        case CONTEXT_SET:
+            if(      key == "name" )         mField = FIELD_SET_NAME;
+            else if( key == "type" )         mField = FIELD_SET_TYPE;
+            else if( key == "releaseDate" )  mField = FIELD_SET_RELEASE_DATE;
+            else if( key == "gathererCode" ) mField = FIELD_SET_GATHERER_CODE;
+            else if( key == "booster" )      mField = FIELD_SET_BOOSTER;
+            else if( key == "cards" )        mField = FIELD_SET_CARDS;
+            break;
+        case CONTEXT_CARD:
+            if(      key == "name" )         mField = FIELD_CARD_NAME;
+            else if( key == "names" )        mField = FIELD_CARD_NAMES;
+            else if( key == "layout" )       mField = FIELD_CARD_LAYOUT;
+            else if( key == "rarity" )       mField = FIELD_CARD_RARITY;
+            else if( key == "multiverseid" ) mField = FIELD_CARD_MULTIVERSEID;
+            else if( key == "cmc" )          mField = FIELD_CARD_CMC;
+            else if( key == "colors" )       mField = FIELD_CARD_COLORS;
+            else if( key == "types" )        mField = FIELD_CARD_TYPES;
+            else if( key == "number" )       mField = FIELD_CARD_NUMBER;
+            else if( key == "variations" )   mField = FIELD_CARD_VARIATIONS;
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+
+bool
+MtgJsonCardStore::SaxHandler::start( bool isObject )
+{
+    if( mSkipDepth > 0 )
+    {
+        ++mSkipDepth;
+        return true;
+    }
+
+    if( mContexts.empty() )
+    {
+        // The document must be an object of sets.
+        if( !isObject ) return false;
+        mRootSeen = true;
+        mContexts.push_back( CONTEXT_ROOT );
+        return true;
+    }
+
+    Context next = CONTEXT_ROOT;
+    bool descend = false;
+    switch( mContexts.back() )
+    {
+        case CONTEXT_ROOT:
+            if( isObject )
+            {
+                beginSet();
+                next = CONTEXT_SET;
+                descend = true;
+            }
+            else
+            {
+                mStore.mLogger->warn( "set value for {} is not an object", mKey );
+            }
+            break;
+
+        case CONTEXT_SET:
+            switch( mField )
+            {
+                case FIELD_SET_NAME:          mSet.name.set( SCALAR_OTHER, mStr ); break;
+                case FIELD_SET_TYPE:          mSet.type.set( SCALAR_OTHER, mStr ); break;
+                case FIELD_SET_RELEASE_DATE:  mSet.releaseDate.set( SCALAR_OTHER, mStr ); break;
+                case FIELD_SET_GATHERER_CODE: mSet.gathererCode.set( SCALAR_OTHER, mStr ); break;
+                case FIELD_SET_BOOSTER:
+                    mSet.hasBooster = true;
+                    mSet.boosterIsArray = !isObject;
+                    next = CONTEXT_BOOSTER;
+                    descend = !isObject;
+                    break;
+                case FIELD_SET_CARDS:
+                    mSet.hasCards = true;
+                    mSet.cardsIsArray = !isObject;
+                    next = CONTEXT_CARDS;
+                    descend = !isObject;
+                    break;
+                default:
+                    break;
+            }
+            break;
+
+        case CONTEXT_BOOSTER:
+            if( isObject )
+            {
+                mStore.mLogger->warn( "Non-string booster slot type, ignoring!" );
+            }
+            else
+            {
+                mSet.boosterSlotArray.clear();
+                next = CONTEXT_BOOSTER_SLOT_ARRAY;
+                descend = true;
+            }
+            break;
+
+        case CONTEXT_BOOSTER_SLOT_ARRAY:
+            mStore.mLogger->warn( "Non-string in booster slot array, ignoring!" );
+            break;
+
+        case CONTEXT_CARDS:
+            if( isObject )
+            {
+                beginCard();
+                next = CONTEXT_CARD;
+                descend = true;
+            }
+            break;
+
+        case CONTEXT_CARD:
+            switch( mField )
+            {
+                case FIELD_CARD_NAME:         mCard.name.set( SCALAR_OTHER, mStr ); break;
+                case FIELD_CARD_LAYOUT:       mCard.layout.set( SCALAR_OTHER, mStr ); break;
+                case FIELD_CARD_RARITY:       mCard.rarity.set( SCALAR_OTHER, mStr ); break;
+                case FIELD_CARD_NUMBER:       mCard.number.set( SCALAR_OTHER, mStr ); break;
+                case FIELD_CARD_MULTIVERSEID: mCard.hasMultiverseId = false; break;
+                case FIELD_CARD_CMC:          mCard.hasCMC = true; mCard.cmc = -1; break;
+                case FIELD_CARD_VARIATIONS:   mCard.hasVariations = true; break;
+                case FIELD_CARD_NAMES:
+                    mCard.hasNames = true;
+                    mCard.namesIsArray = !isObject;
+                    next = CONTEXT_CARD_NAMES;
+                    descend = !isObject;
+                    break;
+                case FIELD_CARD_COLORS:
+                    next = CONTEXT_CARD_COLORS;
+                    descend = !isObject;
+                    break;
+                case FIELD_CARD_TYPES:
+                    next = CONTEXT_CARD_TYPES;
+                    descend = !isObject;
+                    break;
+                default:
+                    break;
+            }
+            break;
+
+        case CONTEXT_CARD_NAMES:
+            // Non-string name entries still take up a position.
+            if( mCard.names.empty() ) mCard.firstNameIsString = false;
+            mCard.names.push_back( std::string() );
+            break;
+
+        default:
+            break;
+    }
+
+    if( descend )
+    {
+        mContexts.push_back( next );
+    }
+    else
+    {
+        mSkipDepth = 1;
+    }
+    return true;
+}
+
+
+bool
+MtgJsonCardStore::SaxHandler::end()
+{
+    if( mSkipDepth > 0 )
+    {
+        --mSkipDepth;
+        return true;
+    }
+
+    const Context context = mContexts.back();
+    mContexts.pop_back();
+    switch( context )
+    {
+        case CONTEXT_SET:                endSet(); break;
+        case CONTEXT_BOOSTER_SLOT_ARRAY: endBoosterSlotArray(); break;
+        case CONTEXT_CARD:               endCard(); break;
+        default:                         break;
+    }
+
+    // Any key seen before this value is now consumed.
+    mField = FIELD_OTHER;
+    return true;
+}
+
+
+bool
+MtgJsonCardStore::SaxHandler::scalar( ScalarType type )
+{
+    if( mSkipDepth > 0 ) return true;
+
+    // The document must be an object of sets.
+    if( mContexts.empty() ) return false;
+
+    switch( mContexts.back() )
+    {
+        case CONTEXT_ROOT:
+            mStore.mLogger->warn( "set value for {} is not an object", mKey );
+            break;
+
+        case CONTEXT_SET:
+            switch( mField )
+            {
+                case FIELD_SET_NAME:          mSet.name.set( type, mStr ); break;
+                case FIELD_SET_TYPE:          mSet.type.set( type, mStr ); break;
+                case FIELD_SET_RELEASE_DATE:  mSet.releaseDate.set( type, mStr ); break;
+                case FIELD_SET_GATHERER_CODE: mSet.gathererCode.set( type, mStr ); break;
+                case FIELD_SET_BOOSTER:       mSet.hasBooster = true; mSet.boosterIsArray = false; break;
+                case FIELD_SET_CARDS:         mSet.hasCards = true; mSet.cardsIsArray = false; break;
+                default:                      break;
+            }
+            break;
+
+        case CONTEXT_BOOSTER:
+            if( type == SCALAR_STRING )
+            {
+                addBoosterSlot( mStr );
+            }
+            else
+            {
+                mStore.mLogger->warn( "Non-string booster slot type, ignoring!" );
+            }
+            break;
+
+        case CONTEXT_BOOSTER_SLOT_ARRAY:
+            if( type == SCALAR_STRING )
+            {
+                mSet.boosterSlotArray.insert( mStr );
+                mStore.mLogger->debug( "booster slot array: {}", mStr );
+            }
+            else
+            {
+                mStore.mLogger->warn( "Non-string in booster slot array, ignoring!" );
+            }
+            break;
+
+        case CONTEXT_CARD:
+            switch( mField )
+            {
+                case FIELD_CARD_NAME:   mCard.name.set( type, mStr ); break;
+                case FIELD_CARD_LAYOUT: mCard.layout.set( type, mStr ); break;
+                case FIELD_CARD_RARITY: mCard.rarity.set( type, mStr ); break;
+                case FIELD_CARD_NUMBER: mCard.number.set( type, mStr ); break;
+                case FIELD_CARD_NAMES:  mCard.hasNames = true; mCard.namesIsArray = false; break;
+                case FIELD_CARD_VARIATIONS: mCard.hasVariations = true; break;
+                case FIELD_CARD_MULTIVERSEID:
+                    mCard.hasMultiverseId = (type == SCALAR_INT);
+                    mCard.multiverseId = mInt;
+                    break;
+                case FIELD_CARD_CMC:
+                    // MtgJSON docs: "Cards without this field have an implied CMC of zero..."
+                    mCard.hasCMC = true;
+                    mCard.cmc = (type == SCALAR_INT) ? mInt : -1;
+                    break;
+                default:
+                    break;
+            }
+            break;
+
+        case CONTEXT_CARD_NAMES:
+            if( mCard.names.empty() ) mCard.firstNameIsString = (type == SCALAR_STRING);
+            mCard.names.push_back( (type == SCALAR_STRING) ? mStr : std::string() );
+            break;
+
+        case CONTEXT_CARD_COLORS:
+            if( type == SCALAR_STRING )
+            {
+                for( ColorType color : gColorTypeArray )
+                {
+                    if( mStr == stringify( color ) ) mCard.colorsMask |= (1 << color);
+                }
+            }
+            break;
+
+        case CONTEXT_CARD_TYPES:
+            if( type == SCALAR_STRING )
+            {
+                const int bit = mStore.internType( mStr );
+                if( bit >= 0 ) mCard.typesMask |= (1u << bit);
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    mField = FIELD_OTHER;
+    return true;
+}
+
+
+void
+MtgJsonCardStore::SaxHandler::beginSet()
+{
+    mSet.code = mKey;
+    mSet.name.reset();
+    mSet.type.reset();
+    mSet.releaseDate.reset();
+    mSet.gathererCode.reset();
+    mSet.hasBooster = false;
+    mSet.boosterIsArray = false;
+    mSet.hasCards = false;
+    mSet.cardsIsArray = false;
+    mSet.boosterSlots.clear();
+    mSet.firstCard = mStore.getCardCount();
+}
+
+
+void
+MtgJsonCardStore::SaxHandler::endSet()
+{
+    const std::string& setCode = mSet.code;
+    if( !mSet.name.present )
+        mStore.mLogger->warn( "set value for {} has no 'name' member, ignoring set", setCode );
+    else if( !mSet.name.isString )
+        mStore.mLogger->warn( "'name' member for {} is not a string", setCode );
+    else if( !mSet.hasCards )
+        mStore.mLogger->warn( "set value for {} has no 'cards' member, ignoring set", setCode );
+    else if( !mSet.cardsIsArray )
+        mStore.mLogger->warn( "'cards' member for {} is not an array", setCode );
+    else
+    {
+        Set set;
+        set.code = setCode;
+        set.name = mSet.name.value;
+        set.hasGathererCode = mSet.gathererCode.isString;
+        set.gathererCode = mSet.gathererCode.value;
+        set.hasReleaseDate = mSet.releaseDate.isString;
+        set.releaseDate = mSet.releaseDate.value;
+        set.hasType = mSet.type.isString;
+        set.type = mSet.type.value;
+
+        set.hasBooster = mSet.hasBooster && mSet.boosterIsArray;
+        if( !mSet.hasBooster )
+        {
+            // This is expected for some sets so it's not a warning.
+            mStore.mLogger->debug( "set value for {} has no 'booster' member", setCode );
+        }
+        else if( !mSet.boosterIsArray )
+        {
+            mStore.mLogger->warn( "'booster' member for {} is not an array", setCode );
+        }
+        if( set.hasBooster ) set.boosterSlots = mSet.boosterSlots;
+
+        set.firstCard = mSet.firstCard;
+        set.cardCount = mStore.getCardCount() - mSet.firstCard;
+        mStore.mSets.push_back( set );
+        return;
+    }
+
+    // Set is being ignored; drop any cards already stored for it.
+    const uint32_t firstCard = mSet.firstCard;
+    mStore.mNames.resize( firstCard );
+    mStore.mNameKeys.resize( firstCard );
+    mStore.mSplitNameKeys.resize( firstCard );
+    mStore.mMultiverseIds.resize( firstCard );
+    mStore.mCMCs.resize( firstCard );
+    mStore.mRarities.resize( firstCard );
+    mStore.mColorsMasks.resize( firstCard );
+    mStore.mTypesMasks.resize( firstCard );
+    mStore.mFlags.resize( firstCard );
+}
+
+
+void
+MtgJsonCardStore::SaxHandler::addBoosterSlot( const std::string& slotStr )
+{
+    mStore.mLogger->debug( "booster slot string: {}", slotStr );
+    if( slotStr == "common" )
+        mSet.boosterSlots.push_back( SLOT_COMMON );
+    else if( slotStr == "uncommon" )
+        mSet.boosterSlots.push_back( SLOT_UNCOMMON );
+    else if( slotStr == "rare" )
+        mSet.boosterSlots.push_back( SLOT_RARE );
+    else if( slotStr == "timeshifted purple" )
+        mSet.boosterSlots.push_back( SLOT_TIMESHIFTED_PURPLE );
+    else if( slotStr == "land" )      { /* do nothing */ }
+    else if( slotStr == "marketing" ) { /* do nothing */ }
+    else
+        mStore.mLogger->warn( "Unrecognized booster slot type {}, ignoring!", slotStr );
+}
+
+
+void
+MtgJsonCardStore::SaxHandler::endBoosterSlotArray()
+{
+    const std::set<std::string> rareMythicRareSlot { "rare", "mythic rare" };
+    if( mSet.boosterSlotArray == rareMythicRareSlot )
+        mSet.boosterSlots.push_back( SLOT_RARE_OR_MYTHIC_RARE );
+    else
+        mStore.mLogger->warn( "Unrecognized booster slot array, ignoring!" );
+}
+
+
+void
+MtgJsonCardStore::SaxHandler::beginCard()
+{
+    mCard.name.reset();
+    mCard.layout.reset();
+    mCard.rarity.reset();
+    mCard.number.reset();
+    mCard.hasNames = false;
+    mCard.namesIsArray = false;
+    mCard.firstNameIsString = false;
+    mCard.names.clear();
+    mCard.hasMultiverseId = false;
+    mCard.multiverseId = -1;
+    mCard.hasCMC = false;
+    mCard.cmc = 0;
+    mCard.hasVariations = false;
+    mCard.colorsMask = 0;
+    mCard.typesMask = 0;
+}
+
+
+void
+MtgJsonCardStore::SaxHandler::endCard()
+{
+    const bool split = mCard.layout.isString && (mCard.layout.value == "split");
+    const std::string splitName = mCard.namesIsArray ?
+            MtgJson::createSplitCardName( mCard.names ) : std::string();
+
+    const RarityType rarity = mCard.rarity.isString ?
+            MtgJson::getRarityFromString( mCard.rarity.value ) : RARITY_UNKNOWN;
+
+    uint8_t flags = split ? CARD_FLAG_SPLIT : 0;
+
+    // Some cards have multiple entries (i.e. split/flip/double-sided),
+    // so make sure they are only represented once in the card pool.  Done
+    // by skipping over cards whose name doesn't match the first entry of
+    // the 'names' array (if it exists).
+    //
+    // Some cards have variations with multiple entries that should only
+    // be counted once.  Done by checking if there are variations and
+    // checking a card's number for a non-digit, non-'a' ending.
+    if( mCard.name.isString && mCard.rarity.isString )
+    {
+        bool inPool = true;
+        if( mCard.namesIsArray && !mCard.names.empty() &&
+            (!mCard.firstNameIsString || (mCard.name.value != mCard.names[0])) )
+        {
+            inPool = false;
+        }
+        if( mCard.hasVariations && mCard.number.isString && !mCard.number.value.empty() )
+        {
+            const char c = mCard.number.value.back();
+            if( !std::isdigit( c ) && (c != 'a') ) inPool = false;
+        }
+        if( inPool && (rarity == RARITY_UNKNOWN) )
+        {
+            mStore.mLogger->warn( "Unknown rarity type {}, ignoring!", mCard.rarity.value );
+            inPool = false;
+        }
+        if( inPool ) flags |= CARD_FLAG_IN_POOL;
+    }
+    else
+    {
+        mStore.mLogger->notice( "card entry without name or rarity in set {}", mSet.code );
+    }
+
+    const std::string& name = (mCard.hasNames && split) ? splitName : mCard.name.value;
+
+    mStore.mNames.push_back( mStore.internString( name ) );
+    mStore.mNameKeys.push_back( mCard.name.isString ?
+            mStore.internString( StringUtil::toLower( mCard.name.value ) ) : NO_STRING );
+    mStore.mSplitNameKeys.push_back( mCard.hasNames ?
+            mStore.internString( StringUtil::toLower( splitName ) ) : NO_STRING );
+    mStore.mMultiverseIds.push_back( mCard.hasMultiverseId ? mCard.multiverseId : -1 );
+    mStore.mCMCs.push_back( mCard.cmc );
+    mStore.mRarities.push_back( rarity );
+    mStore.mColorsMasks.push_back( mCard.colorsMask );
+    mStore.mTypesMasks.push_back( mCard.typesMask );
+    mStore.mFlags.push_back( flags );
+}
+
+
+MtgJsonCardStore::MtgJsonCardStore( Logging::Config loggingConfig )
+  : mLogger( loggingConfig.createLogger() )
+{}
+
+
+bool
+MtgJsonCardStore::parse( FILE* fp )
+{
+    char readBuffer[65536];
+    FileReadStream is( fp, readBuffer, sizeof(readBuffer) );
+    mLogger->debug( "parsing mtgjson file" );
+
+    SaxHandler handler( *this );
+    Reader reader;
+    ParseResult result = reader.Parse( is, handler );
+
+    if( !handler.isRootObject() )
+    {
+        mLogger->error( "json parsing error: document is not an object" );
+        return false;
+    }
+    if( result.IsError() )
+    {
+        mLogger->error( "json parsing error (offset {}): {}",
+                result.Offset(), GetParseError_En( result.Code() ) );
+        return false;
+    }
+
+    // The interning map is only needed while building.
+    mStringIds.clear();
+    mStringIds.rehash( 0 );
+
+    mLogger->debug( "stored {} sets, {} cards, {} strings",
+            mSets.size(), getCardCount(), mStrings.size() );
+    return true;
+}
+
+
+uint32_t
+MtgJsonCardStore::internString( const std::string& str )
+{
+    auto iter = mStringIds.find( str );
+    if( iter != mStringIds.end() ) return iter->second;
+
+    const uint32_t id = mStrings.size();
+    mStrings.push_back( str );
+    mStringIds.insert( std::make_pair( str, id ) );
+    return id;
+}
+
+
+int
+MtgJsonCardStore::internType( const std::string& type )
+{
+    for( unsigned int i = 0; i < mTypeNames.size(); ++i )
+    {
+        if( mTypeNames[i] == type ) return i;
+    }
+    if( mTypeNames.size() >= MAX_TYPES )
+    {
+        mLogger->warn( "too many card types, ignoring type {}", type );
+        return -1;
+    }
+    mTypeNames.push_back( type );
+    return mTypeNames.size() - 1;
+}
+
+
+std::set<ColorType>
+MtgJsonCardStore::getColors( uint32_t card ) const
+{
+    std::set<ColorType> colors;
+    for( ColorType color : gColorTypeArray )
+    {
+        if( mColorsMasks[card] & (1 << color) ) colors.insert( color );
+    }
+    return colors;
+}
+
+
+std::set<std::string>
+MtgJsonCardStore::getTypes( uint32_t card ) const
+{
+    std::set<std::string> types;
+    for( unsigned int bit = 0; bit < mTypeNames.size(); ++bit )
+    {
+        if( mTypesMasks[card] & (1u << bit) ) types.insert( mTypeNames[bit] );
+    }
+    return types;
+}
+
+
+CardData*
+MtgJsonCardStore::createCardData( uint32_t card, const std::string& setCode ) const
+{
+    return new SimpleCardData( getName( card ),
+                               setCode,
+                               getMultiverseId( card ),
+                               getCMC( card ),
+                               getRarity( card ),
+                               (getFlags( card ) & CARD_FLAG_SPLIT) != 0,
+                               getColors( card ),
+                               getTypes( card ) );
+}
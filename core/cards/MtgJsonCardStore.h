@@ -0,0 +1,120 @@
+#ifndef MTGJSONCARDSTORE_H
+#define MTGJSONCARDSTORE_H
+
+#include "CardDataTypes.h"
+#include "SetDataTypes.h"
+#include "CardData.h"
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "Logging.h"
+
+//
+// Compact columnar store of the MTG JSON fields Thicket uses: set info,
+// booster slots and a handful of card fields.  Built with a single SAX
+// pass over AllSets.json, so the full document is never materialized
+// and everything else in the file (rulings, foreign names, flavor text,
+// legalities, ...) is discarded as it streams by.
+//
+// Card strings are interned.  Rarity and colors are packed into a byte
+// each and types are a bitmask over a small type name table.  Cards are
+// stored contiguously per set, in file order.
+//
+
+class MtgJsonCardStore
+{
+public:
+
+    struct Set
+    {
+        std::string           code;
+        std::string           name;
+        std::string           gathererCode;
+        std::string           releaseDate;
+        std::string           type;
+        bool                  hasGathererCode;
+        bool                  hasReleaseDate;
+        bool                  hasType;
+        bool                  hasBooster;
+        std::vector<SlotType> boosterSlots;
+        uint32_t              firstCard;
+        uint32_t              cardCount;
+    };
+
+    enum CardFlags
+    {
+        CARD_FLAG_SPLIT   = 0x01,
+        CARD_FLAG_IN_POOL = 0x02    // counted once in the set's card pool
+    };
+
+    static const uint32_t NO_STRING = 0xFFFFFFFF;
+
+    // Maximum number of distinct card types (one bit each per card).
+    static const unsigned int MAX_TYPES = 32;
+
+    MtgJsonCardStore( Logging::Config loggingConfig = Logging::Config() );
+
+    bool parse( FILE* fp );
+
+    // Sets in file order.
+    const std::vector<Set>& getSets() const { return mSets; }
+
+    uint32_t getCardCount() const { return mNames.size(); }
+
+    const std::string& getString( uint32_t id ) const { return mStrings[id]; }
+
+    // Display name; split cards use their full split name.
+    const std::string& getName( uint32_t card ) const { return mStrings[mNames[card]]; }
+
+    // Case-folded lookup keys for the card's own name and, for cards with
+    // multiple names, the full split name.  NO_STRING if not present.
+    uint32_t getNameKey( uint32_t card ) const { return mNameKeys[card]; }
+    uint32_t getSplitNameKey( uint32_t card ) const { return mSplitNameKeys[card]; }
+
+    int getMultiverseId( uint32_t card ) const { return mMultiverseIds[card]; }
+    int getCMC( uint32_t card ) const { return mCMCs[card]; }
+    RarityType getRarity( uint32_t card ) const { return static_cast<RarityType>( mRarities[card] ); }
+    uint8_t getColorsMask( uint32_t card ) const { return mColorsMasks[card]; }
+    uint32_t getTypesMask( uint32_t card ) const { return mTypesMasks[card]; }
+    uint8_t getFlags( uint32_t card ) const { return mFlags[card]; }
+
+    const std::vector<std::string>& getTypeNames() const { return mTypeNames; }
+
+    std::set<ColorType> getColors( uint32_t card ) const;
+    std::set<std::string> getTypes( uint32_t card ) const;
+
+    // Caller takes ownership.
+    CardData* createCardData( uint32_t card, const std::string& setCode ) const;
+
+private:
+
+    class SaxHandler;
+
+    uint32_t internString( const std::string& str );
+    int internType( const std::string& type );
+
+    std::vector<Set>                         mSets;
+
+    std::vector<std::string>                 mStrings;
+    std::unordered_map<std::string,uint32_t> mStringIds;
+    std::vector<std::string>                 mTypeNames;
+
+    // Card columns.
+    std::vector<uint32_t>                    mNames;
+    std::vector<uint32_t>                    mNameKeys;
+    std::vector<uint32_t>                    mSplitNameKeys;
+    std::vector<int32_t>                     mMultiverseIds;
+    std::vector<int32_t>                     mCMCs;
+    std::vector<uint8_t>                     mRarities;
+    std::vector<uint8_t>                     mColorsMasks;
+    std::vector<uint32_t>                    mTypesMasks;
+    std::vector<uint8_t>                     mFlags;
+
+    std::shared_ptr<spdlog::logger>          mLogger;
+};
+
+#endif  // MTGJSONCARDSTORE_H
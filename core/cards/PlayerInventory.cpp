@@ -1,6 +1,7 @@
 #include "PlayerInventory.h"
 
 #include <algorithm>
+#include <iterator>
 
 const std::array<PlayerInventory::ZoneType,PlayerInventory::ZONE_TYPE_COUNT>
 PlayerInventory::gZoneTypeArray = { PlayerInventory::ZONE_AUTO,
@@ -23,13 +24,53 @@ stringify( const PlayerInventory::ZoneType& zone )
 }
 
 
+PlayerInventory::PlayerInventory()
+{
+}
+
+
+PlayerInventory::PlayerInventory( const PlayerInventory& other )
+{
+    *this = other;
+}
+
+
+PlayerInventory&
+PlayerInventory::operator=( const PlayerInventory& other )
+{
+    if( this == &other ) return *this;
+
+    for( unsigned int i = 0; i < ZONE_TYPE_COUNT; ++i )
+    {
+        mCardLists[i] = other.mCardLists[i];
+        mBasicLandQtys[i] = other.mBasicLandQtys[i];
+    }
+    buildCardGroups();
+    return *this;
+}
+
+
+void
+PlayerInventory::buildCardGroups()
+{
+    for( unsigned int i = 0; i < ZONE_TYPE_COUNT; ++i )
+    {
+        mCardGroups[i].clear();
+        for( auto iter = mCardLists[i].cbegin(); iter != mCardLists[i].cend(); ++iter )
+        {
+            mCardGroups[i][makeCardKey( **iter )].push_back( iter );
+        }
+    }
+}
+
+
 bool
 PlayerInventory::adjustBasicLand( BasicLandType basic,
                                   ZoneType      zone,
                                   int           adj )
 {
-    if( basic > BASIC_LAND_TYPE_COUNT ) return false;
-    if( zone > ZONE_TYPE_COUNT ) return false;
+    if( basic >= BASIC_LAND_TYPE_COUNT ) return false;
+    if( zone >= ZONE_TYPE_COUNT ) return false;
 
     int origQty = mBasicLandQtys[zone].getQuantity( basic );
     int newQty = origQty + adj;
@@ -45,8 +86,9 @@ bool
 PlayerInventory::add( const std::shared_ptr<CardData>& card,
                       ZoneType                         zone )
 {
-    if( zone > ZONE_TYPE_COUNT ) return false;
-    mCardData[zone].push_back( card );
+    if( zone >= ZONE_TYPE_COUNT ) return false;
+    mCardLists[zone].push_back( card );
+    mCardGroups[zone][makeCardKey( *card )].push_back( std::prev( mCardLists[zone].cend() ) );
     return true;
 }
 
@@ -56,17 +98,30 @@ PlayerInventory::move( const std::shared_ptr<CardData>& card,
                        ZoneType                         zoneFrom,
                        ZoneType                         zoneTo )
 {
-    if( zoneFrom > ZONE_TYPE_COUNT ) return false;
-    if( zoneTo > ZONE_TYPE_COUNT ) return false;
-
-    auto iter = std::find_if( mCardData[zoneFrom].begin(),
-            mCardData[zoneFrom].end(),
-            [&]( const CardDataSharedPtr& c ) { return *c == *card; } );
+    return move( makeCardKey( *card ), zoneFrom, zoneTo );
+}
 
-    if( iter == mCardData[zoneFrom].end() ) return false;
 
-    mCardData[zoneTo].push_back( *iter );
-    mCardData[zoneFrom].erase( iter );
+bool
+PlayerInventory::move( const CardKey& key,
+                       ZoneType       zoneFrom,
+                       ZoneType       zoneTo )
+{
+    if( zoneFrom >= ZONE_TYPE_COUNT ) return false;
+    if( zoneTo >= ZONE_TYPE_COUNT ) return false;
+
+    auto iter = mCardGroups[zoneFrom].find( key );
+    if( iter == mCardGroups[zoneFrom].end() ) return false;
+
+    // Move the oldest copy.  Splicing keeps the list node, so the
+    // iterator stays valid in its new zone.  Within a zone this moves the
+    // card to the end and its group entry to the back.
+    std::deque<CardList::const_iterator>& fromCards = iter->second;
+    CardList::const_iterator cardIter = fromCards.front();
+    mCardLists[zoneTo].splice( mCardLists[zoneTo].cend(), mCardLists[zoneFrom], cardIter );
+    mCardGroups[zoneTo][key].push_back( cardIter );
+    fromCards.pop_front();
+    if( fromCards.empty() ) mCardGroups[zoneFrom].erase( iter );
 
     return true;
 }
@@ -78,7 +133,7 @@ PlayerInventory::size() const
     unsigned int sum = 0;
     for( unsigned int i = 0; i < ZONE_TYPE_COUNT; ++i )
     {
-        sum += mCardData[i].size();
+        sum += mCardLists[i].size();
         sum += mBasicLandQtys[i].getTotalQuantity();
     }
     return sum;
@@ -88,24 +143,42 @@ PlayerInventory::size() const
 unsigned int
 PlayerInventory::size( ZoneType zone ) const
 {
-    if( zone > ZONE_TYPE_COUNT ) return false;
-    return mCardData[zone].size() + mBasicLandQtys[zone].getTotalQuantity();
+    if( zone >= ZONE_TYPE_COUNT ) return 0;
+    return mCardLists[zone].size() + mBasicLandQtys[zone].getTotalQuantity();
 }
 
 
 BasicLandQuantities
 PlayerInventory::getBasicLandQuantities( ZoneType zone ) const
 {
-    if( zone > ZONE_TYPE_COUNT ) return BasicLandQuantities();
+    if( zone >= ZONE_TYPE_COUNT ) return BasicLandQuantities();
     return mBasicLandQtys[zone];
 }
 
 
+const PlayerInventory::CardList&
+PlayerInventory::getCardList( ZoneType zone ) const
+{
+    static const CardList emptyCardList;
+    if( zone >= ZONE_TYPE_COUNT ) return emptyCardList;
+    return mCardLists[zone];
+}
+
+
+const PlayerInventory::CardGroups&
+PlayerInventory::getCardGroups( ZoneType zone ) const
+{
+    static const CardGroups emptyCardGroups;
+    if( zone >= ZONE_TYPE_COUNT ) return emptyCardGroups;
+    return mCardGroups[zone];
+}
+
+
 std::vector<PlayerInventory::CardDataSharedPtr>
 PlayerInventory::getCards( ZoneType zone ) const
 {
-    if( zone > ZONE_TYPE_COUNT ) return std::vector<CardDataSharedPtr>();
-    return mCardData[zone];
+    if( zone >= ZONE_TYPE_COUNT ) return std::vector<CardDataSharedPtr>();
+    return std::vector<CardDataSharedPtr>( mCardLists[zone].begin(), mCardLists[zone].end() );
 }
 
 
@@ -114,7 +187,8 @@ PlayerInventory::clear()
 {
     for( unsigned int i = 0; i < ZONE_TYPE_COUNT; ++i )
     {
-        mCardData[i].clear();
+        mCardLists[i].clear();
+        mCardGroups[i].clear();
         mBasicLandQtys[i].clear();
     }
 }
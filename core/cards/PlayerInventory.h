@@ -1,17 +1,43 @@
 #ifndef PLAYERINVENTORY_H
 #define PLAYERINVENTORY_H
 
+#include <array>
+#include <deque>
+#include <list>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include "CardData.h"
 #include "BasicLandQuantities.h"
 
+// Cards and basic lands held by a player, by zone.
+//
+// Each zone keeps its cards in the order they arrived in the zone, and
+// indexes them by (set code, name), so finding and moving a card takes
+// constant time regardless of how many cards are in the zone.
 class PlayerInventory
 {
 public:
 
     typedef std::shared_ptr<CardData> CardDataSharedPtr;
 
+    // Cards in a zone in arrival order.  Card objects keep their identity
+    // as they move between zones.
+    typedef std::list<CardDataSharedPtr> CardList;
+
+    // All copies of a card in a zone, oldest first, keyed by (set code, name).
+    typedef std::pair<std::string,std::string> CardKey;
+    struct CardKeyHash
+    {
+        std::size_t operator()( const CardKey& key ) const
+        {
+            return std::hash<std::string>()( key.first ) ^ (std::hash<std::string>()( key.second ) << 1);
+        }
+    };
+    typedef std::unordered_map<CardKey,std::deque<CardList::const_iterator>,CardKeyHash> CardGroups;
+
     enum ZoneType
     {
         ZONE_AUTO,
@@ -23,16 +49,34 @@ public:
     const static unsigned int ZONE_TYPE_COUNT = 4;
     const static std::array<ZoneType,PlayerInventory::ZONE_TYPE_COUNT> gZoneTypeArray;
 
+    PlayerInventory();
+
+    // Copies share card objects with the original.  The card groups refer
+    // into the zone lists, so they're rebuilt for the copy.
+    PlayerInventory( const PlayerInventory& other );
+    PlayerInventory& operator=( const PlayerInventory& other );
+
     // Adjust basic land quantities.
     bool adjustBasicLand( BasicLandType basic, ZoneType zone, int adj = 1 );
 
     // Add a card.
     bool add( const std::shared_ptr<CardData>& card, ZoneType zone );
 
-    // Move a card.
+    // Move a card.  The oldest copy in the source zone moves to the end of
+    // the destination zone, even if that's the same zone.
     bool move( const std::shared_ptr<CardData>& card, ZoneType zoneFrom, ZoneType zoneTo );
+    bool move( const CardKey& cardKey, ZoneType zoneFrom, ZoneType zoneTo );
 
     BasicLandQuantities getBasicLandQuantities( ZoneType zone ) const;
+
+    // Cards in a zone in arrival order.
+    const CardList& getCardList( ZoneType zone ) const;
+
+    // Cards in a zone, grouped by card.  Valid until the inventory is
+    // next modified.
+    const CardGroups& getCardGroups( ZoneType zone ) const;
+
+    // Copy of all cards in a zone, in arrival order.
     std::vector<CardDataSharedPtr> getCards( ZoneType zone ) const;
 
     unsigned int size() const;
@@ -42,7 +86,16 @@ public:
 
 private:
 
-    std::vector<CardDataSharedPtr> mCardData[ZONE_TYPE_COUNT];
+    static CardKey makeCardKey( const CardData& card )
+    {
+        return CardKey( card.getSetCode(), card.getName() );
+    }
+
+    // Index the cards in the zone lists.
+    void buildCardGroups();
+
+    CardList            mCardLists[ZONE_TYPE_COUNT];
+    CardGroups          mCardGroups[ZONE_TYPE_COUNT];
     BasicLandQuantities mBasicLandQtys[ZONE_TYPE_COUNT];
 
 };
@@ -13,7 +13,26 @@ public:
         mSetCode( setCode ),
         mMultiverseId( -1 ),
         mCMC( -1 ),
-        mRarity( RARITY_UNKNOWN )
+        mRarity( RARITY_UNKNOWN ),
+        mSplit( false )
+    {}
+
+    SimpleCardData( const std::string&           name,
+                    const std::string&           setCode,
+                    int                          multiverseId,
+                    int                          cmc,
+                    RarityType                   rarity,
+                    bool                         split,
+                    const std::set<ColorType>&   colors,
+                    const std::set<std::string>& types )
+      : mName( name ),
+        mSetCode( setCode ),
+        mMultiverseId( multiverseId ),
+        mCMC( cmc ),
+        mRarity( rarity ),
+        mSplit( split ),
+        mColors( colors ),
+        mTypes( types )
     {}
 
     virtual std::string getName() const override { return mName; }
@@ -21,9 +40,9 @@ public:
     virtual int getMultiverseId() const override { return mMultiverseId; }
     virtual int getCMC() const override { return mCMC; }
     virtual RarityType getRarity() const override { return mRarity; }
-    virtual bool isSplit() const override { return false; };
-    virtual std::set<ColorType> getColors() const override { return std::set<ColorType>(); } // empty set
-    virtual std::set<std::string> getTypes() const override { return std::set<std::string>(); } // empty set
+    virtual bool isSplit() const override { return mSplit; };
+    virtual std::set<ColorType> getColors() const override { return mColors; }
+    virtual std::set<std::string> getTypes() const override { return mTypes; }
 
 private:
     std::string mName;
@@ -31,6 +50,9 @@ private:
     int mMultiverseId;
     int mCMC;
     RarityType mRarity;
+    bool mSplit;
+    std::set<ColorType> mColors;
+    std::set<std::string> mTypes;
 };
 
 namespace std {
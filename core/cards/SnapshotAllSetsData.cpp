@@ -0,0 +1,499 @@
+#include "SnapshotAllSetsData.h"
+#include "SimpleCardData.h"
+#include "MtgJson.h"
+#include "StringUtil.h"
+
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+
+using namespace AllSetsSnapshot;
+
+SnapshotAllSetsData::SnapshotAllSetsData( Logging::Config loggingConfig )
+  : mHeader( nullptr ),
+    mStrings( nullptr ),
+    mTypes( nullptr ),
+    mSets( nullptr ),
+    mSlots( nullptr ),
+    mCards( nullptr ),
+    mNameKeys( nullptr ),
+    mPostings( nullptr ),
+    mNameHash( nullptr ),
+    mMuidHash( nullptr ),
+    mLogger( loggingConfig.createLogger() )
+{}
+
+
+bool
+SnapshotAllSetsData::load( const std::string& filePath, const std::string& dataVersion )
+{
+    mHeader = nullptr;
+
+    mLogger->debug( "mapping snapshot file {}", filePath );
+    if( !mFile.open( filePath ) )
+    {
+        mLogger->notice( "unable to map snapshot file {}", filePath );
+        return false;
+    }
+
+    if( !validate() )
+    {
+        mFile.close();
+        return false;
+    }
+
+    mHeader   = reinterpret_cast<const Header*>( mFile.getData() );
+    mStrings  = getSection<char>( mHeader->strings );
+    mTypes    = getSection<StringRef>( mHeader->types );
+    mSets     = getSection<SetRecord>( mHeader->sets );
+    mSlots    = getSection<uint32_t>( mHeader->slots );
+    mCards    = getSection<CardRecord>( mHeader->cards );
+    mNameKeys = getSection<NameKeyRecord>( mHeader->nameKeys );
+    mPostings = getSection<PostingRecord>( mHeader->postings );
+    mNameHash = getSection<uint32_t>( mHeader->nameHash );
+    mMuidHash = getSection<MuidRecord>( mHeader->muidHash );
+
+    if( !dataVersion.empty() && (getDataVersion() != dataVersion) )
+    {
+        mLogger->notice( "snapshot data version {} does not match {}", getDataVersion(), dataVersion );
+        mHeader = nullptr;
+        mFile.close();
+        return false;
+    }
+
+    mLogger->debug( "loaded snapshot: version {}, {} sets, {} cards",
+            getDataVersion(), mHeader->sets.count, mHeader->cards.count );
+    return true;
+}
+
+
+bool
+SnapshotAllSetsData::validate() const
+{
+    const size_t fileSize = mFile.getSize();
+    if( fileSize < sizeof(Header) )
+    {
+        mLogger->warn( "snapshot file too small" );
+        return false;
+    }
+
+    const Header* header = reinterpret_cast<const Header*>( mFile.getData() );
+    if( std::memcmp( header->magic, MAGIC, sizeof(header->magic) ) != 0 )
+    {
+        mLogger->warn( "snapshot file has bad magic" );
+        return false;
+    }
+    if( header->formatVersion != FORMAT_VERSION )
+    {
+        mLogger->notice( "snapshot format version {} not supported", header->formatVersion );
+        return false;
+    }
+    if( header->endianCheck != ENDIAN_CHECK )
+    {
+        mLogger->notice( "snapshot written with different byte order" );
+        return false;
+    }
+
+    // Every section must be aligned and fit inside the file.
+    auto sectionOk = [fileSize]( const Section& section, size_t recordSize ) {
+        return ((section.offset % 8) == 0) &&
+               (uint64_t(section.offset) + uint64_t(section.count) * recordSize <= fileSize);
+    };
+    if( !sectionOk( header->strings,       1 ) ||
+        !sectionOk( header->types,         sizeof(StringRef) ) ||
+        !sectionOk( header->sets,          sizeof(SetRecord) ) ||
+        !sectionOk( header->setPriorities, sizeof(uint32_t) ) ||
+        !sectionOk( header->slots,         sizeof(uint32_t) ) ||
+        !sectionOk( header->cards,         sizeof(CardRecord) ) ||
+        !sectionOk( header->nameKeys,      sizeof(NameKeyRecord) ) ||
+        !sectionOk( header->postings,      sizeof(PostingRecord) ) ||
+        !sectionOk( header->nameHash,      sizeof(uint32_t) ) ||
+        !sectionOk( header->muidHash,      sizeof(MuidRecord) ) )
+    {
+        mLogger->warn( "snapshot file has bad section table" );
+        return false;
+    }
+
+    if( header->types.count > MAX_TYPES )
+    {
+        mLogger->warn( "snapshot file has too many types" );
+        return false;
+    }
+
+    // Hash tables must be non-empty powers of two.
+    const uint32_t nameHashSize = header->nameHash.count;
+    const uint32_t muidHashSize = header->muidHash.count;
+    if( (nameHashSize == 0) || ((nameHashSize & (nameHashSize - 1)) != 0) ||
+        (muidHashSize == 0) || ((muidHashSize & (muidHashSize - 1)) != 0) )
+    {
+        mLogger->warn( "snapshot file has bad hash tables" );
+        return false;
+    }
+
+    // Set records are few; check their ranges up front.  Card and
+    // posting ranges are checked as they are used.
+    const SetRecord* sets = reinterpret_cast<const SetRecord*>( mFile.getData() + header->sets.offset );
+    for( uint32_t i = 0; i < header->sets.count; ++i )
+    {
+        if( (uint64_t(sets[i].firstCard) + sets[i].cardCount > header->cards.count) ||
+            (uint64_t(sets[i].firstSlot) + sets[i].slotCount > header->slots.count) )
+        {
+            mLogger->warn( "snapshot file has bad set record" );
+            return false;
+        }
+    }
+    const uint32_t* setPriorities = reinterpret_cast<const uint32_t*>(
+            mFile.getData() + header->setPriorities.offset );
+    for( uint32_t i = 0; i < header->setPriorities.count; ++i )
+    {
+        if( setPriorities[i] >= header->sets.count )
+        {
+            mLogger->warn( "snapshot file has bad set priority" );
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+std::string
+SnapshotAllSetsData::getDataVersion() const
+{
+    return mHeader ? getString( mHeader->dataVersion ) : std::string();
+}
+
+
+std::string
+SnapshotAllSetsData::getString( const StringRef& ref ) const
+{
+    if( uint64_t(ref.offset) + ref.length > mHeader->strings.count ) return std::string();
+    return std::string( mStrings + ref.offset, ref.length );
+}
+
+
+const SetRecord*
+SnapshotAllSetsData::findSet( const std::string& code ) const
+{
+    if( !mHeader ) return nullptr;
+
+    // Set records are sorted by code.
+    const SetRecord* first = mSets;
+    const SetRecord* last = mSets + mHeader->sets.count;
+    const SetRecord* iter = std::lower_bound( first, last, code,
+            [this]( const SetRecord& set, const std::string& c ) { return getString( set.code ) < c; } );
+    if( (iter != last) && (getString( iter->code ) == code) ) return iter;
+    return nullptr;
+}
+
+
+std::vector<std::string>
+SnapshotAllSetsData::getSetCodes() const
+{
+    std::vector<std::string> setCodes;
+    if( !mHeader ) return setCodes;
+
+    setCodes.reserve( mHeader->sets.count );
+    for( uint32_t i = 0; i < mHeader->sets.count; ++i )
+    {
+        setCodes.push_back( getString( mSets[i].code ) );
+    }
+    return setCodes;
+}
+
+
+std::string
+SnapshotAllSetsData::getSetName( const std::string& code, const std::string& defaultName ) const
+{
+    const SetRecord* set = findSet( code );
+    if( set == nullptr )
+    {
+        mLogger->warn( "Unable to find set {}, returning default name", code );
+        return defaultName;
+    }
+    return getString( set->name );
+}
+
+
+std::string
+SnapshotAllSetsData::getSetGathererCode( const std::string& code, const std::string& defaultVal ) const
+{
+    const SetRecord* set = findSet( code );
+    if( set == nullptr )
+    {
+        mLogger->warn( "Unable to find set {}, returning default gatherer code", code );
+        return defaultVal;
+    }
+    if( (set->flags & SET_FLAG_GATHERER_CODE) == 0 )
+    {
+        mLogger->debug( "Unable to find gatherer code for set {}, returning default gatherer code", code );
+        return defaultVal;
+    }
+    return getString( set->gathererCode );
+}
+
+
+bool
+SnapshotAllSetsData::hasBoosterSlots( const std::string& code ) const
+{
+    const SetRecord* set = findSet( code );
+    return (set != nullptr) && ((set->flags & SET_FLAG_BOOSTER) != 0);
+}
+
+
+std::vector<SlotType>
+SnapshotAllSetsData::getBoosterSlots( const std::string& code ) const
+{
+    std::vector<SlotType> boosterSlots;
+
+    const SetRecord* set = findSet( code );
+    if( (set == nullptr) || ((set->flags & SET_FLAG_BOOSTER) == 0) )
+    {
+        mLogger->warn( "No booster member in set {}, returning empty booster slots", code );
+        return boosterSlots;
+    }
+
+    boosterSlots.reserve( set->slotCount );
+    for( uint32_t i = 0; i < set->slotCount; ++i )
+    {
+        boosterSlots.push_back( static_cast<SlotType>( mSlots[set->firstSlot + i] ) );
+    }
+    return boosterSlots;
+}
+
+
+std::multimap<RarityType,std::string>
+SnapshotAllSetsData::getCardPool( const std::string& code ) const
+{
+    std::multimap<RarityType,std::string> rarityMap;
+
+    const SetRecord* set = findSet( code );
+    if( set == nullptr )
+    {
+        mLogger->warn( "Unable to find set {}, returning empty card pool", code );
+        return rarityMap;
+    }
+
+    for( uint32_t i = 0; i < set->cardCount; ++i )
+    {
+        const CardRecord& card = mCards[set->firstCard + i];
+        if( card.flags & CARD_FLAG_IN_POOL )
+        {
+            rarityMap.insert( std::make_pair( static_cast<RarityType>( card.rarity ),
+                                              getString( card.name ) ) );
+        }
+    }
+    return rarityMap;
+}
+
+
+CardData*
+SnapshotAllSetsData::createCardData( const std::string& code, const std::string& name ) const
+{
+    const SetRecord* set = findSet( code );
+    if( set == nullptr )
+    {
+        mLogger->warn( "Unable to find set {}", code );
+        return nullptr;
+    }
+
+    const PostingRecord* posting = findPosting( name, set );
+    if( posting == nullptr )
+    {
+        mLogger->debug( "unable to find card name {}", name );
+        return nullptr;
+    }
+
+    return createCardData( posting->setIndex, posting->cardIndex );
+}
+
+
+CardData*
+SnapshotAllSetsData::createCardData( int multiverseId ) const
+{
+    if( mHeader )
+    {
+        const uint32_t mask = mHeader->muidHash.count - 1;
+        uint32_t slot = hashMultiverseId( multiverseId ) & mask;
+        for( uint32_t probes = 0; probes <= mask; ++probes )
+        {
+            const MuidRecord& record = mMuidHash[slot];
+            if( record.cardIndex == EMPTY_CARD_INDEX ) break;
+            if( (record.multiverseId == multiverseId) && (record.cardIndex < mHeader->cards.count) )
+            {
+                // Locate the owning set; set records are ordered by card index.
+                const SetRecord* last = mSets + mHeader->sets.count;
+                const SetRecord* set = std::upper_bound( mSets, last, record.cardIndex,
+                        []( uint32_t c, const SetRecord& s ) { return c < s.firstCard; } );
+                if( set != mSets )
+                {
+                    return createCardData( (set - 1) - mSets, record.cardIndex );
+                }
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    mLogger->warn( "unable to find card multiverseId {}", multiverseId );
+    return nullptr;
+}
+
+
+CardData*
+SnapshotAllSetsData::createCardData( const CardHandle& handle ) const
+{
+    if( !mHeader || (handle.setIndex >= mHeader->sets.count) || (handle.cardIndex >= mHeader->cards.count) )
+    {
+        return nullptr;
+    }
+    return createCardData( handle.setIndex, handle.cardIndex );
+}
+
+
+std::string
+SnapshotAllSetsData::findSetCode( const std::string& name ) const
+{
+    const PostingRecord* posting = findPosting( name );
+    return posting ? getString( mSets[posting->setIndex].code ) : std::string();
+}
+
+
+std::vector<AllSetsData::CardResolution>
+SnapshotAllSetsData::resolveCards( const std::vector<SimpleCardData>& cards ) const
+{
+    std::vector<CardResolution> resolutions( cards.size() );
+    unsigned int unresolvedCount = 0;
+
+    // Lists repeat cards (often heavily in packs), so each distinct card
+    // is looked up once.
+    std::unordered_map<SimpleCardData,std::size_t> firstIndexMap;
+    firstIndexMap.reserve( cards.size() );
+    for( std::size_t i = 0; i < cards.size(); ++i )
+    {
+        auto firstIndexResult = firstIndexMap.insert( std::make_pair( cards[i], i ) );
+        if( !firstIndexResult.second )
+        {
+            resolutions[i] = resolutions[firstIndexResult.first->second];
+            if( !resolutions[i].isResolved() ) unresolvedCount++;
+            continue;
+        }
+
+        const std::string name = cards[i].getName();
+        const SetRecord* set = findSet( cards[i].getSetCode() );
+        const PostingRecord* posting = (set != nullptr) ? findPosting( name, set ) : nullptr;
+        if( posting == nullptr ) posting = findPosting( name );
+
+        if( posting != nullptr )
+        {
+            resolutions[i].handle = CardHandle( posting->setIndex, posting->cardIndex );
+            resolutions[i].setCode = getString( mSets[posting->setIndex].code );
+        }
+        else
+        {
+            unresolvedCount++;
+        }
+    }
+
+    mLogger->debug( "resolved {} cards ({} distinct), {} unresolved",
+            cards.size(), firstIndexMap.size(), unresolvedCount );
+    return resolutions;
+}
+
+
+const NameKeyRecord*
+SnapshotAllSetsData::findNameKey( const std::string& key, uint32_t flags ) const
+{
+    if( !mHeader ) return nullptr;
+
+    const uint32_t mask = mHeader->nameHash.count - 1;
+    uint32_t slot = hashName( key.data(), key.size() ) & mask;
+    for( uint32_t probes = 0; probes <= mask; ++probes )
+    {
+        const uint32_t entry = mNameHash[slot];
+        if( entry == 0 ) break;
+        if( entry <= mHeader->nameKeys.count )
+        {
+            const NameKeyRecord& nameKey = mNameKeys[entry - 1];
+            if( (nameKey.flags == flags) &&
+                (nameKey.key.length == key.size()) &&
+                (uint64_t(nameKey.key.offset) + nameKey.key.length <= mHeader->strings.count) &&
+                (std::memcmp( mStrings + nameKey.key.offset, key.data(), key.size() ) == 0) )
+            {
+                return &nameKey;
+            }
+        }
+        slot = (slot + 1) & mask;
+    }
+    return nullptr;
+}
+
+
+const PostingRecord*
+SnapshotAllSetsData::findPosting( const std::string& name, const SetRecord* set ) const
+{
+    // Same lookup rules as MtgJsonAllSetsData: direct name against card
+    // names and normalized name against split names, best match by set
+    // priority and then card order.
+    const std::pair<uint32_t,std::string> lookups[] = {
+        { 0,                   StringUtil::toLower( name ) },
+        { NAME_KEY_FLAG_SPLIT, StringUtil::toLower( MtgJson::normalizeSplitCardName( name ) ) } };
+
+    const PostingRecord* bestPosting = nullptr;
+    for( const auto& lookup : lookups )
+    {
+        const NameKeyRecord* nameKey = findNameKey( lookup.second, lookup.first );
+        if( nameKey == nullptr ) continue;
+        if( uint64_t(nameKey->firstPosting) + nameKey->postingCount > mHeader->postings.count ) continue;
+
+        for( uint32_t i = 0; i < nameKey->postingCount; ++i )
+        {
+            const PostingRecord* posting = &mPostings[nameKey->firstPosting + i];
+            if( (posting->setIndex >= mHeader->sets.count) ||
+                (posting->cardIndex >= mHeader->cards.count) ) continue;
+            if( (set != nullptr) && (&mSets[posting->setIndex] != set) ) continue;
+
+            const uint32_t priority = mSets[posting->setIndex].priority;
+            if( (bestPosting == nullptr) ||
+                (priority < mSets[bestPosting->setIndex].priority) ||
+                ((priority == mSets[bestPosting->setIndex].priority) &&
+                 (posting->cardIndex < bestPosting->cardIndex)) )
+            {
+                bestPosting = posting;
+            }
+
+            // Postings are in priority order, so the first usable one is
+            // the best for this key.
+            break;
+        }
+    }
+    return bestPosting;
+}
+
+
+CardData*
+SnapshotAllSetsData::createCardData( uint32_t setIndex, uint32_t cardIndex ) const
+{
+    const CardRecord& card = mCards[cardIndex];
+
+    std::set<ColorType> colors;
+    for( ColorType color : gColorTypeArray )
+    {
+        if( card.colorsMask & (1 << color) ) colors.insert( color );
+    }
+
+    std::set<std::string> types;
+    for( uint32_t bit = 0; bit < mHeader->types.count; ++bit )
+    {
+        if( card.typesMask & (1u << bit) ) types.insert( getString( mTypes[bit] ) );
+    }
+
+    return new SimpleCardData( getString( card.name ),
+                               getString( mSets[setIndex].code ),
+                               card.multiverseId,
+                               card.cmc,
+                               static_cast<RarityType>( card.rarity ),
+                               (card.flags & CARD_FLAG_SPLIT) != 0,
+                               colors,
+                               types );
+}
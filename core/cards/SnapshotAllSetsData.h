@@ -0,0 +1,79 @@
+#ifndef SNAPSHOTALLSETSDATA_H
+#define SNAPSHOTALLSETSDATA_H
+
+#include "AllSetsData.h"
+#include "AllSetsSnapshot.h"
+#include "MappedFile.h"
+#include <string>
+#include <vector>
+#include "Logging.h"
+
+// AllSetsData backed by a memory-mapped snapshot file written by
+// MtgJsonAllSetsData::writeSnapshot().  Loading does no parsing; all
+// lookups go directly against the records and indexes in the mapping.
+class SnapshotAllSetsData : public AllSetsData
+{
+public:
+
+    SnapshotAllSetsData( Logging::Config loggingConfig = Logging::Config() );
+
+    virtual ~SnapshotAllSetsData() {}
+
+    // Map and validate a snapshot file.  If dataVersion is non-empty the
+    // snapshot must have been written for that data version.
+    bool load( const std::string& filePath, const std::string& dataVersion = std::string() );
+
+    std::string getDataVersion() const;
+
+    virtual std::vector<std::string> getSetCodes() const override;
+    virtual std::string getSetName( const std::string& code, const std::string& defaultName = "" ) const override;
+    virtual std::string getSetGathererCode( const std::string& code, const std::string& defaultVal ="" ) const override;
+    virtual bool hasBoosterSlots( const std::string& code ) const override;
+    virtual std::vector<SlotType> getBoosterSlots( const std::string& code ) const override;
+    virtual std::multimap<RarityType,std::string> getCardPool( const std::string& code ) const override;
+    virtual CardData* createCardData( const std::string& code, const std::string& name ) const override;
+    virtual CardData* createCardData( int multiverseId ) const override;
+    virtual CardData* createCardData( const CardHandle& handle ) const override;
+    virtual std::string findSetCode( const std::string& name ) const override;
+    virtual std::vector<CardResolution> resolveCards( const std::vector<SimpleCardData>& cards ) const override;
+
+private:
+
+    bool validate() const;
+
+    std::string getString( const AllSetsSnapshot::StringRef& ref ) const;
+
+    // Returns set record for a code or nullptr if not found.
+    const AllSetsSnapshot::SetRecord* findSet( const std::string& code ) const;
+
+    // Find the best posting for a name, either by exact (case-insensitive)
+    // name or by normalized split card name.  If set is non-null the search
+    // is restricted to that set.  Returns nullptr if not found.
+    const AllSetsSnapshot::PostingRecord* findPosting( const std::string&                name,
+                                                       const AllSetsSnapshot::SetRecord* set = nullptr ) const;
+
+    const AllSetsSnapshot::NameKeyRecord* findNameKey( const std::string& key, uint32_t flags ) const;
+
+    CardData* createCardData( uint32_t setIndex, uint32_t cardIndex ) const;
+
+    template<typename T> const T* getSection( const AllSetsSnapshot::Section& section ) const
+    {
+        return reinterpret_cast<const T*>( mFile.getData() + section.offset );
+    }
+
+    MappedFile                              mFile;
+    const AllSetsSnapshot::Header*          mHeader;
+    const char*                             mStrings;
+    const AllSetsSnapshot::StringRef*       mTypes;
+    const AllSetsSnapshot::SetRecord*       mSets;
+    const uint32_t*                         mSlots;
+    const AllSetsSnapshot::CardRecord*      mCards;
+    const AllSetsSnapshot::NameKeyRecord*   mNameKeys;
+    const AllSetsSnapshot::PostingRecord*   mPostings;
+    const uint32_t*                         mNameHash;
+    const AllSetsSnapshot::MuidRecord*      mMuidHash;
+
+    std::shared_ptr<spdlog::logger> mLogger;
+};
+
+#endif  // SNAPSHOTALLSETSDATA_H
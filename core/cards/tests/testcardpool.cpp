@@ -189,3 +189,135 @@ CATCH_TEST_CASE( "Cardpool tests", "[cardpool]" )
 
 }
 
+
+// Always picks the lowest value in range.
+class MinRandGen : public RandGen
+{
+public:
+    virtual int generateInRange( int min, int max ) override { return min; }
+    virtual float generateCanonical() override { return 0.0f; }
+};
+
+
+// Minimal set data that counts card pool requests.
+class CountingAllSetsData : public AllSetsData
+{
+public:
+    CountingAllSetsData() : cardPoolRequests( 0 ) {}
+    virtual std::vector<std::string> getSetCodes() const override { return { "AAA" }; }
+    virtual std::string getSetName( const std::string& code, const std::string& defaultName = "" ) const override { return defaultName; }
+    virtual std::string getSetGathererCode( const std::string& code, const std::string& defaultVal = "" ) const override { return defaultVal; }
+    virtual bool hasBoosterSlots( const std::string& code ) const override { return code == "AAA"; }
+    virtual std::vector<SlotType> getBoosterSlots( const std::string& code ) const override
+    {
+        if( code != "AAA" ) return std::vector<SlotType>();
+        return { SLOT_RARE_OR_MYTHIC_RARE, SLOT_UNCOMMON, SLOT_COMMON, SLOT_COMMON };
+    }
+    virtual std::multimap<RarityType,std::string> getCardPool( const std::string& code ) const override
+    {
+        cardPoolRequests++;
+        std::multimap<RarityType,std::string> pool;
+        if( code != "AAA" ) return pool;
+        pool.insert( std::make_pair( RARITY_COMMON, "C1" ) );
+        pool.insert( std::make_pair( RARITY_COMMON, "C2" ) );
+        pool.insert( std::make_pair( RARITY_UNCOMMON, "U1" ) );
+        pool.insert( std::make_pair( RARITY_RARE, "R1" ) );
+        pool.insert( std::make_pair( RARITY_MYTHIC_RARE, "M1" ) );
+        return pool;
+    }
+    virtual CardData* createCardData( const std::string& code, const std::string& name ) const override { return nullptr; }
+    virtual CardData* createCardData( int multiverseId ) const override { return nullptr; }
+    virtual CardData* createCardData( const CardHandle& handle ) const override { return nullptr; }
+    virtual std::string findSetCode( const std::string& name ) const override { return std::string(); }
+    virtual std::vector<CardResolution> resolveCards( const std::vector<SimpleCardData>& cards ) const override
+    {
+        return std::vector<CardResolution>( cards.size() );
+    }
+
+    mutable int cardPoolRequests;
+};
+
+
+CATCH_TEST_CASE( "Booster templates", "[cardpool]" )
+{
+    auto allSetsData = std::make_shared<CountingAllSetsData>();
+    BoosterTemplateCache cache( allSetsData );
+
+    CATCH_SECTION( "Built once and shared" )
+    {
+        auto t1 = cache.getBoosterTemplate( "AAA" );
+        auto t2 = cache.getBoosterTemplate( "AAA" );
+        CATCH_REQUIRE( t1 == t2 );
+        CATCH_REQUIRE( allSetsData->cardPoolRequests == 1 );
+        CATCH_REQUIRE( cache.getCacheHits() == 1 );
+        CATCH_REQUIRE( cache.getCacheMisses() == 1 );
+
+        CATCH_REQUIRE( t1->getSetCode() == "AAA" );
+        CATCH_REQUIRE( t1->getBoosterSlots().size() == 4 );
+        CATCH_REQUIRE( t1->getCardCount() == 5 );
+        CATCH_REQUIRE( t1->getCards( RARITY_COMMON ) == std::vector<std::string>( { "C1", "C2" } ) );
+        CATCH_REQUIRE( t1->getCards( RARITY_MYTHIC_RARE ) == std::vector<std::string>( { "M1" } ) );
+        CATCH_REQUIRE( t1->getCards( RARITY_BASIC_LAND ).empty() );
+    }
+
+    CATCH_SECTION( "Unknown sets not cached" )
+    {
+        auto t = cache.getBoosterTemplate( "XXX" );
+        CATCH_REQUIRE( t->getBoosterSlots().empty() );
+        CATCH_REQUIRE( t->getCardCount() == 0 );
+        cache.getBoosterTemplate( "XXX" );
+        CATCH_REQUIRE( cache.getCacheHits() == 0 );
+        CATCH_REQUIRE( allSetsData->cardPoolRequests == 2 );
+    }
+
+    CATCH_SECTION( "Selectors share a template" )
+    {
+        auto t = cache.getBoosterTemplate( "AAA" );
+        auto rng = std::shared_ptr<RandGen>( new SimpleRandGen() );
+        CardPoolSelector cps1( t, rng );
+        CardPoolSelector cps2( t, rng );
+        CATCH_REQUIRE( cps1.getPoolSize() == 5 );
+
+        std::string card1, card2;
+        CATCH_REQUIRE( cps1.selectCard( SLOT_COMMON, card1 ) );
+        CATCH_REQUIRE( cps1.selectCard( SLOT_COMMON, card2 ) );
+        CATCH_REQUIRE( card1 != card2 );
+        CATCH_REQUIRE_FALSE( cps1.selectCard( SLOT_COMMON, card1 ) );
+        CATCH_REQUIRE( cps1.getPoolSize() == 3 );
+        CATCH_REQUIRE( cps2.getPoolSize() == 5 );
+
+        cps1.resetCardPool();
+        CATCH_REQUIRE( cps1.getPoolSize() == 5 );
+    }
+
+    CATCH_SECTION( "Selection driven by RandGen" )
+    {
+        auto t = cache.getBoosterTemplate( "AAA" );
+        auto rng = std::shared_ptr<RandGen>( new MinRandGen() );
+        CardPoolSelector cps( t, rng );
+
+        const std::string* card = cps.selectCard( SLOT_COMMON );
+        CATCH_REQUIRE( card != nullptr );
+        CATCH_REQUIRE( *card == "C1" );
+        card = cps.selectCard( SLOT_COMMON );
+        CATCH_REQUIRE( card != nullptr );
+        CATCH_REQUIRE( *card == "C2" );
+        CATCH_REQUIRE( cps.selectCard( SLOT_COMMON ) == nullptr );
+
+        // Canonical roll of zero always yields mythic.
+        card = cps.selectCard( SLOT_RARE_OR_MYTHIC_RARE );
+        CATCH_REQUIRE( card != nullptr );
+        CATCH_REQUIRE( *card == "M1" );
+
+        cps.resetCardPool();
+        CATCH_REQUIRE( cps.getPoolSize() == 5 );
+        std::set<std::string> commons;
+        for( int i = 0; i < 2; ++i )
+        {
+            card = cps.selectCard( SLOT_COMMON );
+            CATCH_REQUIRE( card != nullptr );
+            commons.insert( *card );
+        }
+        CATCH_REQUIRE( commons == std::set<std::string>( { "C1", "C2" } ) );
+    }
+}
@@ -1,6 +1,12 @@
 #include "catch.hpp"
 #include "spdlog/spdlog.h"
 #include "Decklist.h"
+#include "StringUtil.h"
+
+#include <random>
+#include <regex>
+#include <set>
+#include <sstream>
 
 CATCH_TEST_CASE( "Decklist tests", "[decklist]" )
 {
@@ -420,3 +426,189 @@ CATCH_TEST_CASE( "Decklist tests", "[decklist]" )
     }
 }
 
+
+
+// The original regex-based parser, kept as a reference for the hand-written
+// one.  Cards go into the given maps rather than a Decklist.
+static Decklist::ParseResult
+referenceParse( const std::string&                 deckStr,
+                std::map<SimpleCardData,uint16_t>& mainMap,
+                std::map<SimpleCardData,uint16_t>& sideboardMap )
+{
+    Decklist::ParseResult result;
+
+    std::stringstream ss( deckStr );
+    std::string rawLine;
+    std::string line;
+
+    static const std::regex printableRegex( "^[[:print:]]*$" );
+    static const std::regex commentRegex( "^//.*$" );
+    static const std::regex mwdeckRegex( "^([sS][bB]:?[[:space:]]*)?"
+                                         "(([[:digit:]]+)[xX]?[[:space:]]*)?"
+                                         "\\[([[:alnum:]]*)\\]?[[:space:]]*"
+                                         "(.*)$" );
+    static const std::regex decRegex( "^([sS][bB]:?[[:space:]]*)?"
+                                      "(([[:digit:]]+)[xX]?[[:space:]]*)?"
+                                      "(.*)$" );
+
+    unsigned int lineNum = 0;
+    while( std::getline( ss, rawLine ) )
+    {
+        lineNum++;
+        std::smatch match;
+
+        line = StringUtil::trim( rawLine );
+
+        bool sb = false;
+        std::string qtyStr;
+        std::string nameStr;
+        std::string setStr;
+
+        if( line.empty() )
+        {
+            continue;
+        }
+        else if( !std::regex_match( line, match, printableRegex ) )
+        {
+            result.errors.push_back( Decklist::ParseResult::Error( lineNum, "<binary data>", "Contains binary data" ) );
+            continue;
+        }
+        else if( std::regex_match( line, match, commentRegex ) )
+        {
+            continue;
+        }
+        else if( std::regex_match( line, match, mwdeckRegex ) )
+        {
+            sb = !match[1].str().empty();
+            qtyStr = match[3].str();
+            setStr = match[4].str();
+            nameStr = match[5].str();
+        }
+        else if( std::regex_match( line, match, decRegex ) )
+        {
+            sb = !match[1].str().empty();
+            qtyStr = match[3].str();
+            nameStr = match[4].str();
+        }
+        else
+        {
+            result.errors.push_back( Decklist::ParseResult::Error( lineNum, rawLine, "Unrecognized format" ) );
+            continue;
+        }
+
+        if( nameStr.empty() )
+        {
+            result.errors.push_back( Decklist::ParseResult::Error( lineNum, rawLine, "Missing name field" ) );
+            continue;
+        }
+
+        SimpleCardData c( nameStr, setStr );
+        uint16_t qty = 1;
+        if( !qtyStr.empty() )
+        {
+            std::istringstream( qtyStr ) >> qty;
+        }
+
+        if( sb )
+        {
+            sideboardMap[c] = qty;
+        }
+        else
+        {
+            mainMap[c] = qty;
+        }
+    }
+
+    return result;
+}
+
+
+static void
+requireParseEquivalent( const std::string& deckStr )
+{
+    std::map<SimpleCardData,uint16_t> refMainMap;
+    std::map<SimpleCardData,uint16_t> refSideboardMap;
+    Decklist::ParseResult refResult = referenceParse( deckStr, refMainMap, refSideboardMap );
+
+    Decklist d;
+    Decklist::ParseResult result = d.parse( deckStr );
+
+    CATCH_INFO( "deck: '" << deckStr << "'" );
+    CATCH_REQUIRE( result.errorCount() == refResult.errorCount() );
+    for( unsigned int i = 0; i < result.errorCount(); ++i )
+    {
+        CATCH_REQUIRE( result.errors[i].lineNum == refResult.errors[i].lineNum );
+        CATCH_REQUIRE( result.errors[i].line == refResult.errors[i].line );
+        CATCH_REQUIRE( result.errors[i].message == refResult.errors[i].message );
+    }
+
+    const std::vector<SimpleCardData> mainCardsVec = d.getCards( Decklist::ZONE_MAIN );
+    const std::set<SimpleCardData> mainCards( mainCardsVec.begin(), mainCardsVec.end() );
+    CATCH_REQUIRE( mainCardsVec.size() == refMainMap.size() );
+    for( const auto& kv : refMainMap )
+    {
+        CATCH_REQUIRE( mainCards.count( kv.first ) == 1 );
+        CATCH_REQUIRE( d.getCardQuantity( kv.first, Decklist::ZONE_MAIN ) == kv.second );
+    }
+
+    const std::vector<SimpleCardData> sideboardCardsVec = d.getCards( Decklist::ZONE_SIDEBOARD );
+    const std::set<SimpleCardData> sideboardCards( sideboardCardsVec.begin(), sideboardCardsVec.end() );
+    CATCH_REQUIRE( sideboardCardsVec.size() == refSideboardMap.size() );
+    for( const auto& kv : refSideboardMap )
+    {
+        CATCH_REQUIRE( sideboardCards.count( kv.first ) == 1 );
+        CATCH_REQUIRE( d.getCardQuantity( kv.first, Decklist::ZONE_SIDEBOARD ) == kv.second );
+    }
+}
+
+
+CATCH_TEST_CASE( "Decklist parse equivalence", "[decklist]" )
+{
+    CATCH_SECTION( "Edge cases" )
+    {
+        const std::vector<std::string> decks = {
+                "", "\n", "\n\n\n", " \t \n", "Test Card", "Test Card\n", "\nTest Card",
+                "// comment", "  // comment", "/ not a comment", "//", "/",
+                "SB", "SB:", "sb: ", "SB 3", "SB 3x", "Sbire", "sB:Card", "SB:: Card",
+                "3", "3x", "3X ", "3 x Card", "3xCard", "007 Bond", "0 Card",
+                "65535 Card", "65536 Card", "70000 Card", "99999999999999999999 Card",
+                "[TST]", "[TST] ", "[", "[]", "[] Card", "[TST Card", "[TST]Card",
+                "[T-ST] Card", "3 [TST] Card", "3[TST]Card", "SB:3x[TST] Card",
+                "[TST] [TS2] Card", "3 Card [TST]", "Card\r", "Card\r\nCard 2\r\n",
+                "Ca\trd", "Ca\x01rd", "Dan Dan \xc3\xa9", "\xff",
+                "2 Test Card\n2 Test Card\nSB: 1 Test Card\n3 Test Card" };
+        for( const auto& deck : decks )
+        {
+            requireParseEquivalent( deck );
+        }
+    }
+
+    CATCH_SECTION( "Fuzz" )
+    {
+        // Lines built from tokens of the grammar, mangled with stray
+        // characters, exercise the corners of both parsers.
+        const std::vector<std::string> tokens = {
+                "SB", "sb", "Sb", ":", " ", "  ", "\t", "1", "23", "65536", "x", "X",
+                "[", "]", "TST", "//", "/", "Card", "Name", "-", "'", ",", "\r", "\x02", "\xc3\xa9" };
+
+        std::mt19937 rng( 1234 );
+        std::uniform_int_distribution<int> lineCountDist( 0, 6 );
+        std::uniform_int_distribution<int> tokenCountDist( 0, 8 );
+        std::uniform_int_distribution<int> tokenDist( 0, tokens.size() - 1 );
+        for( int i = 0; i < 2000; ++i )
+        {
+            std::string deck;
+            const int lineCount = lineCountDist( rng );
+            for( int l = 0; l < lineCount; ++l )
+            {
+                if( l > 0 ) deck += '\n';
+                const int tokenCount = tokenCountDist( rng );
+                for( int t = 0; t < tokenCount; ++t )
+                {
+                    deck += tokens[tokenDist( rng )];
+                }
+            }
+            requireParseEquivalent( deck );
+        }
+    }
+}
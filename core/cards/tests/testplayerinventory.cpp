@@ -1,6 +1,7 @@
 #include "catch.hpp"
 #include "PlayerInventory.h"
 #include "SimpleCardData.h"
+#include <memory>
 
 CATCH_TEST_CASE( "Player Inventory", "[playerinventory]" )
 {
@@ -239,6 +240,108 @@ CATCH_TEST_CASE( "Player Inventory", "[playerinventory]" )
                 PlayerInventory::ZONE_JUNK, PlayerInventory::ZONE_JUNK ) );
     }
 
+    CATCH_SECTION( "Card Groups" )
+    {
+        const PlayerInventory::CardGroups& groups = inv.getCardGroups( PlayerInventory::ZONE_MAIN );
+        CATCH_REQUIRE( groups.size() == 3 );
+        CATCH_REQUIRE( groups.count( PlayerInventory::CardKey( "3ED", "Disenchant" ) ) == 1 );
+        CATCH_REQUIRE( groups.count( PlayerInventory::CardKey( "3ED", "Fireball" ) ) == 0 );
+
+        // Copies share a group, the oldest copy moves first, and card
+        // objects are moved rather than copied.
+        const PlayerInventory::CardKey boltKey( "3ED", "Lightning Bolt" );
+        auto bolt = std::make_shared<SimpleCardData>( "Lightning Bolt", "3ED" );
+        CATCH_REQUIRE( inv.add( bolt, PlayerInventory::ZONE_MAIN ) );
+        CATCH_REQUIRE( groups.at( boltKey ).size() == 2 );
+        auto oldestBolt = *groups.at( boltKey ).front();
+        CATCH_REQUIRE( oldestBolt != bolt );
+        CATCH_REQUIRE( inv.move( boltKey, PlayerInventory::ZONE_MAIN, PlayerInventory::ZONE_JUNK ) );
+        CATCH_REQUIRE( *inv.getCardGroups( PlayerInventory::ZONE_JUNK ).at( boltKey ).front() == oldestBolt );
+        CATCH_REQUIRE( *groups.at( boltKey ).front() == bolt );
+        CATCH_REQUIRE( inv.size( PlayerInventory::ZONE_MAIN ) == 3 );
+        CATCH_REQUIRE( inv.size( PlayerInventory::ZONE_JUNK ) == 4 );
+    }
+
+    CATCH_SECTION( "Zone Order" )
+    {
+        // Cards stay in arrival order; a moved card goes to the end.
+        CATCH_REQUIRE( inv.move( PlayerInventory::CardKey( "3ED", "Disenchant" ),
+                PlayerInventory::ZONE_MAIN, PlayerInventory::ZONE_SIDEBOARD ) );
+        CATCH_REQUIRE( inv.move( PlayerInventory::CardKey( "3ED", "Disenchant" ),
+                PlayerInventory::ZONE_SIDEBOARD, PlayerInventory::ZONE_MAIN ) );
+
+        auto cards = inv.getCards( PlayerInventory::ZONE_MAIN );
+        CATCH_REQUIRE( cards.size() == 3 );
+        CATCH_REQUIRE( cards[0]->getName() == "Lightning Bolt" );
+        CATCH_REQUIRE( cards[1]->getName() == "Fireball" );
+        CATCH_REQUIRE( cards[2]->getName() == "Disenchant" );
+
+        const PlayerInventory::CardList& cardList = inv.getCardList( PlayerInventory::ZONE_MAIN );
+        CATCH_REQUIRE( std::equal( cardList.begin(), cardList.end(), cards.begin() ) );
+
+        // Moving within a zone moves the oldest copy to the end.
+        auto bolt = std::make_shared<SimpleCardData>( "Lightning Bolt", "3ED" );
+        CATCH_REQUIRE( inv.add( bolt, PlayerInventory::ZONE_MAIN ) );
+        CATCH_REQUIRE( inv.move( PlayerInventory::CardKey( "3ED", "Lightning Bolt" ),
+                PlayerInventory::ZONE_MAIN, PlayerInventory::ZONE_MAIN ) );
+        cards = inv.getCards( PlayerInventory::ZONE_MAIN );
+        CATCH_REQUIRE( cards.size() == 4 );
+        CATCH_REQUIRE( cards[0]->getName() == "Fireball" );
+        CATCH_REQUIRE( cards[1]->getName() == "Disenchant" );
+        CATCH_REQUIRE( cards[2] == bolt );
+        CATCH_REQUIRE( cards[3]->getName() == "Lightning Bolt" );
+        CATCH_REQUIRE( *inv.getCardGroups( PlayerInventory::ZONE_MAIN ).at(
+                PlayerInventory::CardKey( "3ED", "Lightning Bolt" ) ).front() == bolt );
+    }
+
+    CATCH_SECTION( "Copy" )
+    {
+        // Copies share card objects but not zones.
+        PlayerInventory invCopy( inv );
+        CATCH_REQUIRE( invCopy.size() == 12 );
+        CATCH_REQUIRE( invCopy.getCards( PlayerInventory::ZONE_MAIN ) == inv.getCards( PlayerInventory::ZONE_MAIN ) );
+
+        CATCH_REQUIRE( invCopy.move( PlayerInventory::CardKey( "3ED", "Disenchant" ),
+                PlayerInventory::ZONE_MAIN, PlayerInventory::ZONE_JUNK ) );
+        CATCH_REQUIRE( inv.move( PlayerInventory::CardKey( "3ED", "Lightning Bolt" ),
+                PlayerInventory::ZONE_MAIN, PlayerInventory::ZONE_SIDEBOARD ) );
+
+        CATCH_REQUIRE( invCopy.size( PlayerInventory::ZONE_MAIN ) == 2 );
+        CATCH_REQUIRE( invCopy.size( PlayerInventory::ZONE_JUNK ) == 4 );
+        CATCH_REQUIRE( invCopy.size( PlayerInventory::ZONE_SIDEBOARD ) == 3 );
+        CATCH_REQUIRE( invCopy.getCardGroups( PlayerInventory::ZONE_MAIN ).count(
+                PlayerInventory::CardKey( "3ED", "Lightning Bolt" ) ) == 1 );
+        CATCH_REQUIRE( inv.size( PlayerInventory::ZONE_MAIN ) == 2 );
+        CATCH_REQUIRE( inv.size( PlayerInventory::ZONE_JUNK ) == 3 );
+        CATCH_REQUIRE( inv.size( PlayerInventory::ZONE_SIDEBOARD ) == 4 );
+        CATCH_REQUIRE( inv.getCardGroups( PlayerInventory::ZONE_MAIN ).count(
+                PlayerInventory::CardKey( "3ED", "Disenchant" ) ) == 1 );
+
+        // Assignment, and the copy outliving the original.
+        std::unique_ptr<PlayerInventory> invOrig( new PlayerInventory( inv ) );
+        PlayerInventory invAssigned;
+        invAssigned = *invOrig;
+        invOrig.reset();
+        CATCH_REQUIRE( invAssigned.move( PlayerInventory::CardKey( "3ED", "Disenchant" ),
+                PlayerInventory::ZONE_MAIN, PlayerInventory::ZONE_AUTO ) );
+        CATCH_REQUIRE( invAssigned.size( PlayerInventory::ZONE_MAIN ) == 1 );
+        CATCH_REQUIRE( invAssigned.getCards( PlayerInventory::ZONE_AUTO ).back()->getName() == "Disenchant" );
+        CATCH_REQUIRE( invAssigned.size() == 12 );
+    }
+
+    CATCH_SECTION( "Move All" )
+    {
+        for( auto card : inv.getCards( PlayerInventory::ZONE_JUNK ) )
+        {
+            CATCH_REQUIRE( inv.move( card, PlayerInventory::ZONE_JUNK, PlayerInventory::ZONE_MAIN ) );
+        }
+        CATCH_REQUIRE( inv.size( PlayerInventory::ZONE_JUNK ) == 0 );
+        CATCH_REQUIRE( inv.getCardGroups( PlayerInventory::ZONE_JUNK ).empty() );
+        CATCH_REQUIRE( inv.size( PlayerInventory::ZONE_MAIN ) == 6 );
+        CATCH_REQUIRE( inv.getCardGroups( PlayerInventory::ZONE_MAIN ).size() == 4 );
+        CATCH_REQUIRE( inv.size() == 12 );
+    }
+
     CATCH_SECTION( "Clear" )
     {
         inv.clear();
@@ -0,0 +1,225 @@
+#include "catch.hpp"
+#include "MtgJsonAllSetsData.h"
+#include "SnapshotAllSetsData.h"
+#include <cstdio>
+#include <memory>
+
+static const char* ALLSETS_JSON = R"({
+    "AAA": {
+        "name": "Alpha Test", "type": "core", "releaseDate": "2000-01-01",
+        "gathererCode": "AT",
+        "booster": [ "rare", "uncommon", "common", "common", "land" ],
+        "cards": [
+            { "name": "Lightning Bolt", "rarity": "Common", "multiverseid": 1,
+              "cmc": 1, "colors": [ "Red" ], "types": [ "Instant" ] },
+            { "name": "Fire", "names": [ "Fire", "Ice" ], "layout": "split",
+              "rarity": "Uncommon", "multiverseid": 2, "cmc": 2,
+              "colors": [ "Red" ], "types": [ "Instant" ] },
+            { "name": "Ice", "names": [ "Fire", "Ice" ], "layout": "split",
+              "rarity": "Uncommon", "multiverseid": 2, "cmc": 2,
+              "colors": [ "Blue" ], "types": [ "Instant" ] },
+            { "name": "Black Lotus", "rarity": "Rare", "multiverseid": 3,
+              "types": [ "Artifact" ] }
+        ]
+    },
+    "BBB": {
+        "name": "Beta Test", "type": "expansion", "releaseDate": "2001-01-01",
+        "cards": [
+            { "name": "Lightning Bolt", "rarity": "Common", "multiverseid": 4,
+              "cmc": 1, "colors": [ "Red" ], "types": [ "Instant" ] },
+            { "name": "Lightning Angel", "rarity": "Rare", "multiverseid": 5, "cmc": 4,
+              "colors": [ "White", "Blue", "Red" ], "types": [ "Creature" ] }
+        ]
+    }
+})";
+
+static const std::string SNAPSHOT_FILENAME = "testsnapshot.snapshot";
+
+
+static std::string sig( CardData* c )
+{
+    if( c == nullptr ) return "null";
+    std::unique_ptr<CardData> cardData( c );
+    std::string s = c->getSetCode() + "|" + c->getName() + "|" +
+            std::to_string( c->getMultiverseId() ) + "|" + std::to_string( c->getCMC() ) + "|" +
+            std::to_string( c->getRarity() ) + "|" + std::to_string( c->isSplit() );
+    for( auto color : c->getColors() ) s += "|" + stringify( color );
+    for( auto type : c->getTypes() ) s += "|" + type;
+    return s;
+}
+
+
+CATCH_TEST_CASE( "Snapshot matches parsed data", "[snapshot]" )
+{
+    MtgJsonAllSetsData jsonData;
+    FILE* jsonFile = tmpfile();
+    CATCH_REQUIRE( jsonFile != NULL );
+    fputs( ALLSETS_JSON, jsonFile );
+    rewind( jsonFile );
+    CATCH_REQUIRE( jsonData.parse( jsonFile ) );
+    fclose( jsonFile );
+
+    FILE* snapshotFile = fopen( SNAPSHOT_FILENAME.c_str(), "wb" );
+    CATCH_REQUIRE( snapshotFile != NULL );
+    CATCH_REQUIRE( jsonData.writeSnapshot( snapshotFile, "1.2.3" ) );
+    fclose( snapshotFile );
+
+    SnapshotAllSetsData snapshotData;
+
+    CATCH_SECTION( "Version keying" )
+    {
+        CATCH_REQUIRE_FALSE( snapshotData.load( "no-such-file.snapshot" ) );
+        CATCH_REQUIRE_FALSE( snapshotData.load( SNAPSHOT_FILENAME, "1.2.4" ) );
+        CATCH_REQUIRE( snapshotData.load( SNAPSHOT_FILENAME, "1.2.3" ) );
+        CATCH_REQUIRE( snapshotData.getDataVersion() == "1.2.3" );
+        CATCH_REQUIRE( snapshotData.load( SNAPSHOT_FILENAME ) );
+    }
+
+    CATCH_SECTION( "Set data" )
+    {
+        CATCH_REQUIRE( snapshotData.load( SNAPSHOT_FILENAME, "1.2.3" ) );
+
+        CATCH_REQUIRE( snapshotData.getSetCodes() == jsonData.getSetCodes() );
+        for( const std::string code : { "AAA", "BBB", "", "ZZZ" } )
+        {
+            CATCH_REQUIRE( snapshotData.getSetName( code ) == jsonData.getSetName( code ) );
+            CATCH_REQUIRE( snapshotData.getSetGathererCode( code ) == jsonData.getSetGathererCode( code ) );
+            CATCH_REQUIRE( snapshotData.hasBoosterSlots( code ) == jsonData.hasBoosterSlots( code ) );
+            CATCH_REQUIRE( snapshotData.getBoosterSlots( code ) == jsonData.getBoosterSlots( code ) );
+            CATCH_REQUIRE( snapshotData.getCardPool( code ) == jsonData.getCardPool( code ) );
+        }
+        CATCH_REQUIRE( snapshotData.getSetGathererCode( "AAA" ) == "AT" );
+        CATCH_REQUIRE( snapshotData.getCardPool( "AAA" ).size() == 3 );
+    }
+
+    CATCH_SECTION( "Card data" )
+    {
+        CATCH_REQUIRE( snapshotData.load( SNAPSHOT_FILENAME, "1.2.3" ) );
+
+        for( const std::string code : { "AAA", "BBB", "", "ZZZ" } )
+        {
+            for( const std::string name : { "Lightning Bolt", "lightning bolt", "Fire", "Ice",
+                                            "Fire // Ice", "fire/ice", "Black Lotus",
+                                            "Lightning Angel", "No Such Card", "" } )
+            {
+                CATCH_REQUIRE( sig( snapshotData.createCardData( code, name ) ) ==
+                               sig( jsonData.createCardData( code, name ) ) );
+            }
+        }
+
+        for( int muid = -1; muid <= 6; ++muid )
+        {
+            CATCH_REQUIRE( sig( snapshotData.createCardData( muid ) ) ==
+                           sig( jsonData.createCardData( muid ) ) );
+        }
+
+        for( const std::string name : { "Lightning Bolt", "Ice", "Lightning Angel", "No Such Card" } )
+        {
+            CATCH_REQUIRE( snapshotData.findSetCode( name ) == jsonData.findSetCode( name ) );
+        }
+
+        // Expansion set has search priority.
+        CATCH_REQUIRE( snapshotData.findSetCode( "Lightning Bolt" ) == "BBB" );
+        CATCH_REQUIRE( sig( snapshotData.createCardData( "AAA", "ice" ) ) ==
+                       "AAA|Fire // Ice|2|2|2|1|Blue|Instant" );
+    }
+
+    CATCH_SECTION( "Card resolution" )
+    {
+        CATCH_REQUIRE( snapshotData.load( SNAPSHOT_FILENAME, "1.2.3" ) );
+
+        const std::vector<SimpleCardData> cards = {
+                SimpleCardData( "Lightning Bolt", "AAA" ),
+                SimpleCardData( "Lightning Bolt" ),
+                SimpleCardData( "lightning bolt", "ZZZ" ),
+                SimpleCardData( "Lightning Angel", "AAA" ),
+                SimpleCardData( "fire/ice", "AAA" ),
+                SimpleCardData( "No Such Card", "AAA" ),
+                SimpleCardData( "Lightning Bolt", "AAA" ),
+                SimpleCardData( "" ) };
+
+        for( const AllSetsData* data : { static_cast<const AllSetsData*>( &jsonData ),
+                                         static_cast<const AllSetsData*>( &snapshotData ) } )
+        {
+            const std::vector<AllSetsData::CardResolution> resolutions = data->resolveCards( cards );
+            CATCH_REQUIRE( resolutions.size() == cards.size() );
+
+            // Resolved cards match single lookups; cards not in their set
+            // (or without one) resolve in the set of highest priority.
+            const std::vector<std::string> expectedSetCodes = { "AAA", "BBB", "BBB", "BBB", "AAA", "", "AAA", "" };
+            for( std::size_t i = 0; i < cards.size(); ++i )
+            {
+                CATCH_REQUIRE( resolutions[i].isResolved() == !expectedSetCodes[i].empty() );
+                CATCH_REQUIRE( resolutions[i].setCode == expectedSetCodes[i] );
+                if( resolutions[i].isResolved() )
+                {
+                    CATCH_REQUIRE( sig( data->createCardData( resolutions[i].handle ) ) ==
+                                   sig( data->createCardData( expectedSetCodes[i], cards[i].getName() ) ) );
+                }
+            }
+
+            CATCH_REQUIRE( data->createCardData( AllSetsData::CardHandle() ) == nullptr );
+            CATCH_REQUIRE( data->resolveCards( std::vector<SimpleCardData>() ).empty() );
+        }
+    }
+
+    remove( SNAPSHOT_FILENAME.c_str() );
+}
+
+
+// A card whose plain name looks like a split card name, in a set searched
+// before the real split card.
+static const char* SPLIT_NAME_ALLSETS_JSON = R"({
+    "AAA": {
+        "name": "Alpha Test", "type": "core", "releaseDate": "2000-01-01",
+        "cards": [
+            { "name": "Fire", "names": [ "Fire", "Ice" ], "layout": "split",
+              "rarity": "Uncommon", "multiverseid": 2, "cmc": 2,
+              "colors": [ "Red" ], "types": [ "Instant" ] },
+            { "name": "Ice", "names": [ "Fire", "Ice" ], "layout": "split",
+              "rarity": "Uncommon", "multiverseid": 2, "cmc": 2,
+              "colors": [ "Blue" ], "types": [ "Instant" ] }
+        ]
+    },
+    "CCC": {
+        "name": "Gamma Test", "type": "expansion", "releaseDate": "2002-01-01",
+        "cards": [
+            { "name": "Fire // Ice", "rarity": "Rare", "multiverseid": 6,
+              "cmc": 2, "colors": [ "Red" ], "types": [ "Instant" ] }
+        ]
+    }
+})";
+
+
+CATCH_TEST_CASE( "Normalized split names only match split cards", "[snapshot]" )
+{
+    MtgJsonAllSetsData jsonData;
+    FILE* jsonFile = tmpfile();
+    CATCH_REQUIRE( jsonFile != NULL );
+    fputs( SPLIT_NAME_ALLSETS_JSON, jsonFile );
+    rewind( jsonFile );
+    CATCH_REQUIRE( jsonData.parse( jsonFile ) );
+    fclose( jsonFile );
+
+    FILE* snapshotFile = fopen( SNAPSHOT_FILENAME.c_str(), "wb" );
+    CATCH_REQUIRE( snapshotFile != NULL );
+    CATCH_REQUIRE( jsonData.writeSnapshot( snapshotFile, "1.2.3" ) );
+    fclose( snapshotFile );
+
+    SnapshotAllSetsData snapshotData;
+    CATCH_REQUIRE( snapshotData.load( SNAPSHOT_FILENAME, "1.2.3" ) );
+
+    for( const AllSetsData* data : { static_cast<const AllSetsData*>( &jsonData ),
+                                     static_cast<const AllSetsData*>( &snapshotData ) } )
+    {
+        // The exact name finds the plain card in the set searched first,
+        // but a name that only matches once normalized finds the split card.
+        CATCH_REQUIRE( data->findSetCode( "Fire // Ice" ) == "CCC" );
+        CATCH_REQUIRE( data->findSetCode( "fire/ice" ) == "AAA" );
+        CATCH_REQUIRE( sig( data->createCardData( "CCC", "fire/ice" ) ) == "null" );
+        CATCH_REQUIRE( sig( data->createCardData( "AAA", "fire/ice" ) ) ==
+                       "AAA|Fire // Ice|2|2|2|1|Red|Instant" );
+    }
+
+    remove( SNAPSHOT_FILENAME.c_str() );
+}
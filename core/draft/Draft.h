@@ -1,6 +1,7 @@
 #ifndef DRAFT_H
 #define DRAFT_H
 
+#include <iterator>
 #include <memory>
 #include <queue>
 #include <vector>
@@ -106,9 +107,12 @@ public:
 private:
     class Chair;
     class Card;
-    typedef std::shared_ptr<Card> CardSharedPtr;
     class Pack;
-    typedef std::shared_ptr<Pack> PackSharedPtr;
+    class UnselectedCardIterator;
+    class UnselectedCardRange;
+
+    // Pack index meaning 'no pack'.
+    static const uint32_t NO_PACK = 0xFFFFFFFF;
 
     //--------------------------------------------------------------------
 
@@ -119,7 +123,16 @@ public:
            const Logging::Config&     loggingConfig = Logging::Config() );
     ~Draft();
 
-    void addObserver( Observer* observer ) { mObservers.push_back( observer ); }
+    // Observers added here receive all notifications.
+    void addObserver( Observer* observer );
+
+    // Observers added for a chair receive chair-specific notifications
+    // (packs, selection results, autoselections, timeouts) for that chair
+    // only, plus all notifications that aren't chair-specific.  Returns
+    // false if the chair index is invalid.
+    bool addChairObserver( int chairIndex, Observer* observer );
+
+    // Removes a global or chair observer.
     void removeObserver( Observer* observer );
 
     // Start the draft.
@@ -224,11 +237,21 @@ private:
     void processTick();
 
     void startNewRound();
-    PackSharedPtr createPackFromDispensations( int chairIndex, const CardDispensationRepeatedPtrField& dispensations );
-    PackSharedPtr createGridPackFromDispenser( uint32_t cardDispenserIndex );
+    uint32_t createPackFromDispensations( int chairIndex, const CardDispensationRepeatedPtrField& dispensations );
+    uint32_t createGridPackFromDispenser( uint32_t cardDispenserIndex );
     bool isSelectionComplete();
     bool checkRoundTransition();
 
+    // Returns the chair's top pack or nullptr if its queue is empty.  The
+    // pointer is only good until more packs are created.
+    Pack* getTopPack( const Chair& chair );
+
+    // Select a card from a pack and record it with the chair.
+    void selectCardToChair( Pack& pack, std::size_t index, Chair& chair, int indexInRound );
+
+    // Rebuild the public card state scratch vector from the public pack.
+    void updatePublicCardStates();
+
     int getNextChairIndex( int thisChairIndex );
 
     void enterDraftErrorState();
@@ -241,14 +264,29 @@ private:
     int                           mCurrentRound;
     bool                          mPostRoundTimerStarted;
     uint32_t                      mPostRoundTimerTicksRemaining;
-    PackSharedPtr                 mPublicPack;
-    Chair*                        mPublicActiveChair;
-    std::vector<Chair*>           mChairs;
+    uint32_t                      mPublicPackIndex;
+    int                           mPublicActiveChairIndex;
+    std::vector<Chair>            mChairs;
     std::vector<Observer*>        mObservers;
     std::queue<MessageSharedPtr>  mMessageQueue;
     uint32_t                      mNextPackId;
     bool                          mProcessingMessageQueue;
 
+    // Dispatch lists for chair-specific notifications: global observers
+    // plus the observers added for each chair.
+    std::vector<std::vector<Observer*>> mChairObservers;
+
+    // Every card dispensed during the draft lives in this slab, with each
+    // pack occupying a contiguous range.  Packs are likewise kept in a
+    // slab and referred to by index.
+    std::vector<Card>             mCards;
+    std::vector<Pack>             mPacks;
+
+    // Reused for observer notifications to avoid building fresh vectors
+    // on every selection.
+    std::vector<TCardDescriptor>                   mScratchCardDescriptors;
+    std::vector<typename Observer::PublicCardState> mScratchPublicCardStates;
+
     std::shared_ptr<spdlog::logger> mLogger;
 
     //--------------------------------------------------------------------
@@ -264,75 +302,148 @@ private:
         int getTicksRemaining() const { return mTicksRemaining; }
         void setTicksRemaining( int ticksRemaining ) { mTicksRemaining = ticksRemaining; }
 
-        void enqueuePack( PackSharedPtr pack );
-        std::size_t getPackQueueSize() { return mPackQueue.size(); }
-        PackSharedPtr getTopPack();
+        void enqueuePack( uint32_t packIndex );
+        std::size_t getPackQueueSize() const { return mPackQueue.size(); }
+        uint32_t getTopPackIndex() const;
         void popTopPack();
 
-        void addSelectedCard( CardSharedPtr card );
+        void addSelectedCard( uint32_t cardIndex );
 
-        std::vector<CardSharedPtr> getSelectedCards() const { return mSelectedCards; }
+        // Indices of selected cards in the draft's card slab.
+        const std::vector<uint32_t>& getSelectedCards() const { return mSelectedCards; }
 
     private:
 
-        const int mIndex;
-        std::vector<CardSharedPtr> mSelectedCards;
-        std::queue<PackSharedPtr> mPackQueue;
+        int mIndex;
+        std::vector<uint32_t> mSelectedCards;
+        std::queue<uint32_t> mPackQueue;
         int mTicksRemaining;
     };
 
     //--------------------------------------------------------------------
 
-    class Pack
+    class Card
     {
     public:
 
-        Pack( uint32_t packId ) : mPackId( packId ) {}
+        Card( const TCardDescriptor& cardDescriptor )
+          : mCardDescriptor( cardDescriptor ),
+            mSelectedChairIndex( -1 ),
+            mSelectedRound( -1 ),
+            mSelectedIndexInRound( -1 ) {}
+
+        const TCardDescriptor& getCardDescriptor() const { return mCardDescriptor; }
 
-        std::size_t getCardCount() const { return mCards.size(); }
-        std::size_t getSelectedCardCount() const;
-        std::size_t getUnselectedCardCount() const;
+        bool isSelected() const { return (mSelectedChairIndex >= 0); }
+        void setSelected( int chairIndex, int round, int indexInRound );
 
-        void addCard( CardSharedPtr spCard );
-        CardSharedPtr getCard( std::size_t index ) const;
-        std::vector<TCardDescriptor> getCardDescriptors() const;
-        std::vector<CardSharedPtr> getUnselectedCards() const;
-        std::vector<TCardDescriptor> getUnselectedCardDescriptors() const;
-        CardSharedPtr getFirstUnselectedCard( const TCardDescriptor& cardDescriptor );
-        uint32_t getPackId() const { return mPackId; }
+        // Chair that selected the card; -1 if not selected
+        int getSelectedChairIndex() const { return mSelectedChairIndex; }
+        int getSelectedIndexInRound() const { return mSelectedIndexInRound; }
 
     private:
 
-        uint32_t mPackId;
-        std::vector<CardSharedPtr> mCards;
+        TCardDescriptor mCardDescriptor;
+        int mSelectedChairIndex;
+        int mSelectedRound;
+        int mSelectedIndexInRound;
     };
 
     //--------------------------------------------------------------------
 
-    class Card
+    // Forward iterator over the unselected cards in a range of the slab.
+    class UnselectedCardIterator
     {
     public:
 
-        Card( const TCardDescriptor& cardDescriptor )
-          : mCardDescriptor( cardDescriptor ),
-            mSelectedChairPtr( 0 ),
-            mSelectedRound( -1 ),
-            mSelectedIndexInRound( -1 ) {}
+        typedef std::forward_iterator_tag iterator_category;
+        typedef const Card                value_type;
+        typedef std::ptrdiff_t            difference_type;
+        typedef const Card*               pointer;
+        typedef const Card&               reference;
 
-        const TCardDescriptor& getCardDescriptor() const { return mCardDescriptor; }
+        UnselectedCardIterator( const Card* pos, const Card* end )
+          : mPos( pos ), mEnd( end ) { skipSelected(); }
 
-        bool isSelected() const { return (mSelectedChairPtr != 0); }
-        void setSelected( const Chair* const chairPtr, int round, int indexInRound );
+        const Card& operator*() const { return *mPos; }
+        const Card* operator->() const { return mPos; }
+        UnselectedCardIterator& operator++() { ++mPos; skipSelected(); return *this; }
 
-        const Chair* getSelectedChair() const { return mSelectedChairPtr; }
-        int getSelectedIndexInRound() const { return mSelectedIndexInRound; }
+        bool operator==( const UnselectedCardIterator& other ) const { return mPos == other.mPos; }
+        bool operator!=( const UnselectedCardIterator& other ) const { return mPos != other.mPos; }
 
     private:
 
-        const TCardDescriptor mCardDescriptor;
-        const Chair* mSelectedChairPtr;
-        int mSelectedRound;
-        int mSelectedIndexInRound;
+        void skipSelected() { while( (mPos != mEnd) && mPos->isSelected() ) ++mPos; }
+
+        const Card* mPos;
+        const Card* mEnd;
+    };
+
+    // View of the unselected cards in a pack.  Like the pack's card
+    // pointers, only good until more cards are added to the draft.
+    class UnselectedCardRange
+    {
+    public:
+
+        UnselectedCardRange( const Card* begin, const Card* end )
+          : mBegin( begin ), mEnd( end ) {}
+
+        UnselectedCardIterator begin() const { return UnselectedCardIterator( mBegin, mEnd ); }
+        UnselectedCardIterator end() const { return UnselectedCardIterator( mEnd, mEnd ); }
+
+    private:
+
+        const Card* mBegin;
+        const Card* mEnd;
+    };
+
+    //--------------------------------------------------------------------
+
+    class Pack
+    {
+    public:
+
+        // Packs are built by appending to the end of the card slab, so a
+        // pack must be complete before cards are added for another pack.
+        Pack( uint32_t packId, std::vector<Card>* cardSlab )
+          : mPackId( packId ),
+            mCardSlab( cardSlab ),
+            mFirstCard( cardSlab->size() ),
+            mCardCount( 0 ),
+            mSelectedCardCount( 0 ) {}
+
+        uint32_t getPackId() const { return mPackId; }
+
+        std::size_t getCardCount() const { return mCardCount; }
+        std::size_t getSelectedCardCount() const { return mSelectedCardCount; }
+        std::size_t getUnselectedCardCount() const { return mCardCount - mSelectedCardCount; }
+
+        void addCard( const TCardDescriptor& cardDescriptor );
+
+        // Returns nullptr if index is out of range.
+        const Card* getCard( std::size_t index ) const;
+
+        // Index of a pack card within the card slab.
+        uint32_t getCardSlabIndex( std::size_t index ) const { return mFirstCard + index; }
+
+        void selectCard( std::size_t index, int chairIndex, int round, int indexInRound );
+
+        UnselectedCardRange getUnselectedCards() const;
+        void getUnselectedCardDescriptors( std::vector<TCardDescriptor>& cardDescriptors ) const;
+
+        // Returns index of first unselected card (matching the descriptor
+        // if given) or -1 if there is none.
+        int findFirstUnselectedCard() const;
+        int findFirstUnselectedCard( const TCardDescriptor& cardDescriptor ) const;
+
+    private:
+
+        uint32_t           mPackId;
+        std::vector<Card>* mCardSlab;
+        uint32_t           mFirstCard;
+        uint32_t           mCardCount;
+        uint32_t           mSelectedCardCount;
     };
 
 };
@@ -6,6 +6,10 @@
 // Draft template implementation
 //------------------------------------------------------------------------
 
+template<typename C>
+const uint32_t Draft<C>::NO_PACK;
+
+
 template<typename C>
 Draft<C>::Draft( const proto::DraftConfig&                   draftConfig,
                  const DraftCardDispenserSharedPtrVector<C>& cardDispensers,
@@ -17,7 +21,8 @@ Draft<C>::Draft( const proto::DraftConfig&                   draftConfig,
     mCurrentRound( -1 ),
     mPostRoundTimerStarted( false ),
     mPostRoundTimerTicksRemaining( 0 ),
-    mPublicActiveChair( nullptr ),
+    mPublicPackIndex( NO_PACK ),
+    mPublicActiveChairIndex( -1 ),
     mNextPackId( 0 ),
     mProcessingMessageQueue( false ),
     mLogger( loggingConfig.createLogger() )
@@ -31,11 +36,12 @@ Draft<C>::Draft( const proto::DraftConfig&                   draftConfig,
     }
 
     // Create chairs.
+    mChairs.reserve( mDraftConfig.chair_count() );
     for( uint32_t i = 0; i < mDraftConfig.chair_count(); ++i )
     {
-        mChairs.push_back( new Chair(i) );
-        mLogger->debug( "mChairs[{}]={},id={}", i, (std::size_t)mChairs[i], mChairs[i]->getIndex() );
+        mChairs.push_back( Chair(i) );
     }
+    mChairObservers.resize( mDraftConfig.chair_count() );
 }
 
 
@@ -43,10 +49,34 @@ template<typename C>
 Draft<C>::~Draft()
 {
     mLogger->debug( "~Draft" );
-    for( Chair *chairPtr : mChairs )
+}
+
+
+template<typename C>
+void
+Draft<C>::addObserver( Observer* observer )
+{
+    mObservers.push_back( observer );
+    for( auto& chairObservers : mChairObservers )
+    {
+        chairObservers.push_back( observer );
+    }
+}
+
+
+template<typename C>
+bool
+Draft<C>::addChairObserver( int chairIndex, Observer* observer )
+{
+    if( (chairIndex < 0) || (chairIndex >= getChairCount()) )
     {
-        delete chairPtr;
+        mLogger->error( "invalid chair {} for observer", chairIndex );
+        return false;
     }
+
+    mObservers.push_back( observer );
+    mChairObservers[chairIndex].push_back( observer );
+    return true;
 }
 
 
@@ -54,7 +84,11 @@ template<typename C>
 void
 Draft<C>::removeObserver( Observer* observer )
 {
-    mObservers.erase( std::remove( mObservers.begin(), mObservers.end(), observer ) );
+    mObservers.erase( std::remove( mObservers.begin(), mObservers.end(), observer ), mObservers.end() );
+    for( auto& chairObservers : mChairObservers )
+    {
+        chairObservers.erase( std::remove( chairObservers.begin(), chairObservers.end(), observer ), chairObservers.end() );
+    }
 }
 
 
@@ -73,7 +107,7 @@ bool
 Draft<C>::makeNamedCardSelection( int chairIndex, uint32_t packId, const C& cardDescriptor )
 {
     // Check that chair parameter is valid
-    if( (chairIndex < 0) || (chairIndex > getChairCount()) )
+    if( (chairIndex < 0) || (chairIndex >= getChairCount()) )
     {
         mLogger->error( "invalid chair {}", chairIndex );
         return false;
@@ -92,7 +126,7 @@ bool
 Draft<C>::makeIndexedCardSelection( int chairIndex, uint32_t packId, const std::vector<int>& selectionIndices )
 {
     // Check that chair parameter is valid
-    if( (chairIndex < 0) || (chairIndex > getChairCount()) )
+    if( (chairIndex < 0) || (chairIndex >= getChairCount()) )
     {
         mLogger->error( "invalid chair {}", chairIndex );
         return false;
@@ -153,7 +187,7 @@ template<typename C>
 int
 Draft<C>::getTicksRemaining( int chairIndex ) const
 {
-    return ((chairIndex >= 0) && (chairIndex < getChairCount())) ? mChairs[chairIndex]->getTicksRemaining() : -1;
+    return ((chairIndex >= 0) && (chairIndex < getChairCount())) ? mChairs[chairIndex].getTicksRemaining() : -1;
 }
 
 
@@ -161,7 +195,7 @@ template<typename C>
 int
 Draft<C>::getPackQueueSize( int chairIndex ) const
 {
-    return ((chairIndex >= 0) && (chairIndex < getChairCount())) ? mChairs[chairIndex]->getPackQueueSize() : -1;
+    return ((chairIndex >= 0) && (chairIndex < getChairCount())) ? mChairs[chairIndex].getPackQueueSize() : -1;
 }
 
 
@@ -172,9 +206,11 @@ Draft<C>::getSelectedCards( int chairIndex ) const
     std::vector<C> cards;
     if( (chairIndex >= 0) && (chairIndex < getChairCount()) )
     {
-        for( auto card : mChairs[chairIndex]->getSelectedCards() )
+        const std::vector<uint32_t>& cardIndices = mChairs[chairIndex].getSelectedCards();
+        cards.reserve( cardIndices.size() );
+        for( auto cardIndex : cardIndices )
         {
-            cards.push_back( card->getCardDescriptor() );
+            cards.push_back( mCards[cardIndex].getCardDescriptor() );
         }
     }
     return cards;
@@ -186,7 +222,7 @@ uint32_t
 Draft<C>::getTopPackId( int chairIndex ) const
 {
     return (getPackQueueSize( chairIndex ) > 0) ?
-            mChairs[chairIndex]->getTopPack()->getPackId() : 0;
+            mPacks[mChairs[chairIndex].getTopPackIndex()].getPackId() : 0;
 }
 
 
@@ -194,8 +230,12 @@ template<typename C>
 std::vector<C>
 Draft<C>::getTopPackUnselectedCards( int chairIndex ) const
 {
-    return (getPackQueueSize( chairIndex ) > 0) ?
-        mChairs[chairIndex]->getTopPack()->getUnselectedCardDescriptors() : std::vector<C>();
+    std::vector<C> cards;
+    if( getPackQueueSize( chairIndex ) > 0 )
+    {
+        mPacks[mChairs[chairIndex].getTopPackIndex()].getUnselectedCardDescriptors( cards );
+    }
+    return cards;
 }
 
 
@@ -263,7 +303,7 @@ Draft<C>::processNamedCardSelection( int chairIndex, uint32_t packId, const C& c
     mLogger->debug( "got chair {} selection: {}", chairIndex, cardDescriptor );
 
     // Check that chair is valid
-    if( (chairIndex < 0) || (chairIndex > getChairCount()) )
+    if( (chairIndex < 0) || (chairIndex >= getChairCount()) )
     {
         // This should already have been checked!
         mLogger->error( "invalid chair {}", chairIndex );
@@ -275,21 +315,21 @@ Draft<C>::processNamedCardSelection( int chairIndex, uint32_t packId, const C& c
     if( !isBoosterRound() )
     {
         mLogger->warn( "invalid round type" );
-        for( auto obs : mObservers ) 
+        for( auto obs : mChairObservers[chairIndex] ) 
         {
             obs->notifyNamedCardSelectionResult( *this, chairIndex, packId, false, cardDescriptor );
         }
         return;
     }
 
-    Chair *chair = mChairs[chairIndex];
+    Chair& chair = mChairs[chairIndex];
 
     // Get top pack for chair
-    PackSharedPtr pack = chair->getTopPack();
+    Pack* pack = getTopPack( chair );
     if( pack == nullptr )
     {
         mLogger->warn( "no pack available for chair {}", chairIndex );
-        for( auto obs : mObservers ) 
+        for( auto obs : mChairObservers[chairIndex] ) 
         {
             obs->notifyNamedCardSelectionResult( *this, chairIndex, packId, false, cardDescriptor );
         }
@@ -299,7 +339,7 @@ Draft<C>::processNamedCardSelection( int chairIndex, uint32_t packId, const C& c
     if( packId != pack->getPackId() )
     {
         mLogger->warn( "invalid packId ({}) available for chair {} (should be {})", packId, chairIndex, pack->getPackId() );
-        for( auto obs : mObservers ) 
+        for( auto obs : mChairObservers[chairIndex] ) 
         {
             obs->notifyNamedCardSelectionResult( *this, chairIndex, packId, false, cardDescriptor );
         }
@@ -307,11 +347,11 @@ Draft<C>::processNamedCardSelection( int chairIndex, uint32_t packId, const C& c
     }
 
     // Check that card is in current pack for chair and available for selection
-    CardSharedPtr card = pack->getFirstUnselectedCard( cardDescriptor );
-    if( card == nullptr )
+    const int cardIndex = pack->findFirstUnselectedCard( cardDescriptor );
+    if( cardIndex < 0 )
     {
         mLogger->warn( "no unselected card {} in pack {}", cardDescriptor, pack->getPackId() );
-        for( auto obs : mObservers ) 
+        for( auto obs : mChairObservers[chairIndex] ) 
         {
             obs->notifyNamedCardSelectionResult( *this, chairIndex, packId, false, cardDescriptor );
         }
@@ -322,14 +362,13 @@ Draft<C>::processNamedCardSelection( int chairIndex, uint32_t packId, const C& c
     //  - Pop the pack from the chair
     //  - Mark the card selected
     //  - Record the assignment to the chair
-    chair->popTopPack();
-    int selectionIndexInRound = pack->getSelectedCardCount();
-    card->setSelected( chair, mCurrentRound, selectionIndexInRound );
-    chair->addSelectedCard( card );
+    const uint32_t packIndex = chair.getTopPackIndex();
+    chair.popTopPack();
+    selectCardToChair( *pack, cardIndex, chair, pack->getSelectedCardCount() );
 
-    for( auto obs : mObservers ) 
+    for( auto obs : mChairObservers[chairIndex] ) 
     {
-        obs->notifyPackQueueSizeChanged( *this, chairIndex, chair->getPackQueueSize() );
+        obs->notifyPackQueueSizeChanged( *this, chairIndex, chair.getPackQueueSize() );
         obs->notifyNamedCardSelectionResult( *this, chairIndex, packId, true, cardDescriptor );
     }
 
@@ -340,37 +379,36 @@ Draft<C>::processNamedCardSelection( int chairIndex, uint32_t packId, const C& c
     // Enqueue pack to next chair if there are still unselected cards in the pack.
     // Autopick the last card in the pack to the next player.
     int nextChairIndex = getNextChairIndex( chairIndex );
-    Chair *nextChair = mChairs[nextChairIndex];
-    bool nextChairWaiting = (nextChair->getPackQueueSize() == 0);
+    Chair& nextChair = mChairs[nextChairIndex];
+    bool nextChairWaiting = (nextChair.getPackQueueSize() == 0);
 
     if( (pack->getUnselectedCardCount() > 1) && nextChairWaiting )
     {
         // If there is more than 1 card in the pack and the next chair is
         // waiting on a pack: enqueue the pack, start the next chair's
         // timer, and inform the chair.
-        nextChair->enqueuePack( pack );
+        nextChair.enqueuePack( packIndex );
         int ticksRemaining = mDraftConfigAdapter.getBoosterRoundSelectionTime( mCurrentRound, 0 );
-        nextChair->setTicksRemaining( ticksRemaining );
-        for( auto obs : mObservers ) 
+        nextChair.setTicksRemaining( ticksRemaining );
+        pack->getUnselectedCardDescriptors( mScratchCardDescriptors );
+        for( auto obs : mChairObservers[nextChairIndex] ) 
         {
             obs->notifyPackQueueSizeChanged( *this, nextChairIndex,
-                    nextChair->getPackQueueSize() );
+                    nextChair.getPackQueueSize() );
             obs->notifyNewPack( *this, nextChairIndex, pack->getPackId(),
-                    pack->getUnselectedCardDescriptors() );
+                    mScratchCardDescriptors );
         }
     }
     else if( (pack->getUnselectedCardCount() == 1) && nextChairWaiting )
     {
         // If there is only 1 card left and the next chair is waiting, it
         // can be autopicked to that player.
-        CardSharedPtr lastUnselectedCard = pack->getUnselectedCards()[0];
-        int selectionIndexInRound = pack->getSelectedCardCount();
-        lastUnselectedCard->setSelected( nextChair, mCurrentRound, selectionIndexInRound );
-        nextChair->addSelectedCard( lastUnselectedCard );
-        for( auto obs : mObservers ) 
+        const int lastCardIndex = pack->findFirstUnselectedCard();
+        selectCardToChair( *pack, lastCardIndex, nextChair, pack->getSelectedCardCount() );
+        for( auto obs : mChairObservers[nextChairIndex] ) 
         {
             obs->notifyCardAutoselection( *this, nextChairIndex, pack->getPackId(),
-                    lastUnselectedCard->getCardDescriptor() );
+                    pack->getCard( lastCardIndex )->getCardDescriptor() );
         }
     }
     else
@@ -378,10 +416,10 @@ Draft<C>::processNamedCardSelection( int chairIndex, uint32_t packId, const C& c
         // Either there is more than 1 card in the pack or if the next
         // chair is still working on another pack: enqueue the pack to the
         // next chair.
-        nextChair->enqueuePack( pack );
-        for( auto obs : mObservers ) 
+        nextChair.enqueuePack( packIndex );
+        for( auto obs : mChairObservers[nextChairIndex] ) 
         {
-            obs->notifyPackQueueSizeChanged( *this, nextChair->getIndex(), nextChair->getPackQueueSize() );
+            obs->notifyPackQueueSizeChanged( *this, nextChair.getIndex(), nextChair.getPackQueueSize() );
         }
     }
 
@@ -389,33 +427,32 @@ Draft<C>::processNamedCardSelection( int chairIndex, uint32_t packId, const C& c
     // Deal with our next pack...
     //
 
-    if( chair->getPackQueueSize() > 0 )
+    if( chair.getPackQueueSize() > 0 )
     {
-        PackSharedPtr pack = chair->getTopPack();
+        Pack* pack = getTopPack( chair );
         if( pack->getUnselectedCardCount() > 1 )
         {
             int ticksRemaining = mDraftConfigAdapter.getBoosterRoundSelectionTime( mCurrentRound, 0 );
-            chair->setTicksRemaining( ticksRemaining );
-            for( auto obs : mObservers ) 
+            chair.setTicksRemaining( ticksRemaining );
+            pack->getUnselectedCardDescriptors( mScratchCardDescriptors );
+            for( auto obs : mChairObservers[chairIndex] ) 
             {
-                obs->notifyNewPack( *this, chair->getIndex(), pack->getPackId(),
-                        pack->getUnselectedCardDescriptors() );
+                obs->notifyNewPack( *this, chair.getIndex(), pack->getPackId(),
+                        mScratchCardDescriptors );
             }
         }
         else if( pack->getUnselectedCardCount() == 1 )
         {
             // Auto-pick the last card from the pack.
-            chair->popTopPack();
-            CardSharedPtr lastUnselectedCard = pack->getUnselectedCards()[0];
-            int selectionIndexInRound = pack->getSelectedCardCount();
-            lastUnselectedCard->setSelected( chair, mCurrentRound, selectionIndexInRound );
-            chair->addSelectedCard( lastUnselectedCard );
-            for( auto obs : mObservers ) 
+            chair.popTopPack();
+            const int lastCardIndex = pack->findFirstUnselectedCard();
+            selectCardToChair( *pack, lastCardIndex, chair, pack->getSelectedCardCount() );
+            for( auto obs : mChairObservers[chairIndex] ) 
             {
-                obs->notifyPackQueueSizeChanged( *this, chair->getIndex(),
-                        chair->getPackQueueSize() );
+                obs->notifyPackQueueSizeChanged( *this, chair.getIndex(),
+                        chair.getPackQueueSize() );
                 obs->notifyCardAutoselection( *this, chairIndex, pack->getPackId(),
-                        lastUnselectedCard->getCardDescriptor() );
+                        pack->getCard( lastCardIndex )->getCardDescriptor() );
             }
         }
         else
@@ -428,7 +465,7 @@ Draft<C>::processNamedCardSelection( int chairIndex, uint32_t packId, const C& c
 
     // Pack queue could have been empty or just became empty thanks to an
     // auto-pick.
-    if( chair->getPackQueueSize() == 0 )
+    if( chair.getPackQueueSize() == 0 )
     {
         // This could be the end of the round, so check and take action if so.
         checkRoundTransition();
@@ -443,7 +480,7 @@ Draft<C>::processIndexedCardSelection( int chairIndex, uint32_t packId, const st
     mLogger->debug( "got chair {} public selection {}", chairIndex, StringUtil::stringify( selectionIndices ) );
 
     // Check that chair is valid
-    if( (chairIndex < 0) || (chairIndex > getChairCount()) )
+    if( (chairIndex < 0) || (chairIndex >= getChairCount()) )
     {
         // This should already have been checked!
         mLogger->error( "invalid chair {}", chairIndex );
@@ -455,7 +492,7 @@ Draft<C>::processIndexedCardSelection( int chairIndex, uint32_t packId, const st
     if( !isGridRound() )
     {
         mLogger->warn( "invalid round type" );
-        for( auto obs : mObservers ) 
+        for( auto obs : mChairObservers[chairIndex] ) 
         {
             obs->notifyIndexedCardSelectionResult( *this, chairIndex, packId, false, selectionIndices, std::vector<C>() );
         }
@@ -463,35 +500,29 @@ Draft<C>::processIndexedCardSelection( int chairIndex, uint32_t packId, const st
     }
 
     // Check that chair is the active public chair
-    if( mPublicActiveChair != mChairs[chairIndex] )
+    if( mPublicActiveChairIndex != chairIndex )
     {
         mLogger->warn( "chair {} is not the active chair", chairIndex );
-        for( auto obs : mObservers ) 
+        for( auto obs : mChairObservers[chairIndex] ) 
         {
             obs->notifyIndexedCardSelectionResult( *this, chairIndex, packId, false, selectionIndices, std::vector<C>() );
         }
         return;
     }
 
+    Pack& publicPack = mPacks[mPublicPackIndex];
+
     // Convert selection indices vector to set.
     GridHelper::IndexSet selectedIndicesSet( selectionIndices.begin(), selectionIndices.end() );
 
-    // Build set of unavailable indices and vector of selected cards.
+    // Build set of unavailable indices and vector of selected card indices.
     GridHelper::IndexSet unavailableIndices;
-    std::vector<CardSharedPtr> selectedCards;
-    for( std::size_t i = 0; i < mPublicPack->getCardCount(); ++i )
+    std::vector<std::size_t> selectedCardIndices;
+    for( std::size_t i = 0; i < publicPack.getCardCount(); ++i )
     {
-        CardSharedPtr card = mPublicPack->getCard( i );
-        if( card == nullptr )
-        {
-            mLogger->error( "nullptr at card {}!", i );
-            enterDraftErrorState();
-            return;
-        }
-
-        if( card->isSelected() ) unavailableIndices.insert( i );
+        if( publicPack.getCard( i )->isSelected() ) unavailableIndices.insert( i );
 
-        if( selectedIndicesSet.count( i ) > 0 ) selectedCards.push_back( card );
+        if( selectedIndicesSet.count( i ) > 0 ) selectedCardIndices.push_back( i );
     }
 
     GridHelper gridHelper;
@@ -499,7 +530,7 @@ Draft<C>::processIndexedCardSelection( int chairIndex, uint32_t packId, const st
     auto iter = availableSelectionsMap.find( selectedIndicesSet );
     if( iter == availableSelectionsMap.end() )
     {
-        for( auto obs : mObservers ) 
+        for( auto obs : mChairObservers[chairIndex] ) 
         {
             mLogger->warn( "grid selection invalid" );
             obs->notifyIndexedCardSelectionResult( *this, chairIndex, packId, false, selectionIndices, std::vector<C>() );
@@ -511,53 +542,40 @@ Draft<C>::processIndexedCardSelection( int chairIndex, uint32_t packId, const st
 
     // Mark the cards as selected in the pack and create desc vector
     std::vector<C> selectedCardDescs;
-    for( auto card : selectedCards )
+    for( auto i : selectedCardIndices )
     {
-        card->setSelected( mPublicActiveChair, mCurrentRound, mPublicPack->getSelectedCardCount() );
-        selectedCardDescs.push_back( card->getCardDescriptor() );
+        publicPack.selectCard( i, chairIndex, mCurrentRound, publicPack.getSelectedCardCount() );
+        selectedCardDescs.push_back( publicPack.getCard( i )->getCardDescriptor() );
     }
 
     // Send out confirmations
-    for( auto obs : mObservers ) 
+    for( auto obs : mChairObservers[chairIndex] ) 
     {
         obs->notifyIndexedCardSelectionResult( *this, chairIndex, packId, true, selectionIndices, selectedCardDescs );
     }
 
     // Clear timer for active chair
-    mPublicActiveChair->setTicksRemaining( 0 );
+    mChairs[mPublicActiveChairIndex].setTicksRemaining( 0 );
 
     // Set active chair to next, allowing for end of selections
-    int activeChairIndex;
     if( !isSelectionComplete() )
     {
-        activeChairIndex = getNextChairIndex( mPublicActiveChair->getIndex() );
-        mPublicActiveChair = mChairs[ activeChairIndex ];
+        mPublicActiveChairIndex = getNextChairIndex( mPublicActiveChairIndex );
 
         // Reset timer for active chair
         int ticksRemaining = mDraftConfigAdapter.getGridRoundSelectionTime( mCurrentRound, 0 );
-        mPublicActiveChair->setTicksRemaining( ticksRemaining );
+        mChairs[mPublicActiveChairIndex].setTicksRemaining( ticksRemaining );
     }
     else
     {
-        activeChairIndex = -1;
-        mPublicActiveChair = nullptr;
-    }
-  
-    // Create current public pack state
-    std::vector<typename Observer::PublicCardState> cardStates;
-    for( std::size_t i = 0; i < mPublicPack->getCardCount(); ++i )
-    {
-        CardSharedPtr card = mPublicPack->getCard( i );
-        int selectedChairIndex = (card->getSelectedChair() != nullptr) ? card->getSelectedChair()->getIndex() : -1;
-        typename Observer::PublicCardState state( card->getCardDescriptor(), selectedChairIndex,
-                card->getSelectedIndexInRound() );
-        cardStates.push_back( state );
+        mPublicActiveChairIndex = -1;
     }
 
     // Notify players of public state.
+    updatePublicCardStates();
     for( auto obs : mObservers ) 
     {
-        obs->notifyPublicState( *this, mPublicPack->getPackId(), cardStates, activeChairIndex );
+        obs->notifyPublicState( *this, publicPack.getPackId(), mScratchPublicCardStates, mPublicActiveChairIndex );
     }
 
     // This could be the end of the round, so check and take action if so.
@@ -582,18 +600,17 @@ Draft<C>::processTick()
     else if( mDraftConfigAdapter.getBoosterRoundSelectionTime( mCurrentRound, 0 ) > 0 )
     {
         // Booster round: tick chair timers, but only if configured for timeouts
-        for( auto chair : mChairs )
+        for( auto& chair : mChairs )
         {
             // Don't tick unless there are packs on a chair's queue.
-            if( chair->getPackQueueSize() > 0 )
+            if( chair.getPackQueueSize() > 0 )
             {
-                chair->setTicksRemaining( chair->getTicksRemaining() - 1);
-                if( chair->getTicksRemaining() <= 0 )
+                chair.setTicksRemaining( chair.getTicksRemaining() - 1);
+                if( chair.getTicksRemaining() <= 0 )
                 {
-                    for( auto obs : mObservers ) 
+                    for( auto obs : mChairObservers[chair.getIndex()] ) 
                     {
-                        PackSharedPtr pack = chair->getTopPack();
-                        obs->notifyTimeExpired( *this, chair->getIndex(), pack->getPackId() );
+                        obs->notifyTimeExpired( *this, chair.getIndex(), getTopPack( chair )->getPackId() );
                     }
                 }
             }
@@ -602,12 +619,13 @@ Draft<C>::processTick()
     else if( mDraftConfigAdapter.getGridRoundSelectionTime( mCurrentRound, 0 ) > 0 )
     {
         // Grid round: tick active chair's timer, but only if configured for timeouts
-        mPublicActiveChair->setTicksRemaining( mPublicActiveChair->getTicksRemaining() - 1 );
-        if( mPublicActiveChair->getTicksRemaining() <= 0 )
+        Chair& activeChair = mChairs[mPublicActiveChairIndex];
+        activeChair.setTicksRemaining( activeChair.getTicksRemaining() - 1 );
+        if( activeChair.getTicksRemaining() <= 0 )
         {
-            for( auto obs : mObservers ) 
+            for( auto obs : mChairObservers[mPublicActiveChairIndex] ) 
             {
-                obs->notifyTimeExpired( *this, mPublicActiveChair->getIndex(), mPublicPack->getPackId() );
+                obs->notifyTimeExpired( *this, activeChair.getIndex(), mPacks[mPublicPackIndex].getPackId() );
             }
         }
     }
@@ -635,42 +653,44 @@ Draft<C>::startNewRound()
         obs->notifyNewRound( *this, mCurrentRound );
     }
 
-    mPublicActiveChair = nullptr;
+    mPublicActiveChairIndex = -1;
 
     const proto::DraftConfig::Round& roundConfig = mDraftConfig.rounds( mCurrentRound );
     if( roundConfig.has_booster_round() &&
         roundConfig.booster_round().dispensations_size() > 0 )
     {
         // Create packs for each chair.
+        mPacks.reserve( mPacks.size() + getChairCount() );
         for( int i = 0; i < getChairCount(); ++i )
         {
-            PackSharedPtr pack = createPackFromDispensations( i, roundConfig.booster_round().dispensations() );
+            uint32_t packIndex = createPackFromDispensations( i, roundConfig.booster_round().dispensations() );
 
             // Enqueue the pack and notify if it was created.
-            if( pack )
+            if( packIndex != NO_PACK )
             {
-                mChairs[i]->enqueuePack( pack );
-                for( auto obs : mObservers ) 
+                mChairs[i].enqueuePack( packIndex );
+                for( auto obs : mChairObservers[i] ) 
                 {
-                    obs->notifyPackQueueSizeChanged( *this, i, mChairs[i]->getPackQueueSize() );
+                    obs->notifyPackQueueSizeChanged( *this, i, mChairs[i].getPackQueueSize() );
                 }
             }
         }
 
         // Reset timers and notify players to start making decisions.
-        for( auto chair : mChairs )
+        for( auto& chair : mChairs )
         {
             int ticksRemaining = mDraftConfigAdapter.getBoosterRoundSelectionTime( mCurrentRound, 0 );
-            chair->setTicksRemaining( ticksRemaining );
+            chair.setTicksRemaining( ticksRemaining );
 
-            for( auto obs : mObservers ) 
+            // Notify any chairs that have packs queued.
+            if( chair.getPackQueueSize() > 0 )
             {
-                // Notify any chairs that have packs queued.
-                if( chair->getPackQueueSize() > 0 )
+                Pack* pack = getTopPack( chair );
+                pack->getUnselectedCardDescriptors( mScratchCardDescriptors );
+                for( auto obs : mChairObservers[chair.getIndex()] ) 
                 {
-                    PackSharedPtr pack = chair->getTopPack();
-                    obs->notifyNewPack( *this, chair->getIndex(), pack->getPackId(),
-                            pack->getUnselectedCardDescriptors() );
+                    obs->notifyNewPack( *this, chair.getIndex(), pack->getPackId(),
+                            mScratchCardDescriptors );
                 }
             }
         }
@@ -680,22 +700,21 @@ Draft<C>::startNewRound()
         roundConfig.sealed_round().dispensations_size() > 0 )
     {
         // Create packs for each chair.
+        mPacks.reserve( mPacks.size() + getChairCount() );
         for( int i = 0; i < getChairCount(); ++i )
         {
-            PackSharedPtr pack = createPackFromDispensations( i, roundConfig.sealed_round().dispensations() );
+            uint32_t packIndex = createPackFromDispensations( i, roundConfig.sealed_round().dispensations() );
 
-            if( pack )
+            if( packIndex != NO_PACK )
             {
-                auto cards = pack->getUnselectedCards();  // same as all cards in the new pack
-                for( auto c : cards )
+                // Auto-select all cards in the new pack to chair and notify.
+                Pack& pack = mPacks[packIndex];
+                for( std::size_t c = 0; c < pack.getCardCount(); ++c )
                 {
-                    // Auto-select cards to chair and notify.
-                    auto chair = mChairs[i];
-                    c->setSelected( chair, mCurrentRound, 0 );
-                    chair->addSelectedCard( c );
-                    for( auto obs : mObservers ) 
+                    selectCardToChair( pack, c, mChairs[i], 0 );
+                    for( auto obs : mChairObservers[i] ) 
                     {
-                        obs->notifyCardAutoselection( *this, i, pack->getPackId(), c->getCardDescriptor() );
+                        obs->notifyCardAutoselection( *this, i, pack.getPackId(), pack.getCard( c )->getCardDescriptor() );
                     }
                 }
             }
@@ -704,7 +723,7 @@ Draft<C>::startNewRound()
     else if( roundConfig.has_grid_round() &&
         roundConfig.grid_round().dispenser_index() < mCardDispensers.size() )
     {
-        mPublicPack = createGridPackFromDispenser( roundConfig.grid_round().dispenser_index() );
+        mPublicPackIndex = createGridPackFromDispenser( roundConfig.grid_round().dispenser_index() );
 
         // Set the active chair
         if( roundConfig.grid_round().initial_chair() >= mChairs.size() )
@@ -713,27 +732,17 @@ Draft<C>::startNewRound()
             enterDraftErrorState();
             return;
         }
-        mPublicActiveChair = mChairs[ roundConfig.grid_round().initial_chair() ];
+        mPublicActiveChairIndex = roundConfig.grid_round().initial_chair();
 
         // Reset timer for active chair
         int ticksRemaining = mDraftConfigAdapter.getGridRoundSelectionTime( mCurrentRound, 0 );
-        mPublicActiveChair->setTicksRemaining( ticksRemaining );
-
-        // Create public pack state
-        std::vector<typename Observer::PublicCardState> cardStates;
-        for( std::size_t i = 0; i < mPublicPack->getCardCount(); ++i )
-        {
-            CardSharedPtr card = mPublicPack->getCard( i );
-            int selectedChairIndex = (card->getSelectedChair() != nullptr) ? card->getSelectedChair()->getIndex() : -1;
-            typename Observer::PublicCardState state( card->getCardDescriptor(), selectedChairIndex,
-                    card->getSelectedIndexInRound() );
-            cardStates.push_back( state );
-        }
+        mChairs[mPublicActiveChairIndex].setTicksRemaining( ticksRemaining );
 
         // Notify players of public state.
+        updatePublicCardStates();
         for( auto obs : mObservers ) 
         {
-            obs->notifyPublicState( *this, mPublicPack->getPackId(), cardStates, mPublicActiveChair->getIndex() );
+            obs->notifyPublicState( *this, mPacks[mPublicPackIndex].getPackId(), mScratchPublicCardStates, mPublicActiveChairIndex );
         }
     }
     else
@@ -751,16 +760,16 @@ Draft<C>::startNewRound()
 }
 
 
-// Create a pack based on dispensations.  The returned pack may be empty
-// (nullptr) due to:
+// Create a pack based on dispensations.  The returned pack index may be
+// NO_PACK due to:
 //   - no dispensation for the chair index, or
 //   - errors in dispensation configuration (i.e. invalid dispenser indices or quantities)
 template<typename C>
-typename Draft<C>::PackSharedPtr
+uint32_t
 Draft<C>::createPackFromDispensations( int                                     chairIndex,
                                        const CardDispensationRepeatedPtrField& dispensations )
 {
-    PackSharedPtr pack;
+    uint32_t packIndex = NO_PACK;
 
     // Go through each dispensation looking for stuff for this chair.
     for( auto iter = dispensations.begin(); iter != dispensations.end(); ++iter )
@@ -791,47 +800,51 @@ Draft<C>::createPackFromDispensations( int                                     c
             }
 
             // We are going to be adding cards to a pack, so create the pack if we haven't already.
-            if( !pack ) pack = std::make_shared<Pack>( mNextPackId++ );
+            if( packIndex == NO_PACK )
+            {
+                packIndex = mPacks.size();
+                mPacks.push_back( Pack( mNextPackId++, &mCards ) );
+            }
             const std::vector<C> cardDescs = dispenseAll ?
                                              mCardDispensers[cardDispenserIndex]->dispenseAll() :
                                              mCardDispensers[cardDispenserIndex]->dispense( quantity );
             for( auto& cardDesc : cardDescs )
             {
-                CardSharedPtr c = std::make_shared<Card>( cardDesc );
-                pack->addCard( c );
+                mPacks[packIndex].addCard( cardDesc );
             }
         }
     }
 
-    return pack;
+    return packIndex;
 }
 
 
 template<typename C>
-typename Draft<C>::PackSharedPtr
+uint32_t
 Draft<C>::createGridPackFromDispenser( uint32_t cardDispenserIndex )
 {
     const uint32_t GRID_CARD_COUNT = 9;
 
-    PackSharedPtr pack = std::make_shared<Pack>( mNextPackId++ );
+    const uint32_t packIndex = mPacks.size();
+    mPacks.push_back( Pack( mNextPackId++, &mCards ) );
+    Pack& pack = mPacks.back();
 
     // Check that the index is legal.
     if( cardDispenserIndex >= mCardDispensers.size() )
     {
         mLogger->error( "invalid card dispenser index! ({})", cardDispenserIndex );
         enterDraftErrorState();
-        return pack;
+        return packIndex;
     }
 
     // Generate cards for the grid.
     const std::vector<C> cardDescs = mCardDispensers[cardDispenserIndex]->dispense( GRID_CARD_COUNT );
     for( auto& cardDesc : cardDescs )
     {
-        CardSharedPtr c = std::make_shared<Card>( cardDesc );
-        pack->addCard( c );
+        pack.addCard( cardDesc );
     }
 
-    return pack;
+    return packIndex;
 }
 
 
@@ -842,33 +855,28 @@ Draft<C>::isSelectionComplete()
     if( isBoosterRound() )
     {
         // Booster rounds are incomplete if there's a pack on any queue.
-        for( auto chair : mChairs )
+        for( const auto& chair : mChairs )
         {
-            if( chair->getTopPack() != nullptr ) return false;
+            if( chair.getPackQueueSize() > 0 ) return false;
         }
     }
 
     if( isGridRound() )
     {
         // Grid rounds are incomplete if any chair has yet to select a card.
-        std::set<const Chair*> allChairs( mChairs.begin(), mChairs.end() );
-        std::set<const Chair*> selectedChairs;
-
-        // Go through every card and add its owner to a set.
-        for( std::size_t i = 0; i < mPublicPack->getCardCount(); ++i )
+        // Go through every card and mark its owner.
+        const Pack& publicPack = mPacks[mPublicPackIndex];
+        std::vector<bool> chairsSelected( mChairs.size(), false );
+        for( std::size_t i = 0; i < publicPack.getCardCount(); ++i )
         {
-            CardSharedPtr c = mPublicPack->getCard( i );
-            if( c != nullptr )
+            const int selectedChairIndex = publicPack.getCard( i )->getSelectedChairIndex();
+            if( selectedChairIndex >= 0 )
             {
-                const Chair* selectedChair = c->getSelectedChair();
-                if( selectedChair != nullptr )
-                {
-                    selectedChairs.insert( selectedChair );
-                }
+                chairsSelected[selectedChairIndex] = true;
             }
         }
 
-        if( allChairs != selectedChairs ) return false;
+        if( std::find( chairsSelected.begin(), chairsSelected.end(), false ) != chairsSelected.end() ) return false;
     }
 
     return true;
@@ -883,7 +891,7 @@ Draft<C>::checkRoundTransition()
     if( !isSelectionComplete() ) return false;
 
     // Round is over when the post-round timer has expired.
-    if( mPostRoundTimerTicksRemaining == 0 ) 
+    if( mPostRoundTimerTicksRemaining == 0 )
     {
         mLogger->debug( "round complete" );
 
@@ -922,6 +930,38 @@ Draft<C>::checkRoundTransition()
 }
 
 
+template<typename C>
+typename Draft<C>::Pack*
+Draft<C>::getTopPack( const Chair& chair )
+{
+    return (chair.getPackQueueSize() > 0) ? &mPacks[chair.getTopPackIndex()] : nullptr;
+}
+
+
+template<typename C>
+void
+Draft<C>::selectCardToChair( Pack& pack, std::size_t index, Chair& chair, int indexInRound )
+{
+    pack.selectCard( index, chair.getIndex(), mCurrentRound, indexInRound );
+    chair.addSelectedCard( pack.getCardSlabIndex( index ) );
+}
+
+
+template<typename C>
+void
+Draft<C>::updatePublicCardStates()
+{
+    const Pack& publicPack = mPacks[mPublicPackIndex];
+    mScratchPublicCardStates.clear();
+    for( std::size_t i = 0; i < publicPack.getCardCount(); ++i )
+    {
+        const Card* card = publicPack.getCard( i );
+        mScratchPublicCardStates.push_back( typename Observer::PublicCardState( card->getCardDescriptor(),
+                card->getSelectedChairIndex(), card->getSelectedIndexInRound() ) );
+    }
+}
+
+
 template<typename C>
 int
 Draft<C>::getNextChairIndex( int thisChairIndex )
@@ -958,17 +998,17 @@ Draft<C>::Chair::Chair( int index )
 
 template<typename C>
 void
-Draft<C>::Chair::enqueuePack( PackSharedPtr pack )
+Draft<C>::Chair::enqueuePack( uint32_t packIndex )
 {
-    mPackQueue.push( pack );
+    mPackQueue.push( packIndex );
 }
 
-// Return top pack or null if empty.
+// Return top pack index or NO_PACK if empty.
 template<typename C>
-typename::Draft<C>::PackSharedPtr
-Draft<C>::Chair::getTopPack()
+uint32_t
+Draft<C>::Chair::getTopPackIndex() const
 {
-    return !mPackQueue.empty() ? mPackQueue.front() : PackSharedPtr(nullptr);
+    return !mPackQueue.empty() ? mPackQueue.front() : NO_PACK;
 }
 
 template<typename C>
@@ -980,9 +1020,9 @@ Draft<C>::Chair::popTopPack()
 
 template<typename C>
 void
-Draft<C>::Chair::addSelectedCard( CardSharedPtr card )
+Draft<C>::Chair::addSelectedCard( uint32_t cardIndex )
 {
-    mSelectedCards.push_back( card );
+    mSelectedCards.push_back( cardIndex );
 }
 
 
@@ -993,82 +1033,68 @@ Draft<C>::Chair::addSelectedCard( CardSharedPtr card )
 
 template<typename C>
 void
-Draft<C>::Pack::addCard( CardSharedPtr spCard )
+Draft<C>::Pack::addCard( const C& cardDescriptor )
 {
-    mCards.push_back( spCard );
+    mCardSlab->push_back( Card( cardDescriptor ) );
+    ++mCardCount;
 }
 
 template<typename C>
-typename Draft<C>::CardSharedPtr
+const typename Draft<C>::Card*
 Draft<C>::Pack::getCard( std::size_t index ) const
 {
-    return (index < mCards.size()) ? mCards[index] : nullptr;
+    return (index < mCardCount) ? &(*mCardSlab)[mFirstCard + index] : nullptr;
 }
 
 template<typename C>
-std::size_t
-Draft<C>::Pack::getUnselectedCardCount() const
+void
+Draft<C>::Pack::selectCard( std::size_t index, int chairIndex, int round, int indexInRound )
 {
-    return std::count_if(
-            mCards.begin(),
-            mCards.end(),
-            [] (const CardSharedPtr& card) { return !card->isSelected(); } );
+    Card& card = (*mCardSlab)[mFirstCard + index];
+    if( !card.isSelected() ) ++mSelectedCardCount;
+    card.setSelected( chairIndex, round, indexInRound );
 }
 
 template<typename C>
-std::size_t
-Draft<C>::Pack::getSelectedCardCount() const
+typename Draft<C>::UnselectedCardRange
+Draft<C>::Pack::getUnselectedCards() const
 {
-    return getCardCount() - getUnselectedCardCount();
+    const Card* first = mCardSlab->data() + mFirstCard;
+    return UnselectedCardRange( first, first + mCardCount );
 }
 
 template<typename C>
-std::vector<C>
-Draft<C>::Pack::getCardDescriptors() const
+void
+Draft<C>::Pack::getUnselectedCardDescriptors( std::vector<C>& cardDescriptors ) const
 {
-    std::vector<C> cardDescriptors;
-    for( auto c : mCards )
+    cardDescriptors.clear();
+    for( const Card& card : getUnselectedCards() )
     {
-        cardDescriptors.push_back( c->getCardDescriptor() );
+        cardDescriptors.push_back( card.getCardDescriptor() );
     }
-    return cardDescriptors;
 }
 
 template<typename C>
-std::vector<typename Draft<C>::CardSharedPtr>
-Draft<C>::Pack::getUnselectedCards() const
-{
-    std::vector<CardSharedPtr> cards;
-    std::copy_if(
-            mCards.begin(),
-            mCards.end(),
-            std::back_inserter(cards),
-            [] (const CardSharedPtr& card) { return !card->isSelected(); } );
-    return cards;
-}
-
-template<typename C>
-std::vector<C>
-Draft<C>::Pack::getUnselectedCardDescriptors() const
+int
+Draft<C>::Pack::findFirstUnselectedCard() const
 {
-    std::vector<CardSharedPtr> cards = getUnselectedCards();
-    std::vector<C> cardDescriptors;
-    for( auto c : cards )
+    for( std::size_t i = 0; i < mCardCount; ++i )
     {
-        cardDescriptors.push_back( c->getCardDescriptor() );
+        if( !(*mCardSlab)[mFirstCard + i].isSelected() ) return i;
     }
-    return cardDescriptors;
+    return -1;
 }
 
 template<typename C>
-typename Draft<C>::CardSharedPtr
-Draft<C>::Pack::getFirstUnselectedCard( const C& cardDescriptor )
+int
+Draft<C>::Pack::findFirstUnselectedCard( const C& cardDescriptor ) const
 {
-    for( auto card : mCards )
+    for( std::size_t i = 0; i < mCardCount; ++i )
     {
-        if( (card->getCardDescriptor() == cardDescriptor) && !card->isSelected() ) return card;
+        const Card& card = (*mCardSlab)[mFirstCard + i];
+        if( (card.getCardDescriptor() == cardDescriptor) && !card.isSelected() ) return i;
     }
-    return CardSharedPtr();
+    return -1;
 }
 
 
@@ -1079,10 +1105,9 @@ Draft<C>::Pack::getFirstUnselectedCard( const C& cardDescriptor )
 
 template<typename C>
 void
-Draft<C>::Card::setSelected( const Chair* const chairPtr, int round, int indexInRound )
+Draft<C>::Card::setSelected( int chairIndex, int round, int indexInRound )
 {
-    mSelectedChairPtr = chairPtr;
+    mSelectedChairIndex = chairIndex;
     mSelectedRound = round;
     mSelectedIndexInRound = indexInRound;
 }
-
@@ -3,6 +3,9 @@
 
 #include "Draft.h"
 
+// Observer for a single chair.  Register with Draft::addChairObserver()
+// so the draft only dispatches this chair's notifications; the chair
+// checks below also make it safe to use as a global observer.
 template< typename TCardDescriptor = std::string >
 class DraftChairObserver : public Draft<TCardDescriptor>::Observer {
 public:
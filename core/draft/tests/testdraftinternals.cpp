@@ -10,21 +10,20 @@
 
 CATCH_TEST_CASE( "Packs (private)", "[draft]" )
 {
-    Draft<>::Pack p(0);
-    std::vector<Draft<>::CardSharedPtr> cards;
-    for( int i = 0; i < 15; ++i )
-    {
-        Draft<>::CardSharedPtr c( new Draft<>::Card( "card" + std::to_string(i) ) );
-        cards.push_back( c );
-    }
+    std::vector<Draft<>::Card> cardSlab;
 
-    for( auto card : cards )
+    // A card from an earlier pack already in the slab.
+    cardSlab.push_back( Draft<>::Card( "earlier" ) );
+
+    Draft<>::Pack p( 0, &cardSlab );
+    for( int i = 0; i < 15; ++i )
     {
-        p.addCard( card );
+        p.addCard( "card" + std::to_string(i) );
     }
 
     CATCH_SECTION( "Check initial assumptions" )
     {
+        CATCH_REQUIRE( cardSlab.size() == 16 );
         CATCH_REQUIRE( p.getCardCount() == 15 );
         CATCH_REQUIRE( p.getUnselectedCardCount() == 15 );
         CATCH_REQUIRE( p.getSelectedCardCount() == 0 );
@@ -32,45 +31,54 @@ CATCH_TEST_CASE( "Packs (private)", "[draft]" )
         for( std::size_t i = 0; i < p.getCardCount(); ++i )
         {
             CATCH_REQUIRE( p.getCard(i) != nullptr );
+            CATCH_REQUIRE( p.getCard(i)->getCardDescriptor() == "card" + std::to_string(i) );
+            CATCH_REQUIRE( p.getCardSlabIndex(i) == i + 1 );
         }
         CATCH_REQUIRE( p.getCard( p.getCardCount() ) == nullptr );
+
+        CATCH_REQUIRE( p.findFirstUnselectedCard() == 0 );
+        CATCH_REQUIRE( p.findFirstUnselectedCard( "card7" ) == 7 );
+        CATCH_REQUIRE( p.findFirstUnselectedCard( "earlier" ) == -1 );
     }
 
     CATCH_SECTION( "A card is selected from the middle" )
     {
-        Draft<>::Chair* chairPtr = new Draft<>::Chair(0);
-
-        CATCH_REQUIRE_FALSE( cards[10]->isSelected() );
-        cards[10]->setSelected( chairPtr, 0, 0 );
-        CATCH_REQUIRE( cards[10]->isSelected() );
+        CATCH_REQUIRE_FALSE( p.getCard(10)->isSelected() );
+        p.selectCard( 10, 3, 0, 0 );
+        CATCH_REQUIRE( p.getCard(10)->isSelected() );
 
         CATCH_CHECK( p.getCardCount() == 15 );
         CATCH_CHECK( p.getUnselectedCardCount() == 14 );
         CATCH_CHECK( p.getSelectedCardCount() == 1 );
 
-        Draft<>::CardSharedPtr card;
-        card = p.getCard( 10 );
-        CATCH_CHECK( card->getSelectedChair() == chairPtr );
-
-        card = p.getCard( 11 );
-        CATCH_CHECK( card->getSelectedChair() == nullptr );
+        CATCH_CHECK( p.getCard( 10 )->getSelectedChairIndex() == 3 );
+        CATCH_CHECK( p.getCard( 11 )->getSelectedChairIndex() == -1 );
+        CATCH_CHECK( p.findFirstUnselectedCard( "card10" ) == -1 );
 
-        delete chairPtr;
+        std::vector<std::string> descs;
+        p.getUnselectedCardDescriptors( descs );
+        CATCH_REQUIRE( descs.size() == 14 );
+        CATCH_CHECK( std::find( descs.begin(), descs.end(), "card10" ) == descs.end() );
+        CATCH_CHECK( descs.front() == "card0" );
+        CATCH_CHECK( descs.back() == "card14" );
     }
 
     CATCH_SECTION( "The pack is drained" )
     {
-        Draft<>::Chair* chairPtr = new Draft<>::Chair(0);
-
         while( p.getUnselectedCardCount() > 0 )
         {
-            p.getUnselectedCards()[0]->setSelected( chairPtr, 0, 0 );
+            p.selectCard( p.findFirstUnselectedCard(), 0, 0, p.getSelectedCardCount() );
         }
         CATCH_CHECK( p.getCardCount() == 15 );
         CATCH_CHECK( p.getUnselectedCardCount() == 0 );
         CATCH_CHECK( p.getSelectedCardCount() == 15 );
+        CATCH_CHECK( p.findFirstUnselectedCard() == -1 );
+
+        auto unselected = p.getUnselectedCards();
+        CATCH_CHECK( unselected.begin() == unselected.end() );
 
-        delete chairPtr;
+        // Earlier cards in the slab are untouched.
+        CATCH_CHECK_FALSE( cardSlab[0].isSelected() );
     }
 
 }
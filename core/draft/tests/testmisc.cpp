@@ -314,3 +314,78 @@ CATCH_TEST_CASE( "Booster draft with varying dispensation qty", "[draft][misc]"
     }
 }
 
+
+
+CATCH_TEST_CASE( "Chair observers", "[draft][misc]" )
+{
+    class ChairTestDraftObserver : public TestDraftObserver
+    {
+    public:
+        ChairTestDraftObserver( int chairIndex = -1 )
+          : mChairIndex( chairIndex ), mForeignNotifications( 0 ), mNewPacks( 0 ), mComplete( false ) {}
+        virtual void notifyNewPack( Draft<>& draft, int chairIndex, uint32_t packId,
+                const std::vector<std::string>& unselectedCards ) override
+        {
+            if( (mChairIndex >= 0) && (chairIndex != mChairIndex) ) ++mForeignNotifications;
+            ++mNewPacks;
+            if( mChairIndex >= 0 ) draft.makeNamedCardSelection( chairIndex, packId, unselectedCards[0] );
+        }
+        virtual void notifyNamedCardSelectionResult( Draft<>& draft, int chairIndex,
+                uint32_t packId, bool result, const std::string& card ) override
+        {
+            if( (mChairIndex >= 0) && (chairIndex != mChairIndex) ) ++mForeignNotifications;
+        }
+        virtual void notifyPackQueueSizeChanged( Draft<>& draft, int chairIndex, int packQueueSize ) override
+        {
+            if( (mChairIndex >= 0) && (chairIndex != mChairIndex) ) ++mForeignNotifications;
+        }
+        virtual void notifyDraftComplete( Draft<>& draft ) override
+        {
+            mComplete = true;
+        }
+        const int mChairIndex;
+        unsigned int mForeignNotifications;
+        unsigned int mNewPacks;
+        bool mComplete;
+    };
+
+    DraftConfig dc = TestDefaults::getSimpleBoosterDraftConfig( 3, 4, 60 );
+    auto dispensers = TestDefaults::getDispensers();
+    Draft<> d( dc, dispensers );
+
+    CATCH_REQUIRE_FALSE( d.addChairObserver( -1, nullptr ) );
+    CATCH_REQUIRE_FALSE( d.addChairObserver( 4, nullptr ) );
+
+    ChairTestDraftObserver globalObs;
+    d.addObserver( &globalObs );
+
+    std::vector<ChairTestDraftObserver> chairObs = { 0, 1, 2, 3 };
+    for( auto& obs : chairObs )
+    {
+        CATCH_REQUIRE( d.addChairObserver( obs.mChairIndex, &obs ) );
+    }
+
+    d.start();
+    CATCH_REQUIRE( d.getState() == Draft<>::STATE_COMPLETE );
+
+    unsigned int chairNewPacks = 0;
+    for( auto& obs : chairObs )
+    {
+        CATCH_CHECK( obs.mForeignNotifications == 0 );
+        CATCH_CHECK( obs.mNewPacks > 0 );
+        CATCH_CHECK( obs.mComplete );
+        chairNewPacks += obs.mNewPacks;
+    }
+
+    // The global observer sees every chair's notifications.
+    CATCH_CHECK( globalObs.mNewPacks == chairNewPacks );
+    CATCH_CHECK( globalObs.mComplete );
+
+    // Removed chair observers are no longer notified.
+    Draft<> d2( dc, dispensers );
+    ChairTestDraftObserver removedObs( 0 );
+    d2.addChairObserver( 0, &removedObs );
+    d2.removeObserver( &removedObs );
+    d2.start();
+    CATCH_CHECK( removedObs.mNewPacks == 0 );
+}
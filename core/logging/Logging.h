@@ -2,21 +2,78 @@
 #define LOGGING_H
 
 #include "spdlog/spdlog.h"
+#include "spdlog/async_logger.h"
 #include "spdlog/sinks/null_sink.h"
 
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+// Log at trace or debug level only if the logger would log at that level,
+// so that the arguments aren't evaluated otherwise.  Use these where the
+// arguments are costly to compute (e.g. hex dumps of messages).
+#define LOGGER_TRACE( logger, ... ) \
+    do { if( (logger)->should_log( spdlog::level::trace ) ) (logger)->trace( __VA_ARGS__ ); } while( 0 )
+#define LOGGER_DEBUG( logger, ... ) \
+    do { if( (logger)->should_log( spdlog::level::debug ) ) (logger)->debug( __VA_ARGS__ ); } while( 0 )
+
 namespace Logging
 {
+    // All loggers with logging turned off share one logger.
     inline std::shared_ptr<spdlog::logger> createNullLogger()
     {
-        auto sink = std::make_shared<spdlog::sinks::null_sink_st>();
-        auto logger = std::make_shared<spdlog::logger>( "", sink );
+        static const std::shared_ptr<spdlog::logger> logger = []() {
+                auto nullLogger = std::make_shared<spdlog::logger>( "",
+                        std::make_shared<spdlog::sinks::null_sink_mt>() );
+                nullLogger->set_level( spdlog::level::off );
+                return nullLogger;
+            }();
         return logger;
     }
 
+    // Logger that hands its messages to a shared asynchronous backend: a
+    // bounded lock-free queue drained by a background thread, which
+    // formats the messages and writes them to the sinks.  Any number of
+    // loggers may share a backend and its thread.
+    class AsyncLogger : public spdlog::logger
+    {
+    public:
+
+        using Backend = spdlog::details::async_log_helper;
+
+        template<class It>
+        AsyncLogger( const std::string&              name,
+                     const It&                       sinksBegin,
+                     const It&                       sinksEnd,
+                     const std::shared_ptr<Backend>& backend )
+          : spdlog::logger( name, sinksBegin, sinksEnd ),
+            mBackend( backend )
+        {}
+
+        virtual void flush() override { mBackend->flush(); }
+
+    protected:
+
+        virtual void _log_msg( spdlog::details::log_msg& msg ) override { mBackend->log( msg ); }
+
+    private:
+
+        std::shared_ptr<Backend> mBackend;
+    };
+
     class Config
     {
     public:
 
+        // Messages queued for asynchronous logging before callers block.
+        // Must be a power of two.
+        static const std::size_t ASYNC_QUEUE_SIZE = 16384;
+
+        // Sinks written asynchronously are flushed at least this often.
+        static const int ASYNC_FLUSH_INTERVAL_MILLIS = 1000;
+
         // Default constructor creates a do-nothing configuration.
         Config()
           : mStdoutLogging( false ),
@@ -26,6 +83,7 @@ namespace Logging
             mRotatingFileSizeLimit( 0 ),
             mRotatingFileCount( 0 ),
             mAppendThisAddr( false ),
+            mAsyncLogging( false ),
             mLevel( spdlog::level::off )
         {}
 
@@ -49,37 +107,79 @@ namespace Logging
 
         void setAppendThisAddr( bool enabled ) { mAppendThisAddr = enabled; }
 
+        // Log through a background thread rather than writing to sinks
+        // on the logging thread.  Messages still queued at exit are
+        // written before the process ends.
+        void setAsyncLogging( bool enabled ) { mAsyncLogging = enabled; }
+
         // create a logger that complies with this policy
         // return a null logger if no logger needed
+        //
+        // Loggers are shared: configurations with the same name and
+        // policy get the same logger while it is in use.
         std::shared_ptr<spdlog::logger> createLogger() const
         {
-            if( !mStdoutLogging && mSimpleFileName.empty() && mRotatingFileBaseName.empty() )
+            if( (mLevel == spdlog::level::off) ||
+                (!mStdoutLogging && mSimpleFileName.empty() && mRotatingFileBaseName.empty()) )
             {
                 return createNullLogger();
             }
+
+            const std::string sinksKey = getSinksKey();
+            const std::string loggerKey = mName + '\n' + std::to_string( mLevel ) + '\n' + sinksKey;
+
+            std::lock_guard<std::mutex> lock( getLoggerMapMutex() );
+            LoggerMap& loggerMap = getLoggerMap();
+            auto iter = loggerMap.find( loggerKey );
+            if( iter != loggerMap.end() )
+            {
+                std::shared_ptr<spdlog::logger> logger = iter->second.lock();
+                if( logger ) return logger;
+            }
+
+            std::vector<spdlog::sink_ptr> sinks;
+            if( mStdoutLogging )
+            {
+                sinks.push_back( spdlog::sinks::stdout_sink_mt::instance() );
+            }
+            if( !mSimpleFileName.empty() )
+            {
+                sinks.push_back( getSimpleFileSink( mSimpleFileName ) );
+            }
+            if( !mRotatingFileBaseName.empty() )
+            {
+                sinks.push_back( getRotatingFileSink(
+                        mRotatingFileBaseName, mRotatingFileExtension,
+                        mRotatingFileSizeLimit, mRotatingFileCount ) );
+            }
+
+            std::shared_ptr<spdlog::logger> logger;
+            if( mAsyncLogging )
+            {
+                logger = std::make_shared<AsyncLogger>( mName, begin(sinks), end(sinks),
+                        getAsyncBackend( sinksKey, sinks ) );
+            }
             else
             {
-                std::vector<spdlog::sink_ptr> sinks;
-                if( mStdoutLogging )
-                {
-                    sinks.push_back( std::make_shared<spdlog::sinks::stdout_sink_st>() );
-                }
-                if( !mSimpleFileName.empty() )
-                {
-                    sinks.push_back( getSimpleFileSink( mSimpleFileName ) );
-                }
-                if( !mRotatingFileBaseName.empty() )
+                logger = std::make_shared<spdlog::logger>( mName, begin(sinks), end(sinks) );
+                logger->set_pattern( getPattern() );
+            }
+            logger->set_level( mLevel );
+
+            // Names of loggers for rooms and the like come and go, so
+            // forget loggers no longer in use once in a while.
+            static std::size_t purgeSize = 64;
+            if( loggerMap.size() >= purgeSize )
+            {
+                for( auto purgeIter = loggerMap.begin(); purgeIter != loggerMap.end(); )
                 {
-                    sinks.push_back( getRotatingFileSink(
-                            mRotatingFileBaseName, mRotatingFileExtension,
-                            mRotatingFileSizeLimit, mRotatingFileCount ) );
+                    purgeIter = purgeIter->second.expired() ? loggerMap.erase( purgeIter ) : std::next( purgeIter );
                 }
-                auto logger = std::make_shared<spdlog::logger>( mName, begin(sinks), end(sinks) );
-                logger->set_level( mLevel );
-                logger->set_pattern( "[%L %n] %v" );
-                return logger;
+                purgeSize = std::max( purgeSize, loggerMap.size() * 2 );
             }
 
+            loggerMap[loggerKey] = logger;
+            return logger;
         }
 
         // copies config but adds child name to this name
@@ -92,12 +192,71 @@ namespace Logging
 
     private:
 
+        using LoggerMap = std::map<std::string,std::weak_ptr<spdlog::logger>>;
+
+        static const std::string& getPattern()
+        {
+            static const std::string pattern( "[%L %n] %v" );
+            return pattern;
+        }
+
+        // Identifies the set of sinks for this configuration.  Every field
+        // that affects the sinks must be part of the key.
+        std::string getSinksKey() const
+        {
+            std::ostringstream os;
+            os << mStdoutLogging << '\n' << mSimpleFileName << '\n'
+               << mRotatingFileBaseName << '\n' << mRotatingFileExtension << '\n'
+               << mRotatingFileSizeLimit << '\n' << mRotatingFileCount << '\n'
+               << mAsyncLogging;
+            return os.str();
+        }
+
+        static std::mutex& getLoggerMapMutex()
+        {
+            static std::mutex loggerMapMutex;
+            return loggerMapMutex;
+        }
+
+        static LoggerMap& getLoggerMap()
+        {
+            static LoggerMap loggerMap;
+            return loggerMap;
+        }
+
+        // One backend (queue and thread) per set of sinks, which in
+        // practice means one per process.  Called with the logger map
+        // mutex held.
+        static std::shared_ptr<AsyncLogger::Backend> getAsyncBackend( const std::string&                   sinksKey,
+                                                                      const std::vector<spdlog::sink_ptr>& sinks )
+        {
+            static std::map<std::string,std::shared_ptr<AsyncLogger::Backend>> backendMap;
+            std::shared_ptr<AsyncLogger::Backend>& backend = backendMap[sinksKey];
+            if( !backend )
+            {
+                backend = std::make_shared<AsyncLogger::Backend>(
+                        std::make_shared<spdlog::pattern_formatter>( getPattern() ), sinks, std::size_t( ASYNC_QUEUE_SIZE ),
+                        spdlog::async_overflow_policy::block_retry, nullptr,
+                        std::chrono::milliseconds( int( ASYNC_FLUSH_INTERVAL_MILLIS ) ) );
+            }
+            return backend;
+        }
+
+        // Loggers may be created and used from any thread, so sinks are
+        // shared and locked.
+        static std::mutex& getSinkMapMutex()
+        {
+            static std::mutex sinkMapMutex;
+            return sinkMapMutex;
+        }
+
         static spdlog::sink_ptr getSimpleFileSink( const std::string& fileName )
         {
+            std::lock_guard<std::mutex> lock( getSinkMapMutex() );
             static std::map<std::string,spdlog::sink_ptr> sinkMap;
             if( sinkMap.count( fileName ) == 0 )
             {
-                sinkMap[fileName] = std::make_shared<spdlog::sinks::simple_file_sink_st>(
+                sinkMap[fileName] = std::make_shared<spdlog::sinks::simple_file_sink_mt>(
                         fileName, true );
             }
             return sinkMap[fileName];
@@ -108,13 +267,18 @@ namespace Logging
                                                      unsigned int       fileSizeLimit,
                                                      unsigned int       fileCount )
         {
+            std::ostringstream os;
+            os << fileBaseName << '\n' << fileExtension << '\n' << fileSizeLimit << '\n' << fileCount;
+            const std::string sinkKey = os.str();
+
+            std::lock_guard<std::mutex> lock( getSinkMapMutex() );
             static std::map<std::string,spdlog::sink_ptr> sinkMap;
-            if( sinkMap.count( fileBaseName ) == 0 )
+            if( sinkMap.count( sinkKey ) == 0 )
             {
-                sinkMap[fileBaseName] = std::make_shared<spdlog::sinks::rotating_file_sink_st>(
+                sinkMap[sinkKey] = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
                         fileBaseName, fileExtension, fileSizeLimit, fileCount, true );
             }
-            return sinkMap[fileBaseName];
+            return sinkMap[sinkKey];
         }
 
         std::string mName;
@@ -125,6 +289,7 @@ namespace Logging
         unsigned int mRotatingFileSizeLimit;
         unsigned int mRotatingFileCount;
         bool mAppendThisAddr;
+        bool mAsyncLogging;
         spdlog::level::level_enum mLevel;
     };
 
@@ -0,0 +1,93 @@
+#include "CompressionPolicy.h"
+
+#include <algorithm>
+
+// Weight of the newest sample in the running averages.
+static const double SAMPLE_WEIGHT = 0.125;
+
+// Compression is considered ineffective above this running ratio.
+static const double INEFFECTIVE_RATIO = 0.9;
+
+// While compression is ineffective, still try every Nth eligible message
+// so that the ratio can recover if the traffic changes.
+static const unsigned PROBE_INTERVAL = 32;
+
+// Cost above which the level is stepped down, and below which (at a
+// quarter of it) the level is stepped back up toward the configured one.
+static const double MAX_NANOS_PER_BYTE = 40.0;
+
+
+CompressionPolicy::CompressionPolicy( int level, int threshold )
+  : mLevel( std::min( std::max( level, 1 ), 9 ) ),
+    mThreshold( threshold ),
+    mAdaptive( true ),
+    mEffectiveLevel( mLevel ),
+    mRatio( 0.0 ),
+    mNanosPerByte( 0.0 ),
+    mSkippedSinceProbe( 0 )
+{}
+
+
+void
+CompressionPolicy::setLevel( int level )
+{
+    mLevel = std::min( std::max( level, 1 ), 9 );
+    mEffectiveLevel = mLevel;
+}
+
+
+int
+CompressionPolicy::selectLevel( int payloadSize, Hint hint )
+{
+    mStats.messages++;
+
+    if( (hint == HINT_INCOMPRESSIBLE) || (payloadSize < mThreshold) ) return 0;
+
+    if( !mAdaptive ) return mLevel;
+
+    if( (hint != HINT_COMPRESSIBLE) && (mRatio > INEFFECTIVE_RATIO) )
+    {
+        if( ++mSkippedSinceProbe < PROBE_INTERVAL ) return 0;
+        mSkippedSinceProbe = 0;
+    }
+
+    return mEffectiveLevel;
+}
+
+
+void
+CompressionPolicy::recordCompression( int uncompressedSize, int compressedSize, uint64_t nanos )
+{
+    mStats.compressedMessages++;
+    mStats.uncompressedBytes += uncompressedSize;
+    mStats.compressedBytes += compressedSize;
+    mStats.compressionNanos += nanos;
+
+    if( uncompressedSize <= 0 ) return;
+
+    const double ratio = static_cast<double>( compressedSize ) / uncompressedSize;
+    const double nanosPerByte = static_cast<double>( nanos ) / uncompressedSize;
+
+    // Seed the running averages with the first sample.
+    if( mStats.compressedMessages == 1 )
+    {
+        mRatio = ratio;
+        mNanosPerByte = nanosPerByte;
+    }
+    else
+    {
+        mRatio += SAMPLE_WEIGHT * (ratio - mRatio);
+        mNanosPerByte += SAMPLE_WEIGHT * (nanosPerByte - mNanosPerByte);
+    }
+
+    if( !mAdaptive ) return;
+
+    if( (mNanosPerByte > MAX_NANOS_PER_BYTE) && (mEffectiveLevel > 1) )
+    {
+        mEffectiveLevel--;
+    }
+    else if( (mNanosPerByte < MAX_NANOS_PER_BYTE / 4) && (mEffectiveLevel < mLevel) )
+    {
+        mEffectiveLevel++;
+    }
+}
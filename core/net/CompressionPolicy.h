@@ -0,0 +1,81 @@
+#ifndef COMPRESSIONPOLICY_H
+#define COMPRESSIONPOLICY_H
+
+#include <cstdint>
+
+// Decides whether and how hard to compress outgoing messages.
+//
+// Payloads below a size threshold are never compressed.  Above it the
+// configured zlib level is used, adjusted by what the connection has
+// seen so far: when compression stops paying off (running compressed to
+// uncompressed ratio too high) messages are sent uncompressed apart from
+// periodic probes, and when compression gets expensive (running CPU cost
+// per byte too high) the level is stepped down until it recovers.
+class CompressionPolicy
+{
+public:
+
+    // Per-message hints from the sender.
+    enum Hint
+    {
+        HINT_NONE,              // let the policy decide
+        HINT_COMPRESSIBLE,      // worth compressing whenever over the threshold
+        HINT_INCOMPRESSIBLE     // never worth compressing
+    };
+
+    struct Stats
+    {
+        Stats() : messages( 0 ), compressedMessages( 0 ), uncompressedBytes( 0 ),
+                  compressedBytes( 0 ), compressionNanos( 0 ) {}
+
+        uint64_t messages;              // messages seen by the policy
+        uint64_t compressedMessages;    // messages compression was attempted on
+        uint64_t uncompressedBytes;     // input bytes of compression attempts
+        uint64_t compressedBytes;       // output bytes of compression attempts
+        uint64_t compressionNanos;      // time spent compressing
+    };
+
+    static const int DEFAULT_LEVEL = 6;
+    static const int DEFAULT_THRESHOLD = 128;
+
+    CompressionPolicy( int level = DEFAULT_LEVEL, int threshold = DEFAULT_THRESHOLD );
+
+    // zlib level 1-9.
+    void setLevel( int level );
+    int getLevel() const { return mLevel; }
+
+    // Payloads smaller than this are not compressed.
+    void setThreshold( int threshold ) { mThreshold = threshold; }
+    int getThreshold() const { return mThreshold; }
+
+    // With adaptation disabled the policy only applies the threshold and hints.
+    void setAdaptive( bool adaptive ) { mAdaptive = adaptive; }
+    bool isAdaptive() const { return mAdaptive; }
+
+    // Returns the zlib level to compress a payload with, or 0 to send it
+    // uncompressed.
+    int selectLevel( int payloadSize, Hint hint = HINT_NONE );
+
+    // Record the outcome of compressing a payload.
+    void recordCompression( int uncompressedSize, int compressedSize, uint64_t nanos );
+
+    const Stats& getStats() const { return mStats; }
+
+    // Level currently used for compression attempts.
+    int getEffectiveLevel() const { return mEffectiveLevel; }
+
+private:
+
+    int   mLevel;
+    int   mThreshold;
+    bool  mAdaptive;
+
+    int      mEffectiveLevel;
+    double   mRatio;            // running compressed/uncompressed ratio
+    double   mNanosPerByte;     // running compression cost
+    unsigned mSkippedSinceProbe;
+
+    Stats mStats;
+};
+
+#endif  // COMPRESSIONPOLICY_H
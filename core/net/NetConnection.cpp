@@ -1,13 +1,20 @@
 #include "NetConnection.h"
-#include <QDataStream>
+#include <cstring>
+#include <QElapsedTimer>
 #include <QTimer>
+#include <QtEndian>
 #include "qtutils_core.h"
 
 
+const int NetConnection::MAX_HEADER_SIZE;
+
+
 NetConnection::NetConnection( const Logging::Config &loggingConfig, QObject* parent )
     : QTcpSocket( parent ),
       mLogger( loggingConfig.createLogger() ),
       mRxInactivityAbortTimeMillis( 0 ),
+      mRxInactivityAbortHandle( TimerWheel::INVALID_HANDLE ),
+      mLastRxMillis( 0 ),
       mCompressionMode( COMPRESSION_MODE_AUTO ),
       mHeaderMode( HEADER_MODE_AUTO ),
       mIncomingMsgHeader( 0 ),
@@ -26,65 +33,178 @@ NetConnection::NetConnection( const Logging::Config &loggingConfig, QObject* par
 }
 
 
+NetConnection::~NetConnection()
+{
+    if( mTimerWheel ) mTimerWheel->cancel( mRxInactivityAbortHandle );
+}
+
+
 void
 NetConnection::setRxInactivityAbortTime( int inactivityMillis )
 {
     mRxInactivityAbortTimeMillis = inactivityMillis;
+    if( mTimerWheel ) mTimerWheel->cancel( mRxInactivityAbortHandle );
+    restartRxInactivityAbortTimer();
+}
+
+
+void
+NetConnection::setTimerWheel( const std::shared_ptr<TimerWheel>& timerWheel )
+{
+    if( mTimerWheel ) mTimerWheel->cancel( mRxInactivityAbortHandle );
+    mRxInactivityAbortTimer->stop();
+
+    mTimerWheel = timerWheel;
     restartRxInactivityAbortTimer();
 }
 
 
 bool
-NetConnection::sendMsg( const QByteArray& byteArray )
+NetConnection::sendMsg( const QByteArray& byteArray, CompressionPolicy::Hint compressionHint )
 {
-    mLogger->trace( "sendmsg: [{}] {}", byteArray.size(), hexStringify( byteArray, 10 ) );
+    LOGGER_TRACE( mLogger, "sendmsg: [{}] {}", byteArray.size(), hexStringify( byteArray, 10 ) );
 
-    // 16-bit header: 1 bit compression flag, 1 bit extended flag, 14 bits size.
-    quint16 header = 0x0000;
-    const QByteArray* payloadMsgByteArrayPtr;
+    const QByteArray block = frameMsg( byteArray, compressionHint );
+    if( block.isEmpty() ) return false;
 
-    QByteArray compressedMsgByteArray;
+    return sendFramedMsg( block );
+}
+
+
+QByteArray
+NetConnection::frameMsg( const QByteArray& byteArray, CompressionPolicy::Hint compressionHint )
+{
+    return frameMsg( byteArray.constData(), byteArray.size(),
+            selectCompressionLevel( byteArray.size(), compressionHint ) );
+}
+
+
+bool
+NetConnection::sendFramedMsg( const QByteArray& framedMsg )
+{
+    bool writeOk = (write( framedMsg ) == framedMsg.size());
+
+    if( writeOk ) mBytesSent += framedMsg.size();
+
+    return writeOk;
+}
+
+
+bool
+NetConnection::sendReservedMsg( char* buffer, int payloadSize, CompressionPolicy::Hint compressionHint )
+{
+    char* const payload = buffer + MAX_HEADER_SIZE;
+
+    const int compressionLevel = selectCompressionLevel( payloadSize, compressionHint );
+    if( compressionLevel > 0 )
+    {
+        // Compression produces a new buffer anyway.
+        const QByteArray block = frameMsg( payload, payloadSize, compressionLevel );
+        return !block.isEmpty() && sendFramedMsg( block );
+    }
+
+    bool extended;
+    if( !selectExtendedHeader( payloadSize, extended ) ) return false;
+
+    // Write the header just ahead of the payload.
+    char* const frame = payload - (extended ? 6 : 2);
+    const qint64 frameSize = writeHeader( frame, false, extended, payloadSize ) + payloadSize;
+
+    bool writeOk = (write( frame, frameSize ) == frameSize);
+
+    if( writeOk ) mBytesSent += frameSize;
+
+    return writeOk;
+}
+
+
+int
+NetConnection::selectCompressionLevel( int size, CompressionPolicy::Hint compressionHint )
+{
+    // Compression level to use; 0 means uncompressed.
     if( mCompressionMode == COMPRESSION_MODE_UNCOMPRESSED )
     {
-        payloadMsgByteArrayPtr = &byteArray;
+        return 0;
     }
-    else 
+    else if( mCompressionMode == COMPRESSION_MODE_COMPRESSED )
     {
-        const int COMPRESSION_MAX = 9;
-        compressedMsgByteArray = qCompress( byteArray, COMPRESSION_MAX );
-        mLogger->debug( "compressed {} bytes to {} bytes",
-                byteArray.size(), compressedMsgByteArray.size() );
+        return mCompressionPolicy.getLevel();
+    }
+    else
+    {
+        return mCompressionPolicy.selectLevel( size, compressionHint );
+    }
+}
+
+
+bool
+NetConnection::selectExtendedHeader( int payloadSize, bool& extended )
+{
+    if( (mHeaderMode == HEADER_MODE_BRIEF) && (payloadSize > 0x3FFF) )
+    {
+        mLogger->error( "payload too large ({} bytes) to send!", payloadSize );
+        return false;
+    }
+
+    extended = (mHeaderMode == HEADER_MODE_EXTENDED) ||
+               ((mHeaderMode == HEADER_MODE_AUTO) && (payloadSize > 0x3FFF));
+    return true;
+}
 
-        if( mCompressionMode == COMPRESSION_MODE_AUTO )
+
+QByteArray
+NetConnection::frameMsg( const char* data, int size, int compressionLevel )
+{
+    const char* payload = data;
+    int payloadSize = size;
+    bool compressed = false;
+
+    QByteArray compressedMsgByteArray;
+    if( compressionLevel > 0 )
+    {
+        QElapsedTimer compressionTimer;
+        compressionTimer.start();
+        compressedMsgByteArray = qCompress( reinterpret_cast<const uchar*>( data ), size, compressionLevel );
+        mCompressionPolicy.recordCompression( size, compressedMsgByteArray.size(),
+                compressionTimer.nsecsElapsed() );
+        mLogger->debug( "compressed {} bytes to {} bytes (level {})",
+                size, compressedMsgByteArray.size(), compressionLevel );
+
+        if( (mCompressionMode != COMPRESSION_MODE_AUTO) || (compressedMsgByteArray.size() < size) )
         {
-            if( compressedMsgByteArray.size() < byteArray.size() )
-            {
-                // The compression resulted in a smaller payload.
-                header |= 0x8000;
-                payloadMsgByteArrayPtr = &compressedMsgByteArray;
-            }
-            else
-            {
-                mLogger->debug( "inefficient compression, sending uncompressed" );
-                payloadMsgByteArrayPtr = &byteArray;
-            }
+            // Forced, or the compression resulted in a smaller payload.
+            compressed = true;
+            payload = compressedMsgByteArray.constData();
+            payloadSize = compressedMsgByteArray.size();
         }
         else
         {
-            header |= 0x8000;
-            payloadMsgByteArrayPtr = &compressedMsgByteArray;
+            mLogger->debug( "inefficient compression, sending uncompressed" );
         }
     }
 
-    const int payloadSize = payloadMsgByteArrayPtr->size();
-    if( (mHeaderMode == HEADER_MODE_BRIEF) && (payloadSize > 0x3FFF) )
-    {
-        mLogger->error( "payload too large ({} bytes) to send!", payloadSize );
-        return false;
-    }
+    bool extended;
+    if( !selectExtendedHeader( payloadSize, extended ) ) return QByteArray();
+
+    QByteArray block;
+    block.resize( (extended ? 6 : 2) + payloadSize );
+    const int headerSize = writeHeader( block.data(), compressed, extended, payloadSize );
+    std::memcpy( block.data() + headerSize, payload, payloadSize );
+    LOGGER_TRACE( mLogger, "sendmsg: framed [{}] {}", payloadSize,
+            hexStringify( QByteArray::fromRawData( payload, payloadSize ), 10 ) );
 
-    bool extended = (mHeaderMode == HEADER_MODE_EXTENDED) ||
-                    ((mHeaderMode == HEADER_MODE_AUTO) && (payloadSize > 0x3FFF));
+    return block;
+}
+
+
+int
+NetConnection::writeHeader( char* dest, bool compressed, bool extended, quint32 payloadSize )
+{
+    // 16-bit header: 1 bit compression flag, 1 bit extended flag, 14 bits
+    // size, followed by a 32-bit size if extended.  Big-endian like
+    // QDataStream.
+    quint16 header = 0x0000;
+    if( compressed ) header |= 0x8000;
     if( extended )
     {
         // Set extended flag.
@@ -96,51 +216,44 @@ NetConnection::sendMsg( const QByteArray& byteArray )
         header |= payloadSize;
     }
 
-    QByteArray block;
-    block.resize( sizeof( header ) + payloadSize );
-    QDataStream out( &block, QIODevice::WriteOnly );
-    out.setVersion( QDataStream::Qt_4_0 );
-    out << (quint16) header;
-    if( extended ) out << (quint32) payloadSize;
-    out.writeRawData( payloadMsgByteArrayPtr->data(), payloadSize );
-    mLogger->trace( "sendmsg: wrote [{}] {}", payloadMsgByteArrayPtr->size(),
-            hexStringify( *payloadMsgByteArrayPtr, 10 ) );
-
-    bool writeOk = write( block );
-
-    if( writeOk ) mBytesSent += block.size();
+    uchar* const out = reinterpret_cast<uchar*>( dest );
+    qToBigEndian<quint16>( header, out );
+    if( !extended ) return sizeof( header );
 
-    return writeOk;
+    qToBigEndian<quint32>( payloadSize, out + sizeof( header ) );
+    return sizeof( header ) + sizeof( payloadSize );
 }
 
 
 void
 NetConnection::handleReadyRead()
 {
-    QDataStream in( this );
-    in.setVersion( QDataStream::Qt_4_0 );
-
-    mLogger->trace( "handleReadyRead(): sock {}: bytesAvail={}",
+    LOGGER_TRACE( mLogger, "handleReadyRead(): sock {}: bytesAvail={}",
             (std::size_t)this, bytesAvailable() );
 
-    while( bytesAvailable() )
+    // Pull everything available from the socket into the receive buffer.
+    qint64 bytesAvail;
+    while( (bytesAvail = bytesAvailable()) > 0 )
     {
-        if( mIncomingMsgHeader == 0 ) {
-            if( bytesAvailable() < (int)sizeof( mIncomingMsgHeader ) )
-                return;
+        std::size_t writableBytes;
+        char* dest = mRxBuffer.prepareWrite( bytesAvail, writableBytes );
+        const qint64 bytesRead = read( dest, writableBytes );
+        if( bytesRead <= 0 ) break;
+        mRxBuffer.commitWrite( bytesRead );
+    }
 
-            in >> mIncomingMsgHeader;
-            mBytesReceived += sizeof( mIncomingMsgHeader );
+    while( !mRxBuffer.empty() )
+    {
+        if( mIncomingMsgHeader == 0 ) {
+            if( !readRxHeader( mIncomingMsgHeader ) )
+                break;
         }
 
         const bool msgExtendedHeader = mIncomingMsgHeader & 0x4000;
 
         if( msgExtendedHeader && (mExtendedLength == 0) ) {
-            if( bytesAvailable() < (int)sizeof( mExtendedLength ) )
-                return;
-
-            in >> mExtendedLength;
-            mBytesReceived += sizeof( mExtendedLength );
+            if( !readRxExtendedLength( mExtendedLength ) )
+                break;
         }
 
         const bool msgCompressed = mIncomingMsgHeader & 0x8000;
@@ -148,33 +261,29 @@ NetConnection::handleReadyRead()
         const quint32 msgSize = msgExtendedHeader ? mExtendedLength
                                                   : mIncomingMsgHeader & 0x3FFF;
 
-        if( bytesAvailable() < msgSize )
-            return;
+        const char* msgData = mRxBuffer.contiguousData( msgSize );
+        if( msgData == nullptr )
+            break;
 
-        QByteArray msgByteArray;
-        msgByteArray.resize( msgSize );
-        mLogger->debug( "reading {} bytes into message buffer ({} available)",
-                msgSize, bytesAvailable() );
-        in.readRawData( msgByteArray.data(), msgSize );
         mBytesReceived += msgSize;
-
         mIncomingMsgHeader = 0;
         mExtendedLength = 0;
 
         if( msgCompressed )
         {
-            msgByteArray = qUncompress( msgByteArray );
+            const QByteArray msgByteArray = qUncompress(
+                    reinterpret_cast<const uchar*>( msgData ), msgSize );
+            mRxBuffer.consume( msgSize );
             mLogger->debug( "deserialized {} bytes, uncompressed to {} bytes",
                     msgSize, msgByteArray.size() );
+            handleRxMsg( msgByteArray.constData(), msgByteArray.size() );
         }
         else
         {
             mLogger->debug( "deserialized {} bytes, not compressed", msgSize );
+            handleRxMsg( msgData, msgSize );
+            mRxBuffer.consume( msgSize );
         }
-
-        mLogger->trace( "emit: [{}] {}", msgByteArray.size(),
-                hexStringify( msgByteArray, 10 ) );
-        emit msgReceived( msgByteArray );
     }
 
     // The other side is alive - reset monitoring timer.
@@ -182,6 +291,43 @@ NetConnection::handleReadyRead()
 }
 
 
+void
+NetConnection::handleRxMsg( const char* data, int size )
+{
+    const QByteArray msgByteArray( data, size );
+    LOGGER_TRACE( mLogger, "emit: [{}] {}", msgByteArray.size(),
+            hexStringify( msgByteArray, 10 ) );
+    emit msgReceived( msgByteArray );
+}
+
+
+bool
+NetConnection::readRxHeader( quint16& header )
+{
+    uchar bytes[sizeof( header )];
+    if( !mRxBuffer.peek( reinterpret_cast<char*>( bytes ), sizeof( bytes ) ) ) return false;
+
+    // Headers are big-endian, as written by QDataStream.
+    header = qFromBigEndian<quint16>( bytes );
+    mRxBuffer.consume( sizeof( bytes ) );
+    mBytesReceived += sizeof( bytes );
+    return true;
+}
+
+
+bool
+NetConnection::readRxExtendedLength( quint32& length )
+{
+    uchar bytes[sizeof( length )];
+    if( !mRxBuffer.peek( reinterpret_cast<char*>( bytes ), sizeof( bytes ) ) ) return false;
+
+    length = qFromBigEndian<quint32>( bytes );
+    mRxBuffer.consume( sizeof( bytes ) );
+    mBytesReceived += sizeof( bytes );
+    return true;
+}
+
+
 void
 NetConnection::handleRxInactivityAbortTimerTimeout()
 {
@@ -191,9 +337,43 @@ NetConnection::handleRxInactivityAbortTimerTimeout()
 }
 
 
+void
+NetConnection::handleRxInactivityAbortWheelTimeout()
+{
+    mRxInactivityAbortHandle = TimerWheel::INVALID_HANDLE;
+
+    // Re-arm for the rest of the inactivity time if anything has been
+    // received since the timer was armed.
+    const uint64_t inactiveMillis = mTimerWheel->getNowMillis() - mLastRxMillis;
+    if( inactiveMillis < static_cast<uint64_t>( mRxInactivityAbortTimeMillis ) )
+    {
+        mRxInactivityAbortHandle = mTimerWheel->schedule( mRxInactivityAbortTimeMillis - inactiveMillis,
+                [this] { handleRxInactivityAbortWheelTimeout(); } );
+        return;
+    }
+
+    handleRxInactivityAbortTimerTimeout();
+}
+
+
 void
 NetConnection::restartRxInactivityAbortTimer()
 {
+    if( mTimerWheel )
+    {
+        mLastRxMillis = mTimerWheel->getNowMillis();
+        if( mRxInactivityAbortTimeMillis <= 0 )
+        {
+            mTimerWheel->cancel( mRxInactivityAbortHandle );
+        }
+        else if( !mTimerWheel->isScheduled( mRxInactivityAbortHandle ) )
+        {
+            mRxInactivityAbortHandle = mTimerWheel->schedule( mRxInactivityAbortTimeMillis,
+                    [this] { handleRxInactivityAbortWheelTimeout(); } );
+        }
+        return;
+    }
+
     if( mRxInactivityAbortTimeMillis > 0 )
     {
         mRxInactivityAbortTimer->start( mRxInactivityAbortTimeMillis );
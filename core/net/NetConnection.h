@@ -2,6 +2,10 @@
 #define NETCONNECTION_H
 
 #include <QTcpSocket>
+#include <memory>
+#include "CompressionPolicy.h"
+#include "RingBuffer.h"
+#include "TimerWheel.h"
 #include "Logging.h"
 
 QT_BEGIN_NAMESPACE
@@ -31,20 +35,53 @@ public:
     };
 
     NetConnection( const Logging::Config& loggingConfig = Logging::Config(), QObject* parent = 0 );
+    virtual ~NetConnection();
 
     // Set a receive inactivity abort time.  If nothing has been received
     // within the inactivity time the socket connection will be aborted.
     // Set to 0 to disable.
     void setRxInactivityAbortTime( int inactivityMillis );
 
-    // Set compression mode (for testing).  Default mode is COMPRESSION_AUTO.
+    // Use a shared timer wheel for the receive inactivity timer instead of
+    // a dedicated QTimer.  The wheel timer isn't re-armed on every receive;
+    // when it fires it re-arms itself for whatever inactivity time is left.
+    void setTimerWheel( const std::shared_ptr<TimerWheel>& timerWheel );
+
+    // Set compression mode (for testing).  Default mode is COMPRESSION_AUTO,
+    // in which the compression policy decides per message.
     void setCompressionMode( CompressionMode compressionMode ) { mCompressionMode = compressionMode; }
 
+    // Compression policy for COMPRESSION_AUTO mode, including compression stats.
+    CompressionPolicy& getCompressionPolicy() { return mCompressionPolicy; }
+    const CompressionPolicy& getCompressionPolicy() const { return mCompressionPolicy; }
+
     // Set header mode (for testing).  Default mode is HEADER_AUTO.
     void setHeaderMode( HeaderMode headerMode ) { mHeaderMode = headerMode; }
 
     // Send message.  Returns true if message was sent entirely.
-    bool sendMsg( const QByteArray& byteArray );
+    bool sendMsg( const QByteArray& byteArray,
+                  CompressionPolicy::Hint compressionHint = CompressionPolicy::HINT_NONE );
+
+    // Compress and apply the header to a message using this connection's
+    // modes and compression policy.  The framed message can be written to any number of
+    // connections with sendFramedMsg(), sharing the same buffer.  Returns
+    // an empty array if the message can't be framed.
+    QByteArray frameMsg( const QByteArray& byteArray,
+                         CompressionPolicy::Hint compressionHint = CompressionPolicy::HINT_NONE );
+
+    // Send a message from frameMsg().  Returns true if message was sent entirely.
+    bool sendFramedMsg( const QByteArray& framedMsg );
+
+    // Space callers of sendReservedMsg() leave ahead of the payload.
+    static const int MAX_HEADER_SIZE = 6;
+
+    // Send a message whose payload was written into buffer after
+    // MAX_HEADER_SIZE reserved bytes.  Unless the message is compressed
+    // the header is written into the reserved space and the frame goes to
+    // the socket in one write with no further copies.  Returns true if
+    // message was sent entirely.
+    bool sendReservedMsg( char* buffer, int payloadSize,
+                          CompressionPolicy::Hint compressionHint = CompressionPolicy::HINT_NONE );
 
     uint64_t getBytesSent() const { return mBytesSent; }
     uint64_t getBytesReceived() const { return mBytesReceived; }
@@ -60,6 +97,12 @@ private slots:
 
 protected:
 
+    // Called for each received message with a view of its (uncompressed)
+    // payload, valid only for the duration of the call.  The default
+    // copies the payload and emits msgReceived(); subclasses can override
+    // this to decode straight from the receive buffer.
+    virtual void handleRxMsg( const char* data, int size );
+
     std::shared_ptr<spdlog::logger> mLogger;
 
 private:
@@ -68,15 +111,30 @@ private:
     NetConnection& operator=( const NetConnection& n );
 
     void restartRxInactivityAbortTimer();
+    int selectCompressionLevel( int size, CompressionPolicy::Hint compressionHint );
+    bool selectExtendedHeader( int payloadSize, bool& extended );
+    QByteArray frameMsg( const char* data, int size, int compressionLevel );
+    static int writeHeader( char* dest, bool compressed, bool extended, quint32 payloadSize );
+    bool readRxHeader( quint16& header );
+    bool readRxExtendedLength( quint32& length );
+    void handleRxInactivityAbortWheelTimeout();
 
     QTimer* mRxInactivityAbortTimer;
     int mRxInactivityAbortTimeMillis;
 
-    CompressionMode mCompressionMode;
-    HeaderMode      mHeaderMode;
+    std::shared_ptr<TimerWheel> mTimerWheel;
+    TimerWheel::Handle          mRxInactivityAbortHandle;
+    uint64_t                    mLastRxMillis;
+
+    CompressionMode   mCompressionMode;
+    CompressionPolicy mCompressionPolicy;
+    HeaderMode        mHeaderMode;
 
-    quint16 mIncomingMsgHeader;
-    quint32 mExtendedLength;
+    // Socket data is read into a reusable buffer and messages are decoded
+    // from it in place.
+    RingBuffer mRxBuffer;
+    quint16    mIncomingMsgHeader;
+    quint32    mExtendedLength;
 
     uint64_t mBytesSent;
     uint64_t mBytesReceived;
@@ -0,0 +1,104 @@
+#include "RingBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+RingBuffer::RingBuffer( std::size_t initialCapacity )
+  : mData( std::max<std::size_t>( initialCapacity, 1 ) ),
+    mHead( 0 ),
+    mSize( 0 )
+{}
+
+
+char*
+RingBuffer::prepareWrite( std::size_t minBytes, std::size_t& writableBytes )
+{
+    minBytes = std::max<std::size_t>( minBytes, 1 );
+
+    if( mData.size() - mSize < minBytes )
+    {
+        // Grow with the contents at the start so the new space is
+        // contiguous.
+        linearize();
+        mData.resize( std::max( mData.size() * 2, mSize + minBytes ) );
+    }
+
+    std::size_t tail = mHead + mSize;
+    if( tail >= mData.size() )
+    {
+        // Tail has wrapped; free space runs up to the head.
+        tail -= mData.size();
+        writableBytes = mHead - tail;
+    }
+    else
+    {
+        writableBytes = mData.size() - tail;
+        if( writableBytes < minBytes )
+        {
+            // The free space is split around the end of storage.
+            linearize();
+            tail = mSize;
+            writableBytes = mData.size() - tail;
+        }
+    }
+
+    return &mData[tail];
+}
+
+
+void
+RingBuffer::commitWrite( std::size_t bytes )
+{
+    mSize = std::min( mSize + bytes, mData.size() );
+}
+
+
+bool
+RingBuffer::peek( char* dest, std::size_t bytes ) const
+{
+    if( bytes > mSize ) return false;
+
+    const std::size_t firstBytes = std::min( bytes, mData.size() - mHead );
+    std::memcpy( dest, &mData[mHead], firstBytes );
+    if( firstBytes < bytes )
+    {
+        std::memcpy( dest + firstBytes, &mData[0], bytes - firstBytes );
+    }
+    return true;
+}
+
+
+const char*
+RingBuffer::contiguousData( std::size_t bytes )
+{
+    if( bytes > mSize ) return nullptr;
+    if( mHead + bytes > mData.size() ) linearize();
+    return &mData[mHead];
+}
+
+
+void
+RingBuffer::consume( std::size_t bytes )
+{
+    bytes = std::min( bytes, mSize );
+    mSize -= bytes;
+    mHead = (mSize == 0) ? 0 : (mHead + bytes) % mData.size();
+}
+
+
+void
+RingBuffer::linearize()
+{
+    if( mHead == 0 ) return;
+
+    if( mHead + mSize <= mData.size() )
+    {
+        std::memmove( &mData[0], &mData[mHead], mSize );
+    }
+    else
+    {
+        std::rotate( mData.begin(), mData.begin() + mHead, mData.end() );
+    }
+    mHead = 0;
+}
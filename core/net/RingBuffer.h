@@ -0,0 +1,56 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <cstddef>
+#include <vector>
+
+// Byte ring buffer for framed socket reads.
+//
+// Data is written straight into free space at the tail (no intermediate
+// buffers) and read back from the head.  Storage only grows when a write
+// reserves more than is free, so once it has grown to fit the largest
+// message a connection sees, receiving allocates nothing.  A message that
+// wraps around the end of the storage is made contiguous in place.
+class RingBuffer
+{
+public:
+
+    RingBuffer( std::size_t initialCapacity = 16 * 1024 );
+
+    std::size_t size() const { return mSize; }
+    std::size_t capacity() const { return mData.size(); }
+    bool empty() const { return mSize == 0; }
+
+    // Make room for at least minBytes, then return the contiguous free
+    // space at the tail.  Sets writableBytes to its size, which may be
+    // more than minBytes.
+    char* prepareWrite( std::size_t minBytes, std::size_t& writableBytes );
+
+    // Add bytes written into space from prepareWrite().
+    void commitWrite( std::size_t bytes );
+
+    // Copy bytes from the head without consuming them.  Returns false if
+    // fewer bytes are buffered.
+    bool peek( char* dest, std::size_t bytes ) const;
+
+    // Return the next bytes from the head as one contiguous block, or
+    // nullptr if fewer bytes are buffered.  Valid until the buffer is
+    // next modified.
+    const char* contiguousData( std::size_t bytes );
+
+    // Drop bytes from the head.
+    void consume( std::size_t bytes );
+
+    void clear() { mHead = 0; mSize = 0; }
+
+private:
+
+    // Move contents to the start of storage.
+    void linearize();
+
+    std::vector<char> mData;
+    std::size_t       mHead;
+    std::size_t       mSize;
+};
+
+#endif  // RINGBUFFER_H
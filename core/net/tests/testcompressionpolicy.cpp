@@ -0,0 +1,80 @@
+#include "catch.hpp"
+#include "CompressionPolicy.h"
+
+CATCH_TEST_CASE( "CompressionPolicy", "[compressionpolicy]" )
+{
+    CompressionPolicy policy( 9, 100 );
+
+    CATCH_SECTION( "Threshold and hints" )
+    {
+        CATCH_REQUIRE( policy.selectLevel( 0 ) == 0 );
+        CATCH_REQUIRE( policy.selectLevel( 99 ) == 0 );
+        CATCH_REQUIRE( policy.selectLevel( 100 ) == 9 );
+        CATCH_REQUIRE( policy.selectLevel( 99, CompressionPolicy::HINT_COMPRESSIBLE ) == 0 );
+        CATCH_REQUIRE( policy.selectLevel( 10000, CompressionPolicy::HINT_INCOMPRESSIBLE ) == 0 );
+        CATCH_REQUIRE( policy.getStats().messages == 5 );
+    }
+
+    CATCH_SECTION( "Levels are clamped" )
+    {
+        policy.setLevel( 0 );
+        CATCH_REQUIRE( policy.getLevel() == 1 );
+        policy.setLevel( 12 );
+        CATCH_REQUIRE( policy.getLevel() == 9 );
+    }
+
+    CATCH_SECTION( "Stats" )
+    {
+        policy.recordCompression( 1000, 250, 4000 );
+        policy.recordCompression( 1000, 750, 6000 );
+        const CompressionPolicy::Stats& stats = policy.getStats();
+        CATCH_REQUIRE( stats.compressedMessages == 2 );
+        CATCH_REQUIRE( stats.uncompressedBytes == 2000 );
+        CATCH_REQUIRE( stats.compressedBytes == 1000 );
+        CATCH_REQUIRE( stats.compressionNanos == 10000 );
+    }
+
+    CATCH_SECTION( "Ineffective compression is skipped apart from probes" )
+    {
+        policy.recordCompression( 1000, 1010, 1000 );
+
+        int attempts = 0;
+        for( int i = 0; i < 64; ++i )
+        {
+            if( policy.selectLevel( 1000 ) > 0 ) ++attempts;
+        }
+        CATCH_REQUIRE( attempts == 2 );
+
+        // Hinted messages are still compressed.
+        CATCH_REQUIRE( policy.selectLevel( 1000, CompressionPolicy::HINT_COMPRESSIBLE ) == 9 );
+
+        // Everything is attempted without adaptation.
+        policy.setAdaptive( false );
+        CATCH_REQUIRE( policy.selectLevel( 1000 ) == 9 );
+
+        // Good results bring compression back.
+        policy.setAdaptive( true );
+        for( int i = 0; i < 32; ++i )
+        {
+            policy.recordCompression( 1000, 100, 1000 );
+        }
+        CATCH_REQUIRE( policy.selectLevel( 1000 ) == 9 );
+    }
+
+    CATCH_SECTION( "Expensive compression lowers the level" )
+    {
+        for( int i = 0; i < 3; ++i )
+        {
+            policy.recordCompression( 1000, 100, 1000000 );
+        }
+        CATCH_REQUIRE( policy.getEffectiveLevel() == 6 );
+        CATCH_REQUIRE( policy.selectLevel( 1000 ) == 6 );
+
+        // Cheap compression restores it, but never past the configured level.
+        for( int i = 0; i < 100; ++i )
+        {
+            policy.recordCompression( 1000, 100, 1000 );
+        }
+        CATCH_REQUIRE( policy.getEffectiveLevel() == 9 );
+    }
+}
@@ -235,6 +235,22 @@ TxRxNetTester::testTxRx( NetConnection* txConn, NetConnection* rxConn, const QBy
         CATCH_REQUIRE_FALSE( sendOk );
     }
 
+    // Same again with a message framed once and sent separately.
+    const QByteArray framedMsg = txConn->frameMsg( data );
+    if( !sendFailExpected )
+    {
+        CATCH_REQUIRE_FALSE( framedMsg.isEmpty() );
+        CATCH_REQUIRE( txConn->sendFramedMsg( framedMsg ) );
+
+        watchdogTimer.start( 100 );
+        loop.exec();
+        CATCH_REQUIRE( watchdogTimer.isActive() );  // ensure no timeout
+    }
+    else
+    {
+        CATCH_REQUIRE( framedMsg.isEmpty() );
+    }
+
     disconnect( &watchdogTimer, 0, 0, 0 );
     disconnect( rxConn, &NetConnection::msgReceived, 0, 0 );
 }
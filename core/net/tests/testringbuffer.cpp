@@ -0,0 +1,68 @@
+#include "catch.hpp"
+#include "RingBuffer.h"
+
+#include <cstring>
+#include <string>
+
+static void
+write( RingBuffer& buf, const std::string& str )
+{
+    std::size_t writableBytes;
+    char* dest = buf.prepareWrite( str.size(), writableBytes );
+    CATCH_REQUIRE( writableBytes >= str.size() );
+    std::memcpy( dest, str.data(), str.size() );
+    buf.commitWrite( str.size() );
+}
+
+CATCH_TEST_CASE( "RingBuffer", "[ringbuffer]" )
+{
+    RingBuffer buf( 8 );
+
+    CATCH_SECTION( "Write, peek and consume" )
+    {
+        write( buf, "abcde" );
+        CATCH_REQUIRE( buf.size() == 5 );
+
+        char peeked[3];
+        CATCH_REQUIRE( buf.peek( peeked, 3 ) );
+        CATCH_REQUIRE( std::string( peeked, 3 ) == "abc" );
+        CATCH_REQUIRE_FALSE( buf.peek( peeked, 6 ) );
+        CATCH_REQUIRE( buf.contiguousData( 6 ) == nullptr );
+
+        buf.consume( 2 );
+        CATCH_REQUIRE( std::string( buf.contiguousData( 3 ), 3 ) == "cde" );
+        buf.consume( 3 );
+        CATCH_REQUIRE( buf.empty() );
+        CATCH_REQUIRE( buf.capacity() == 8 );
+    }
+
+    CATCH_SECTION( "Wrapped data is made contiguous" )
+    {
+        write( buf, "abcdef" );
+        buf.consume( 5 );
+
+        // Free space wraps; a small write goes at the tail.
+        std::size_t writableBytes;
+        buf.prepareWrite( 2, writableBytes );
+        CATCH_REQUIRE( writableBytes == 2 );
+        write( buf, "gh" );
+        write( buf, "ijk" );
+        CATCH_REQUIRE( buf.size() == 6 );
+        CATCH_REQUIRE( buf.capacity() == 8 );
+
+        char peeked[6];
+        CATCH_REQUIRE( buf.peek( peeked, 6 ) );
+        CATCH_REQUIRE( std::string( peeked, 6 ) == "fghijk" );
+        CATCH_REQUIRE( std::string( buf.contiguousData( 6 ), 6 ) == "fghijk" );
+        CATCH_REQUIRE( buf.capacity() == 8 );
+    }
+
+    CATCH_SECTION( "Grows to fit" )
+    {
+        write( buf, "abcdef" );
+        buf.consume( 4 );
+        write( buf, "0123456789" );
+        CATCH_REQUIRE( buf.capacity() >= 12 );
+        CATCH_REQUIRE( std::string( buf.contiguousData( 12 ), 12 ) == "ef0123456789" );
+    }
+}
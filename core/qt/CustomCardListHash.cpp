@@ -0,0 +1,29 @@
+#include "CustomCardListHash.h"
+
+#include <QCryptographicHash>
+#include <map>
+#include <utility>
+
+
+std::string
+computeCustomCardListHash( const proto::DraftConfig::CustomCardList& customCardList )
+{
+    std::map<std::pair<std::string,std::string>,unsigned int> quantities;
+    for( int i = 0; i < customCardList.card_quantities_size(); ++i )
+    {
+        const proto::DraftConfig::CustomCardList::CardQuantity& cardQty = customCardList.card_quantities( i );
+        quantities[std::make_pair( cardQty.set_code(), cardQty.name() )] += cardQty.quantity();
+    }
+
+    // One "quantity<TAB>set<TAB>name" line per card.
+    QCryptographicHash hash( QCryptographicHash::Sha256 );
+    for( const auto& kv : quantities )
+    {
+        if( kv.second == 0 ) continue;
+        const std::string line = std::to_string( kv.second ) + '\t' + kv.first.first + '\t' + kv.first.second + '\n';
+        hash.addData( line.data(), line.size() );
+    }
+
+    const QByteArray result = hash.result();
+    return std::string( result.constData(), result.size() );
+}
@@ -0,0 +1,16 @@
+#ifndef CUSTOMCARDLISTHASH_H
+#define CUSTOMCARDLISTHASH_H
+
+#include <string>
+#include "DraftConfig.pb.h"
+
+// Compute the content hash of a custom card list (i.e. a cube), used by
+// the client and server to refer to a list without sending its cards.
+//
+// The hash is a SHA-256 over the card quantities in a canonical order
+// (sorted by set code and name, duplicate entries combined).  The list
+// name is not included, so the same cards hash the same however a list
+// is named or ordered.
+std::string computeCustomCardListHash( const proto::DraftConfig::CustomCardList& customCardList );
+
+#endif  // CUSTOMCARDLISTHASH_H
@@ -0,0 +1,122 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+  : mData( nullptr ),
+    mSize( 0 )
+#ifdef _WIN32
+  , mFileHandle( INVALID_HANDLE_VALUE ),
+    mMappingHandle( NULL )
+#endif
+{}
+
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+
+#ifdef _WIN32
+
+bool
+MappedFile::open( const std::string& filePath )
+{
+    close();
+
+    HANDLE file = CreateFileA( filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+    if( file == INVALID_HANDLE_VALUE ) return false;
+
+    LARGE_INTEGER fileSize;
+    if( !GetFileSizeEx( file, &fileSize ) || (fileSize.QuadPart == 0) )
+    {
+        CloseHandle( file );
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+    if( mapping == NULL )
+    {
+        CloseHandle( file );
+        return false;
+    }
+
+    void* data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+    if( data == NULL )
+    {
+        CloseHandle( mapping );
+        CloseHandle( file );
+        return false;
+    }
+
+    mFileHandle = file;
+    mMappingHandle = mapping;
+    mData = static_cast<const char*>( data );
+    mSize = static_cast<size_t>( fileSize.QuadPart );
+    return true;
+}
+
+
+void
+MappedFile::close()
+{
+    if( mData != nullptr ) UnmapViewOfFile( mData );
+    if( mMappingHandle != NULL ) CloseHandle( mMappingHandle );
+    if( mFileHandle != INVALID_HANDLE_VALUE ) CloseHandle( mFileHandle );
+    mData = nullptr;
+    mSize = 0;
+    mMappingHandle = NULL;
+    mFileHandle = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+bool
+MappedFile::open( const std::string& filePath )
+{
+    close();
+
+    int fd = ::open( filePath.c_str(), O_RDONLY );
+    if( fd < 0 ) return false;
+
+    struct stat st;
+    if( (fstat( fd, &st ) != 0) || (st.st_size == 0) )
+    {
+        ::close( fd );
+        return false;
+    }
+
+    void* data = mmap( nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+    // The mapping stays valid after the descriptor is closed.
+    ::close( fd );
+
+    if( data == MAP_FAILED ) return false;
+
+    mData = static_cast<const char*>( data );
+    mSize = static_cast<size_t>( st.st_size );
+    return true;
+}
+
+
+void
+MappedFile::close()
+{
+    if( mData != nullptr )
+    {
+        munmap( const_cast<char*>( mData ), mSize );
+    }
+    mData = nullptr;
+    mSize = 0;
+}
+
+#endif
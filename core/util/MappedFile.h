@@ -0,0 +1,42 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+//
+// Read-only memory mapping of an entire file.  The mapping is released
+// when the object is closed or destroyed.
+//
+
+class MappedFile
+{
+public:
+
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+    // Map a file into memory.  Returns false if the file cannot be opened
+    // or mapped, or if it is empty.
+    bool open( const std::string& filePath );
+    void close();
+
+    bool isOpen() const { return mData != nullptr; }
+    const char* getData() const { return mData; }
+    size_t getSize() const { return mSize; }
+
+private:
+
+    const char* mData;
+    size_t      mSize;
+
+#ifdef _WIN32
+    void*       mFileHandle;
+    void*       mMappingHandle;
+#endif
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include "SimpleRandGen.h"
 
+#include <atomic>
 #include <ctime>
 
 SimpleRandGen::SimpleRandGen()
@@ -12,7 +13,7 @@ SimpleRandGen::SimpleRandGen()
     // it produced repetitive results across new instances of this class.
     // The 'mt19937' engine behaves much more reasonably with small
     // seed changes.
-    static auto seed = std::time( nullptr );
+    static std::atomic<std::time_t> seed( std::time( nullptr ) );
     mRandEng.seed( seed++ );
 }
 
@@ -21,6 +21,18 @@ StringUtil::icompare( std::string const& a, std::string const& b )
 }
 
 
+std::string
+StringUtil::toLower( const std::string& str )
+{
+    std::string lower( str );
+    for( char& c : lower )
+    {
+        c = std::tolower( static_cast<unsigned char>( c ) );
+    }
+    return lower;
+}
+
+
 std::string
 StringUtil::trim( const std::string& str, const std::string& whitespace )
 {
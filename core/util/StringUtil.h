@@ -9,6 +9,9 @@ namespace StringUtil
     // Case-insensitive string comparison.
     bool icompare( std::string const& a, std::string const& b );
 
+    // Lowercase a string; folding matches icompare().
+    std::string toLower( const std::string& str );
+
     // Trim whitespace on both ends of a string.
     std::string trim( const std::string& str, const std::string& whitespace = " \t");
 
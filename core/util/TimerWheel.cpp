@@ -0,0 +1,199 @@
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+const TimerWheel::Handle TimerWheel::INVALID_HANDLE;
+const uint32_t TimerWheel::NIL;
+
+
+TimerWheel::TimerWheel( unsigned int tickMillis, unsigned int slotCount )
+  : mTickMillis( std::max( tickMillis, 1u ) ),
+    mSlotHeads( std::max( slotCount, 1u ), NIL ),
+    mFreeHead( NIL ),
+    mScheduledCount( 0 ),
+    mNowMillis( 0 ),
+    mCurrentTick( 0 )
+{}
+
+
+TimerWheel::Handle
+TimerWheel::schedule( uint64_t delayMillis, const Callback& callback )
+{
+    return scheduleAt( mNowMillis + delayMillis, callback );
+}
+
+
+TimerWheel::Handle
+TimerWheel::scheduleAt( uint64_t dueMillis, const Callback& callback )
+{
+    uint32_t index;
+    if( mFreeHead != NIL )
+    {
+        index = mFreeHead;
+        mFreeHead = mEntries[index].next;
+    }
+    else
+    {
+        index = mEntries.size();
+        mEntries.push_back( Entry() );
+        mEntries[index].generation = 0;
+    }
+
+    Entry& entry = mEntries[index];
+    entry.dueTick = std::max( (dueMillis + mTickMillis - 1) / mTickMillis, mCurrentTick + 1 );
+    entry.scheduled = true;
+    entry.callback = callback;
+    link( index );
+    mScheduledCount++;
+
+    return (static_cast<Handle>( entry.generation ) << 32) | (index + 1);
+}
+
+
+bool
+TimerWheel::cancel( Handle handle )
+{
+    Entry* entry = lookup( handle );
+    if( !entry ) return false;
+
+    const uint32_t index = static_cast<uint32_t>( handle & 0xFFFFFFFF ) - 1;
+    unlink( index );
+    release( index );
+    return true;
+}
+
+
+bool
+TimerWheel::isScheduled( Handle handle ) const
+{
+    return lookup( handle ) != nullptr;
+}
+
+
+uint64_t
+TimerWheel::getMillisRemaining( Handle handle ) const
+{
+    const Entry* entry = lookup( handle );
+    if( !entry ) return 0;
+
+    const uint64_t dueMillis = entry->dueTick * mTickMillis;
+    return (dueMillis > mNowMillis) ? (dueMillis - mNowMillis) : 0;
+}
+
+
+void
+TimerWheel::advanceTo( uint64_t nowMillis )
+{
+    const uint64_t targetTick = nowMillis / mTickMillis;
+
+    while( mCurrentTick < targetTick )
+    {
+        // Nothing to fire; skip straight to the target.
+        if( mScheduledCount == 0 )
+        {
+            mCurrentTick = targetTick;
+            break;
+        }
+
+        mCurrentTick++;
+        mNowMillis = std::max( mNowMillis, mCurrentTick * mTickMillis );
+
+        // Pull the due entries off the slot before firing any of them so
+        // callbacks are free to modify the wheel.
+        mDueHandles.clear();
+        uint32_t index = mSlotHeads[mCurrentTick % mSlotHeads.size()];
+        while( index != NIL )
+        {
+            const Entry& entry = mEntries[index];
+            if( entry.dueTick == mCurrentTick )
+            {
+                mDueHandles.push_back( (static_cast<Handle>( entry.generation ) << 32) | (index + 1) );
+            }
+            index = entry.next;
+        }
+
+        // Slots are built newest first; fire in the order scheduled.
+        std::reverse( mDueHandles.begin(), mDueHandles.end() );
+
+        for( Handle handle : mDueHandles )
+        {
+            // An earlier callback may have cancelled this one.
+            Entry* entry = lookup( handle );
+            if( !entry ) continue;
+
+            const uint32_t dueIndex = static_cast<uint32_t>( handle & 0xFFFFFFFF ) - 1;
+            Callback callback;
+            callback.swap( entry->callback );
+            unlink( dueIndex );
+            release( dueIndex );
+
+            callback();
+        }
+    }
+
+    mNowMillis = std::max( mNowMillis, nowMillis );
+}
+
+
+TimerWheel::Entry*
+TimerWheel::lookup( Handle handle )
+{
+    return const_cast<Entry*>( static_cast<const TimerWheel*>( this )->lookup( handle ) );
+}
+
+
+const TimerWheel::Entry*
+TimerWheel::lookup( Handle handle ) const
+{
+    const uint32_t index = static_cast<uint32_t>( handle & 0xFFFFFFFF );
+    if( (index == 0) || (index > mEntries.size()) ) return nullptr;
+
+    const Entry& entry = mEntries[index - 1];
+    if( !entry.scheduled || (entry.generation != static_cast<uint32_t>( handle >> 32 )) ) return nullptr;
+
+    return &entry;
+}
+
+
+void
+TimerWheel::link( uint32_t index )
+{
+    Entry& entry = mEntries[index];
+    uint32_t& head = mSlotHeads[entry.dueTick % mSlotHeads.size()];
+
+    entry.prev = NIL;
+    entry.next = head;
+    if( head != NIL ) mEntries[head].prev = index;
+    head = index;
+}
+
+
+void
+TimerWheel::unlink( uint32_t index )
+{
+    Entry& entry = mEntries[index];
+
+    if( entry.prev != NIL )
+    {
+        mEntries[entry.prev].next = entry.next;
+    }
+    else
+    {
+        mSlotHeads[entry.dueTick % mSlotHeads.size()] = entry.next;
+    }
+
+    if( entry.next != NIL ) mEntries[entry.next].prev = entry.prev;
+}
+
+
+void
+TimerWheel::release( uint32_t index )
+{
+    Entry& entry = mEntries[index];
+    entry.scheduled = false;
+    entry.generation++;
+    entry.callback = nullptr;
+    entry.next = mFreeHead;
+    mFreeHead = index;
+    mScheduledCount--;
+}
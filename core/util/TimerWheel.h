@@ -0,0 +1,96 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Hashed timer wheel for large numbers of coarse timers.
+//
+// Time is advanced externally in milliseconds (typically from one periodic
+// timer) and rounded to ticks of a fixed size.  Each timer lives in the slot
+// for its due tick, so arming and cancelling are constant time and advancing
+// a tick only visits the timers that hashed to that slot.  Timers due on the
+// same tick fire together in one batch.
+//
+// Not thread-safe.  Callbacks may schedule and cancel timers, including
+// their own, but must not advance the wheel.
+class TimerWheel
+{
+public:
+
+    // Identifies a scheduled timer.  Handles are never reused, so a stale
+    // handle can safely be cancelled.
+    typedef uint64_t Handle;
+    static const Handle INVALID_HANDLE = 0;
+
+    typedef std::function<void()> Callback;
+
+    TimerWheel( unsigned int tickMillis = 50, unsigned int slotCount = 512 );
+
+    // Schedule a callback to run after a delay, rounded up to whole ticks
+    // (minimum of one tick).
+    Handle schedule( uint64_t delayMillis, const Callback& callback );
+
+    // Schedule a callback to run once the given time is reached, rounded
+    // up to a whole tick.  Times in the past run on the next tick.
+    Handle scheduleAt( uint64_t dueMillis, const Callback& callback );
+
+    // Cancel a timer.  Returns false if it had already fired or been
+    // cancelled.
+    bool cancel( Handle handle );
+
+    bool isScheduled( Handle handle ) const;
+
+    // Time until a timer fires relative to the current time, or 0 if the
+    // timer isn't scheduled.
+    uint64_t getMillisRemaining( Handle handle ) const;
+
+    // Advance to a new time, firing every timer that comes due in order
+    // of due tick, and in scheduling order within a tick.  Going backwards
+    // in time is ignored.
+    void advanceTo( uint64_t nowMillis );
+
+    // Time of the last advance.
+    uint64_t getNowMillis() const { return mNowMillis; }
+
+    unsigned int getTickMillis() const { return mTickMillis; }
+    std::size_t getScheduledCount() const { return mScheduledCount; }
+
+private:
+
+    static const uint32_t NIL = 0xFFFFFFFF;
+
+    struct Entry
+    {
+        uint64_t dueTick;
+        uint32_t generation;
+        uint32_t prev;          // slot list links, or free list link in next
+        uint32_t next;
+        bool     scheduled;
+        Callback callback;
+    };
+
+    Entry* lookup( Handle handle );
+    const Entry* lookup( Handle handle ) const;
+
+    void link( uint32_t index );
+    void unlink( uint32_t index );
+    void release( uint32_t index );
+
+    const unsigned int    mTickMillis;
+    std::vector<uint32_t> mSlotHeads;
+
+    // Entries are pooled and recycled through a free list.
+    std::vector<Entry> mEntries;
+    uint32_t           mFreeHead;
+    std::size_t        mScheduledCount;
+
+    uint64_t mNowMillis;
+    uint64_t mCurrentTick;
+
+    // Reused while firing a tick.
+    std::vector<Handle> mDueHandles;
+};
+
+#endif  // TIMERWHEEL_H
@@ -22,6 +22,15 @@ CATCH_TEST_CASE( "icompare", "[stringutil]" )
     CATCH_REQUIRE_FALSE( icompare( "TEST", "1234" ) );
 }
 
+CATCH_TEST_CASE( "toLower", "[stringutil]" )
+{
+    CATCH_REQUIRE( toLower( "" ) == "" );
+    CATCH_REQUIRE( toLower( "test" ) == "test" );
+    CATCH_REQUIRE( toLower( "TeSt 1234" ) == "test 1234" );
+    CATCH_REQUIRE( toLower( "Fire // Ice" ) == "fire // ice" );
+    CATCH_REQUIRE( icompare( toLower( "Fire // Ice" ), "FIRE // ICE" ) );
+}
+
 CATCH_TEST_CASE( "trim", "[stringutil]" )
 {
     CATCH_REQUIRE( trim( "" ) == "" );
@@ -0,0 +1,105 @@
+#include "catch.hpp"
+#include "TimerWheel.h"
+
+#include <vector>
+
+CATCH_TEST_CASE( "TimerWheel", "[timerwheel]" )
+{
+    TimerWheel wheel( 100, 8 );
+    std::vector<int> fired;
+
+    CATCH_SECTION( "Timers fire once due" )
+    {
+        wheel.schedule( 250, [&fired] { fired.push_back( 1 ); } );
+        wheel.schedule( 100, [&fired] { fired.push_back( 2 ); } );
+        CATCH_REQUIRE( wheel.getScheduledCount() == 2 );
+
+        wheel.advanceTo( 99 );
+        CATCH_REQUIRE( fired.empty() );
+        wheel.advanceTo( 100 );
+        CATCH_REQUIRE( fired == std::vector<int>( { 2 } ) );
+        wheel.advanceTo( 299 );
+        CATCH_REQUIRE( fired == std::vector<int>( { 2 } ) );
+        wheel.advanceTo( 300 );
+        CATCH_REQUIRE( fired == std::vector<int>( { 2, 1 } ) );
+        CATCH_REQUIRE( wheel.getScheduledCount() == 0 );
+    }
+
+    CATCH_SECTION( "Timers fire in order when catching up" )
+    {
+        wheel.schedule( 500, [&fired] { fired.push_back( 3 ); } );
+        wheel.schedule( 200, [&fired] { fired.push_back( 1 ); } );
+        wheel.schedule( 300, [&fired] { fired.push_back( 2 ); } );
+        wheel.advanceTo( 10000 );
+        CATCH_REQUIRE( fired == std::vector<int>( { 1, 2, 3 } ) );
+    }
+
+    CATCH_SECTION( "Timers beyond one revolution" )
+    {
+        // 8 slots of 100ms: these share a slot with earlier ticks.
+        wheel.schedule( 1700, [&fired] { fired.push_back( 2 ); } );
+        wheel.schedule( 900, [&fired] { fired.push_back( 1 ); } );
+        wheel.advanceTo( 900 );
+        CATCH_REQUIRE( fired == std::vector<int>( { 1 } ) );
+        CATCH_REQUIRE( wheel.getMillisRemaining( 0 ) == 0 );
+        wheel.advanceTo( 1700 );
+        CATCH_REQUIRE( fired == std::vector<int>( { 1, 2 } ) );
+    }
+
+    CATCH_SECTION( "Cancel" )
+    {
+        TimerWheel::Handle handle = wheel.schedule( 200, [&fired] { fired.push_back( 1 ); } );
+        CATCH_REQUIRE( wheel.isScheduled( handle ) );
+        CATCH_REQUIRE( wheel.getMillisRemaining( handle ) == 200 );
+        CATCH_REQUIRE( wheel.cancel( handle ) );
+        CATCH_REQUIRE_FALSE( wheel.cancel( handle ) );
+        CATCH_REQUIRE_FALSE( wheel.isScheduled( handle ) );
+        CATCH_REQUIRE_FALSE( wheel.cancel( TimerWheel::INVALID_HANDLE ) );
+
+        // A recycled entry gets a new handle; the stale one stays dead.
+        TimerWheel::Handle newHandle = wheel.schedule( 200, [&fired] { fired.push_back( 2 ); } );
+        CATCH_REQUIRE( newHandle != handle );
+        CATCH_REQUIRE_FALSE( wheel.cancel( handle ) );
+
+        wheel.advanceTo( 1000 );
+        CATCH_REQUIRE( fired == std::vector<int>( { 2 } ) );
+    }
+
+    CATCH_SECTION( "Callbacks can modify the wheel" )
+    {
+        TimerWheel::Handle victim = TimerWheel::INVALID_HANDLE;
+        wheel.schedule( 100, [&] {
+                fired.push_back( 1 );
+                wheel.cancel( victim );
+                wheel.schedule( 100, [&fired] { fired.push_back( 3 ); } );
+            } );
+        victim = wheel.schedule( 100, [&fired] { fired.push_back( 2 ); } );
+
+        wheel.advanceTo( 100 );
+        CATCH_REQUIRE( fired == std::vector<int>( { 1 } ) );
+        wheel.advanceTo( 200 );
+        CATCH_REQUIRE( fired == std::vector<int>( { 1, 3 } ) );
+    }
+
+    CATCH_SECTION( "Rounding" )
+    {
+        wheel.advanceTo( 150 );
+
+        // Delays round up to the next tick.
+        TimerWheel::Handle handle = wheel.schedule( 10, [&fired] { fired.push_back( 1 ); } );
+        CATCH_REQUIRE( wheel.getMillisRemaining( handle ) == 50 );
+
+        // Past times run on the next tick.
+        wheel.scheduleAt( 0, [&fired] { fired.push_back( 2 ); } );
+        wheel.advanceTo( 200 );
+        CATCH_REQUIRE( fired.size() == 2 );
+
+        // Timers scheduled at the same time fire in the same tick.
+        wheel.scheduleAt( 1000, [&fired] { fired.push_back( 3 ); } );
+        wheel.scheduleAt( 1000, [&fired] { fired.push_back( 4 ); } );
+        wheel.advanceTo( 999 );
+        CATCH_REQUIRE( fired.size() == 2 );
+        wheel.advanceTo( 1000 );
+        CATCH_REQUIRE( fired.size() == 4 );
+    }
+}
@@ -2,9 +2,9 @@
 #include "SimpleRandGen.h"
 
 
-BoosterDispenser::BoosterDispenser( const proto::DraftConfig::CardDispenser&  dispenserSpec,
-                                    const std::shared_ptr<const AllSetsData>& allSetsData,
-                                    const Logging::Config&                    loggingConfig )
+BoosterDispenser::BoosterDispenser( const proto::DraftConfig::CardDispenser&           dispenserSpec,
+                                    const std::shared_ptr<const BoosterTemplateCache>& boosterTemplateCache,
+                                    const Logging::Config&                             loggingConfig )
   : mValid( false ),
     mLogger( loggingConfig.createLogger() )
 {
@@ -23,23 +23,22 @@ BoosterDispenser::BoosterDispenser( const proto::DraftConfig::CardDispenser&  di
     }
 
     mSetCode = dispenserSpec.source_booster_set_codes( 0 );
-    mBoosterSlots = allSetsData->getBoosterSlots( mSetCode );
+    mBoosterTemplate = boosterTemplateCache->getBoosterTemplate( mSetCode );
 
-    if( mBoosterSlots.empty() )
+    if( mBoosterTemplate->getBoosterSlots().empty() )
     {
         mLogger->error( "set {} does not have booster slots!", mSetCode );
         return;
     }
 
-    std::multimap<RarityType,std::string> rarityMap = allSetsData->getCardPool( mSetCode );
-    if( rarityMap.empty() )
+    if( mBoosterTemplate->getCardCount() == 0 )
     {
         mLogger->error( "set {} does not have rarities!", mSetCode );
         return;
     }
 
     auto rng = std::shared_ptr<RandGen>( new SimpleRandGen() );
-    mCardPoolSelector = std::make_shared<CardPoolSelector>( rarityMap, rng );
+    mCardPoolSelector = std::make_shared<CardPoolSelector>( mBoosterTemplate, rng );
 
     mValid = true;
 
@@ -53,13 +52,12 @@ BoosterDispenser::reset()
     mCards.clear();
     mCardPoolSelector->resetCardPool();
 
-    for( std::vector<SlotType>::size_type i = 0; i < mBoosterSlots.size(); ++i )
+    for( const SlotType& slot : mBoosterTemplate->getBoosterSlots() )
     {
-        std::string selectedCard;
-        bool result = mCardPoolSelector->selectCard( mBoosterSlots[i], selectedCard );
-        if( result )
+        const std::string* selectedCard = mCardPoolSelector->selectCard( slot );
+        if( selectedCard != nullptr )
         {
-            mCards.push_back( DraftCard( selectedCard, mSetCode ) );
+            mCards.push_back( DraftCard( *selectedCard, mSetCode ) );
         }
         else
         {
@@ -2,7 +2,7 @@
 #define BOOSTERDISPENSER_H
 
 #include "DraftCardDispenser.h"
-#include "AllSetsData.h"
+#include "BoosterTemplate.h"
 #include "CardPoolSelector.h"
 #include "DraftTypes.h"
 
@@ -10,9 +10,9 @@ class BoosterDispenser : public DraftCardDispenser<DraftCard>
 {
 public:
 
-    BoosterDispenser( const proto::DraftConfig::CardDispenser&  dispenserSpec,
-                      const std::shared_ptr<const AllSetsData>& allSetsData,
-                      const Logging::Config&                    loggingConfig = Logging::Config() );
+    BoosterDispenser( const proto::DraftConfig::CardDispenser&           dispenserSpec,
+                      const std::shared_ptr<const BoosterTemplateCache>& boosterTemplateCache,
+                      const Logging::Config&                             loggingConfig = Logging::Config() );
 
     bool isValid() const { return mValid; }
 
@@ -23,12 +23,12 @@ private:
 
     void reset();
 
-    bool                              mValid;
-    std::string                       mSetCode;
-    std::vector<SlotType>             mBoosterSlots;
-    std::deque<DraftCard>             mCards;
-    std::shared_ptr<CardPoolSelector> mCardPoolSelector;
-    std::shared_ptr<spdlog::logger>   mLogger;
+    bool                                   mValid;
+    std::string                            mSetCode;
+    std::shared_ptr<const BoosterTemplate> mBoosterTemplate;
+    std::deque<DraftCard>                  mCards;
+    std::shared_ptr<CardPoolSelector>      mCardPoolSelector;
+    std::shared_ptr<spdlog::logger>        mLogger;
 };
 
 #endif
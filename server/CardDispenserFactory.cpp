@@ -6,9 +6,9 @@
 // The configuration should be validated before creating dispensers.
 
 CardDispenserFactory::CardDispenserFactory( 
-        const std::shared_ptr<const AllSetsData>& allSetsData,
-        const Logging::Config&                    loggingConfig )
-  : mAllSetsData( allSetsData ),
+        const std::shared_ptr<const BoosterTemplateCache>& boosterTemplateCache,
+        const Logging::Config&                             loggingConfig )
+  : mBoosterTemplateCache( boosterTemplateCache ),
     mLoggingConfig( loggingConfig ),
     mLogger( loggingConfig.createLogger() )
 {}
@@ -17,7 +17,8 @@ CardDispenserFactory::CardDispenserFactory(
 // Create dispensers based on DraftConfig.  Returns an empty list if an error occurred.
 DraftCardDispenserSharedPtrVector<DraftCard>
 CardDispenserFactory::createCardDispensers(
-        const proto::DraftConfig& draftConfig ) const
+        const proto::DraftConfig&                                         draftConfig,
+        const std::vector<CustomCardListDispenser::CardPoolSharedPtr>&    customCardListPools ) const
 {
     DraftCardDispenserSharedPtrVector<DraftCard> dispensers;
 
@@ -26,7 +27,7 @@ CardDispenserFactory::createCardDispensers(
         const proto::DraftConfig::CardDispenser& disp = draftConfig.dispensers( d );
         if( (disp.source_booster_set_codes_size() > 0) )
         {
-            BoosterDispenser* boosterDisp = new BoosterDispenser( disp, mAllSetsData, mLoggingConfig.createChildConfig( "boosterdispenser" ) );
+            BoosterDispenser* boosterDisp = new BoosterDispenser( disp, mBoosterTemplateCache, mLoggingConfig.createChildConfig( "boosterdispenser" ) );
             if( boosterDisp->isValid() )
             {
                 auto sptr = std::shared_ptr<DraftCardDispenser<DraftCard>>( boosterDisp );
@@ -44,7 +45,11 @@ CardDispenserFactory::createCardDispensers(
             if( cclIndex < draftConfig.custom_card_lists_size() )
             {
                 const proto::DraftConfig::CustomCardList& ccl = draftConfig.custom_card_lists( cclIndex );
-                CustomCardListDispenser* cclDisp = new CustomCardListDispenser( disp, ccl, mLoggingConfig.createChildConfig( "ccldispenser" ) );
+                const bool pooled = (cclIndex < (int)customCardListPools.size()) && customCardListPools[cclIndex];
+                const CustomCardListDispenser::CardPoolSharedPtr cardPool = pooled ? customCardListPools[cclIndex] :
+                        CustomCardListDispenser::createCardPool( ccl, mBoosterTemplateCache->getAllSetsData() );
+                CustomCardListDispenser* cclDisp =
+                        new CustomCardListDispenser( disp, cardPool, mLoggingConfig.createChildConfig( "ccldispenser" ) );
                 if( cclDisp->isValid() )
                 {
                     auto sptr = std::shared_ptr<DraftCardDispenser<DraftCard>>( cclDisp );
@@ -2,11 +2,12 @@
 #define CARDDISPENSERFACTORY_H
 
 #include "DraftConfig.pb.h"
-#include "AllSetsData.h"
+#include "BoosterTemplate.h"
 #include "CardPoolSelector.h"
 #include "SimpleRandGen.h"
 #include "DraftTypes.h"
 #include "DraftCardDispenser.h"
+#include "CustomCardListDispenser.h"
 #include <memory>
 
 // Creates dispensers for a given draft configuration.
@@ -17,19 +18,23 @@ class CardDispenserFactory
 public:
 
     explicit CardDispenserFactory( 
-            const std::shared_ptr<const AllSetsData>& allSetsData,
-            const Logging::Config&                    loggingConfig = Logging::Config() );
+            const std::shared_ptr<const BoosterTemplateCache>& boosterTemplateCache,
+            const Logging::Config&                             loggingConfig = Logging::Config() );
 
 
     // Create dispensers based on DraftConfig.  Returns an empty list if an error occurred.
+    // Custom card lists with an entry in customCardListPools use that
+    // (shared) pool instead of the list's card quantities.
     DraftCardDispenserSharedPtrVector<DraftCard> createCardDispensers(
-            const proto::DraftConfig& draftConfig ) const;
+            const proto::DraftConfig&                                         draftConfig,
+            const std::vector<CustomCardListDispenser::CardPoolSharedPtr>&    customCardListPools =
+                    std::vector<CustomCardListDispenser::CardPoolSharedPtr>() ) const;
 
 private:
 
-    std::shared_ptr<const AllSetsData>  mAllSetsData;
-    Logging::Config                     mLoggingConfig;
-    std::shared_ptr<spdlog::logger>     mLogger;
+    std::shared_ptr<const BoosterTemplateCache> mBoosterTemplateCache;
+    Logging::Config                             mLoggingConfig;
+    std::shared_ptr<spdlog::logger>             mLogger;
 };
 
 #endif
@@ -1,16 +1,32 @@
 #include "ClientConnection.h"
 
+#include <QThread>
+#include <QThreadStorage>
+
+const std::size_t ClientConnection::RX_ARENA_BLOCK_SIZE;
+
 
 ClientConnection::ClientConnection( const Logging::Config& loggingConfig, QObject* parent )
-  : NetConnection( loggingConfig, parent )
+  : NetConnection( loggingConfig, parent ),
+    mRxArenaBlock( RX_ARENA_BLOCK_SIZE ),
+    mRxArena( makeRxArenaOptions( mRxArenaBlock ) )
 {
-    QObject::connect( this, &NetConnection::msgReceived, this, &ClientConnection::handleMsgReceived );
     setRxInactivityAbortTime( 30000 );
 }
 
 
-bool
-ClientConnection::sendProtoMsg( const proto::ServerToClientMsg& protoMsg )
+google::protobuf::ArenaOptions
+ClientConnection::makeRxArenaOptions( std::vector<char>& block )
+{
+    google::protobuf::ArenaOptions options;
+    options.initial_block = block.data();
+    options.initial_block_size = block.size();
+    return options;
+}
+
+
+static QByteArray
+serializeProtoMsg( const proto::ServerToClientMsg& protoMsg )
 {
     const int protoSize = protoMsg.ByteSize();
 
@@ -18,15 +34,133 @@ ClientConnection::sendProtoMsg( const proto::ServerToClientMsg& protoMsg )
     msgByteArray.resize( protoSize );
     protoMsg.SerializeToArray( msgByteArray.data(), protoSize );
 
-    return sendMsg( msgByteArray );
+    return msgByteArray;
+}
+
+
+// Compression hints by message type.  Card lists, room lists and the
+// like compress well; small responses and indications, and hashes, don't.
+static CompressionPolicy::Hint
+getCompressionHint( const proto::ServerToClientMsg& protoMsg )
+{
+    switch( protoMsg.msg_case() )
+    {
+        case proto::ServerToClientMsg::kAnnouncementsInd:
+        case proto::ServerToClientMsg::kRoomCapabilitiesInd:
+        case proto::ServerToClientMsg::kPlayerInventoryInd:
+        case proto::ServerToClientMsg::kUsersInfoInd:
+        case proto::ServerToClientMsg::kRoomsInfoInd:
+        case proto::ServerToClientMsg::kPublicStateInd:
+        case proto::ServerToClientMsg::kPlayerCurrentPackInd:
+            return CompressionPolicy::HINT_COMPRESSIBLE;
+        case proto::ServerToClientMsg::kLoginRsp:
+        case proto::ServerToClientMsg::kCreateRoomFailureRsp:
+        case proto::ServerToClientMsg::kCreateRoomSuccessRsp:
+        case proto::ServerToClientMsg::kJoinRoomFailureRsp:
+        case proto::ServerToClientMsg::kBoosterDraftStateInd:
+        case proto::ServerToClientMsg::kPlayerNamedCardSelectionRsp:
+        case proto::ServerToClientMsg::kPlayerIndexedCardSelectionRsp:
+        case proto::ServerToClientMsg::kPlayerAutoCardSelectionInd:
+        case proto::ServerToClientMsg::kRoomStageInd:
+        case proto::ServerToClientMsg::kRoomErrorInd:
+        case proto::ServerToClientMsg::kRoomChairsDeckInfoInd:
+            return CompressionPolicy::HINT_INCOMPRESSIBLE;
+        default:
+            return CompressionPolicy::HINT_NONE;
+    }
+}
+
+
+bool
+ClientConnection::sendProtoMsg( const proto::ServerToClientMsg& protoMsg )
+{
+    if( thread() != QThread::currentThread() )
+    {
+        QMetaObject::invokeMethod( this, "sendSerializedMsg", Qt::QueuedConnection,
+                Q_ARG( QByteArray, serializeProtoMsg( protoMsg ) ),
+                Q_ARG( int, getCompressionHint( protoMsg ) ) );
+        return true;
+    }
+
+    // Serialize into this thread's scratch buffer after space for the
+    // frame header, so the frame can be written to the socket in place.
+    static QThreadStorage<std::vector<char>> sSendBuffers;
+    std::vector<char>& sendBuffer = sSendBuffers.localData();
+
+    const int protoSize = protoMsg.ByteSize();
+    sendBuffer.resize( NetConnection::MAX_HEADER_SIZE + protoSize );
+    protoMsg.SerializeWithCachedSizesToArray(
+            reinterpret_cast<google::protobuf::uint8*>( sendBuffer.data() + NetConnection::MAX_HEADER_SIZE ) );
+
+    return sendReservedMsg( sendBuffer.data(), protoSize, getCompressionHint( protoMsg ) );
 }
 
 
 void
-ClientConnection::handleMsgReceived( const QByteArray& msg )
+ClientConnection::sendSerializedMsg( const QByteArray& msg, int compressionHint )
 {
-    proto::ClientToServerMsg protoMsg;
-    bool msgParsed = protoMsg.ParseFromArray( msg.data(), msg.size() );
+    sendMsg( msg, static_cast<CompressionPolicy::Hint>( compressionHint ) );
+}
+
+
+void
+ClientConnection::multicastProtoMsg( const proto::ServerToClientMsg& protoMsg,
+                                     const QList<ClientConnection*>& clientConnections )
+{
+    if( clientConnections.isEmpty() ) return;
+
+    const QByteArray msg = serializeProtoMsg( protoMsg );
+    const CompressionPolicy::Hint compressionHint = getCompressionHint( protoMsg );
+    QThread* const currentThread = QThread::currentThread();
+
+    QList<ClientConnection*> localClientConnections;
+    for( ClientConnection* clientConnection : clientConnections )
+    {
+        if( clientConnection->thread() == currentThread )
+        {
+            localClientConnections.append( clientConnection );
+        }
+        else
+        {
+            // Framing uses the connection's compression state, which
+            // belongs to its own thread.
+            QMetaObject::invokeMethod( clientConnection, "sendSerializedMsg", Qt::QueuedConnection,
+                    Q_ARG( QByteArray, msg ), Q_ARG( int, compressionHint ) );
+        }
+    }
+
+    if( localClientConnections.isEmpty() ) return;
+
+    const QByteArray framedMsg = localClientConnections.first()->frameMsg( msg, compressionHint );
+    if( framedMsg.isEmpty() ) return;
+
+    for( ClientConnection* clientConnection : localClientConnections )
+    {
+        clientConnection->sendFramedMsg( framedMsg );
+    }
+}
+
+
+void
+ClientConnection::moveToOwnerThread( QThread* thread )
+{
+    // The wheel belongs to the current thread; fall back to a QTimer
+    // (which moves along with the connection) until the new owner
+    // attaches its own.
+    setTimerWheel( nullptr );
+    moveToThread( thread );
+}
+
+
+void
+ClientConnection::handleRxMsg( const char* data, int size )
+{
+    // Drop the previous message; the arena keeps its initial block.
+    mRxArena.Reset();
+
+    proto::ClientToServerMsg& protoMsg =
+            *google::protobuf::Arena::CreateMessage<proto::ClientToServerMsg>( &mRxArena );
+    bool msgParsed = protoMsg.ParseFromArray( data, size );
 
     if( !msgParsed )
     {
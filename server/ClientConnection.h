@@ -2,9 +2,18 @@
 #define CLIENTCONNECTION_H
 
 #include <NetConnection.h>
+#include <QList>
+#include <QMetaType>
+#include <vector>
+#include <google/protobuf/arena.h>
 #include "messages.pb.h"
+#include "SimpleVersion.h"
 #include "Logging.h"
 
+QT_BEGIN_NAMESPACE
+class QThread;
+QT_END_NAMESPACE
+
 class ClientConnection : public NetConnection
 {
     Q_OBJECT
@@ -13,13 +22,55 @@ public:
 
     ClientConnection( const Logging::Config& loggingConfig = Logging::Config(), QObject* parent = 0 );
 
+    // Send a message.  May be called from any thread; if the connection
+    // lives on another thread the message is queued to that thread and
+    // the result is always true.
     bool sendProtoMsg( const proto::ServerToClientMsg& protoMsg );
 
+    // Send a message to many connections.  The message is serialized once.
+    // For the connections living on the calling thread it is also
+    // compressed and framed once (with the first connection's modes) and
+    // the same buffer is written to each; the rest get the serialized
+    // message queued to their own threads.
+    static void multicastProtoMsg( const proto::ServerToClientMsg& protoMsg,
+                                   const QList<ClientConnection*>& clientConnections );
+
+    // Hand the connection over to another thread.  Must be called from
+    // the connection's current thread, and the connection must not have
+    // a parent.  The new owner attaches its timer wheel with
+    // setTimerWheel() once it takes over.
+    void moveToOwnerThread( QThread* thread );
+
+    // Protocol version the client reported when it logged in.  Set on the
+    // lobby thread before the connection is handed off to a room.
+    void setProtocolVersion( const SimpleVersion& version ) { mProtocolVersion = version; }
+    const SimpleVersion& getProtocolVersion() const { return mProtocolVersion; }
+
 signals:
     void protoMsgReceived( const proto::ClientToServerMsg& protoMsg );
 
+protected:
+
+    // Parses received messages straight from the receive buffer.
+    virtual void handleRxMsg( const char* data, int size ) override;
+
 private slots:
-    void handleMsgReceived( const QByteArray& msg );
+    void sendSerializedMsg( const QByteArray& msg, int compressionHint );
+
+private:
+
+    // Received messages are parsed onto an arena that is reset for each
+    // message.  The arena starts on a block owned by the connection so
+    // typical messages don't touch the heap.
+    static const std::size_t RX_ARENA_BLOCK_SIZE = 8 * 1024;
+    static google::protobuf::ArenaOptions makeRxArenaOptions( std::vector<char>& block );
+
+    std::vector<char>       mRxArenaBlock;
+    google::protobuf::Arena mRxArena;
+
+    SimpleVersion           mProtocolVersion;
 };
 
+Q_DECLARE_METATYPE( proto::ClientToServerMsg )
+
 #endif
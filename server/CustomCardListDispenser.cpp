@@ -1,5 +1,4 @@
 #include "CustomCardListDispenser.h"
-#include "SimpleRandGen.h"
 
 
 CustomCardListDispenser::CustomCardListDispenser(
@@ -7,22 +6,72 @@ CustomCardListDispenser::CustomCardListDispenser(
         const proto::DraftConfig::CustomCardList& customCardListSpec,
         const Logging::Config&                    loggingConfig )
   : mValid( false ),
+    mCards( createCardPool( customCardListSpec ) ),
+    mRemaining( 0 ),
     mLogger( loggingConfig.createLogger() )
 {
-    // Create pool of cards.
+    initialize();
+}
+
+
+CustomCardListDispenser::CustomCardListDispenser(
+        const proto::DraftConfig::CardDispenser&  dispenserSpec,
+        const CardPoolSharedPtr&                  cardPool,
+        const Logging::Config&                    loggingConfig )
+  : mValid( false ),
+    mCards( cardPool ),
+    mRemaining( 0 ),
+    mLogger( loggingConfig.createLogger() )
+{
+    initialize();
+}
+
+
+CustomCardListDispenser::CardPoolSharedPtr
+CustomCardListDispenser::createCardPool( const proto::DraftConfig::CustomCardList& customCardListSpec,
+                                         const std::shared_ptr<const AllSetsData>& allSetsData )
+{
+    std::vector<AllSetsData::CardResolution> resolutions;
+    if( allSetsData )
+    {
+        std::vector<SimpleCardData> cardList;
+        cardList.reserve( customCardListSpec.card_quantities_size() );
+        for( int i = 0; i < customCardListSpec.card_quantities_size(); ++i )
+        {
+            const proto::DraftConfig::CustomCardList::CardQuantity& cardQty = customCardListSpec.card_quantities( i );
+            cardList.push_back( SimpleCardData( cardQty.name(), cardQty.set_code() ) );
+        }
+        resolutions = allSetsData->resolveCards( cardList );
+    }
+
+    auto cards = std::make_shared<CardPool>();
     for( int i = 0; i < customCardListSpec.card_quantities_size(); ++i )
     {
         const proto::DraftConfig::CustomCardList::CardQuantity& cardQty = customCardListSpec.card_quantities( i );
-        DraftCard dc( cardQty.name(), cardQty.set_code() );
-        mCards.insert( mCards.end(), cardQty.quantity(), dc );
+        // Use the set the card resolved to rather than the one given, so
+        // that unknown set codes never make it into the card table.
+        const bool resolved = !resolutions.empty() && resolutions[i].isResolved();
+        DraftCard dc( cardQty.name(), resolved ? resolutions[i].setCode : cardQty.set_code() );
+        cards->insert( cards->end(), cardQty.quantity(), dc );
     }
+    return cards;
+}
+
 
-    if( mCards.empty() )
+void
+CustomCardListDispenser::initialize()
+{
+    if( !mCards || mCards->empty() )
     {
         mLogger->error( "empty custom card list" );
+        mCards = std::make_shared<CardPool>();
         return;
     }
 
+    mOrder.resize( mCards->size() );
+    for( std::size_t i = 0; i < mOrder.size(); ++i ) mOrder[i] = i;
+    reset();
+
     mValid = true;
 }
 
@@ -30,8 +79,8 @@ CustomCardListDispenser::CustomCardListDispenser(
 void
 CustomCardListDispenser::reset()
 {
-    std::copy( mCardsDispensed.begin(), mCardsDispensed.end(), std::back_inserter( mCards ) );
-    mCardsDispensed.clear();
+    // Any permutation of the indices will do.
+    mRemaining = mOrder.size();
 }
 
 
@@ -40,25 +89,22 @@ CustomCardListDispenser::dispense( unsigned int qty )
 {
     std::vector<DraftCard> cards;
 
-    if( mCards.empty() )
+    if( mCards->empty() )
     {
         mLogger->error( "unexpected empty cards!" );
         return cards;
     }
 
+    cards.reserve( qty );
     for( unsigned int i = 0; i < qty; ++i )
     {
-        // Choose a random card
-        auto iter = mCards.begin();
-        SimpleRandGen rng;
-        const int randAdv = rng.generateInRange( 0, mCards.size() - 1 );
-        std::advance( iter, randAdv );
-        DraftCard card = *iter;
-        mCards.erase( iter );
-        mCardsDispensed.push_back( card );
-        cards.push_back( card );
-
-        if( mCards.empty() ) reset();
+        // Choose a random card and swap it out of the remaining range.
+        const std::size_t choice = mRng.generateInRange( 0, mRemaining - 1 );
+        --mRemaining;
+        std::swap( mOrder[choice], mOrder[mRemaining] );
+        cards.push_back( (*mCards)[mOrder[mRemaining]] );
+
+        if( mRemaining == 0 ) reset();
     }
     return cards;
 }
@@ -67,7 +113,11 @@ std::vector<DraftCard>
 CustomCardListDispenser::dispenseAll()
 {
     std::vector<DraftCard> cards;
-    std::copy( mCards.begin(), mCards.end(), std::back_inserter( cards ) );
+    cards.reserve( mRemaining );
+    for( std::size_t i = 0; i < mRemaining; ++i )
+    {
+        cards.push_back( (*mCards)[mOrder[i]] );
+    }
     reset();
     return cards;
 }
@@ -2,31 +2,60 @@
 #define CUSTOMCARDLISTDISPENSER_H
 
 #include "DraftConfig.pb.h"
+#include "AllSetsData.h"
 #include "DraftTypes.h"
 #include "DraftCardDispenser.h"
-
+#include "SimpleRandGen.h"
+
+// Dispenses cards at random from a fixed pool without replacement.  Once
+// every card has been dispensed the whole pool becomes available again.
+//
+// The pool is never copied or erased from; dispensing shuffles an array
+// of indices into the pool one step at a time (a partial Fisher-Yates
+// shuffle), so each card dispensed is constant time.  Pools are
+// immutable and may be shared between dispensers.
 class CustomCardListDispenser : public DraftCardDispenser<DraftCard>
 {
 public:
 
+    using CardPool = std::vector<DraftCard>;
+    using CardPoolSharedPtr = std::shared_ptr<const CardPool>;
+
     CustomCardListDispenser( const proto::DraftConfig::CardDispenser&  dispenserSpec,
                              const proto::DraftConfig::CustomCardList& customCardListSpec,
                              const Logging::Config&                    loggingConfig = Logging::Config() );
 
+    CustomCardListDispenser( const proto::DraftConfig::CardDispenser&  dispenserSpec,
+                             const CardPoolSharedPtr&                  cardPool,
+                             const Logging::Config&                    loggingConfig = Logging::Config() );
+
     bool isValid() const { return mValid; }
 
-    unsigned int getPoolSize() const { return mCards.size() + mCardsDispensed.size(); }
+    unsigned int getPoolSize() const { return mCards->size(); }
+
+    // Create the pool of cards for a custom card list.  If set data is
+    // given, known cards are given the set they resolve to, which fills
+    // in missing set codes so clients don't each have to look them up and
+    // replaces set codes the data doesn't know.
+    static CardPoolSharedPtr createCardPool( const proto::DraftConfig::CustomCardList& customCardListSpec,
+                                             const std::shared_ptr<const AllSetsData>& allSetsData = nullptr );
 
     virtual std::vector<DraftCard> dispenseAll() override;
     virtual std::vector<DraftCard> dispense( unsigned int quantity ) override;
 
 private:
 
+    void initialize();
     void reset();
 
     bool                              mValid;
-    std::vector<DraftCard>            mCards;
-    std::vector<DraftCard>            mCardsDispensed;
+    CardPoolSharedPtr                 mCards;
+
+    // Indices into mCards.  The first mRemaining have yet to be dispensed.
+    std::vector<std::size_t>          mOrder;
+    std::size_t                       mRemaining;
+
+    SimpleRandGen                     mRng;
     std::shared_ptr<spdlog::logger>   mLogger;
 };
 
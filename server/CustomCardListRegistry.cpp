@@ -0,0 +1,90 @@
+#include "CustomCardListRegistry.h"
+
+#include "CustomCardListHash.h"
+
+
+CustomCardListRegistry::CustomCardListRegistry( std::size_t                               maxRetained,
+                                                const std::shared_ptr<const AllSetsData>& allSetsData,
+                                                const Logging::Config&                    loggingConfig )
+  : mMaxRetained( maxRetained ),
+    mAllSetsData( allSetsData ),
+    mLogger( loggingConfig.createLogger() )
+{}
+
+
+CustomCardListRegistry::CardPoolSharedPtr
+CustomCardListRegistry::registerList( const proto::DraftConfig::CustomCardList& customCardList,
+                                      std::string&                              contentHash )
+{
+    // Always hash the cards here rather than trusting a hash from the client.
+    contentHash = computeCustomCardListHash( customCardList );
+
+    CardPoolSharedPtr pool = find( contentHash );
+    if( pool )
+    {
+        mLogger->debug( "custom card list '{}' already registered", customCardList.name() );
+        return pool;
+    }
+
+    pool = CustomCardListDispenser::createCardPool( customCardList, mAllSetsData );
+    if( pool->empty() )
+    {
+        mLogger->notice( "not registering empty custom card list '{}'", customCardList.name() );
+        return CardPoolSharedPtr();
+    }
+
+    purgeExpired();
+    mPools[contentHash] = pool;
+    retain( pool );
+    mLogger->debug( "registered custom card list '{}' ({} cards), {} lists registered",
+            customCardList.name(), pool->size(), mPools.size() );
+    return pool;
+}
+
+
+CustomCardListRegistry::CardPoolSharedPtr
+CustomCardListRegistry::find( const std::string& contentHash )
+{
+    auto iter = mPools.find( contentHash );
+    if( iter == mPools.end() ) return CardPoolSharedPtr();
+
+    CardPoolSharedPtr pool = iter->second.lock();
+    if( pool )
+    {
+        retain( pool );
+    }
+    else
+    {
+        mPools.erase( iter );
+    }
+    return pool;
+}
+
+
+void
+CustomCardListRegistry::retain( const CardPoolSharedPtr& pool )
+{
+    mRetainedPools.remove( pool );
+    mRetainedPools.push_front( pool );
+    while( mRetainedPools.size() > mMaxRetained )
+    {
+        mRetainedPools.pop_back();
+    }
+}
+
+
+void
+CustomCardListRegistry::purgeExpired()
+{
+    for( auto iter = mPools.begin(); iter != mPools.end(); )
+    {
+        if( iter->second.expired() )
+        {
+            iter = mPools.erase( iter );
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+}
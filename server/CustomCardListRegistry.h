@@ -0,0 +1,58 @@
+#ifndef CUSTOMCARDLISTREGISTRY_H
+#define CUSTOMCARDLISTREGISTRY_H
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include "CustomCardListDispenser.h"
+#include "Logging.h"
+
+// Registry of custom card lists (i.e. cubes) keyed by content hash, so a
+// list sent by one client is stored once and can afterward be referred to
+// by hash alone.  Each list is held as an immutable card pool shared by
+// every room using it.
+//
+// Pools stay registered while any room holds them.  The most recently
+// used pools are also kept after their rooms go away so popular lists
+// don't have to be resent.
+class CustomCardListRegistry
+{
+public:
+
+    using CardPoolSharedPtr = CustomCardListDispenser::CardPoolSharedPtr;
+
+    // Set data, if given, is used to fill in missing set codes.
+    CustomCardListRegistry( std::size_t                               maxRetained,
+                            const std::shared_ptr<const AllSetsData>& allSetsData,
+                            const Logging::Config&                    loggingConfig = Logging::Config() );
+
+    // Register a list with card quantities and return its pool, or
+    // nullptr if the list has no cards.  Sets contentHash to the list's
+    // hash.  Registering a list that is already known returns the
+    // existing pool.
+    CardPoolSharedPtr registerList( const proto::DraftConfig::CustomCardList& customCardList,
+                                    std::string&                              contentHash );
+
+    // Find the pool for a content hash, or nullptr if it isn't registered.
+    CardPoolSharedPtr find( const std::string& contentHash );
+
+    std::size_t getCount() const { return mPools.size(); }
+
+private:
+
+    void retain( const CardPoolSharedPtr& pool );
+    void purgeExpired();
+
+    using CardPoolWeakPtr = std::weak_ptr<const CustomCardListDispenser::CardPool>;
+
+    const std::size_t                                    mMaxRetained;
+    const std::shared_ptr<const AllSetsData>             mAllSetsData;
+    std::unordered_map<std::string,CardPoolWeakPtr>      mPools;
+
+    // Most recently used at the front.
+    std::list<CardPoolSharedPtr>                         mRetainedPools;
+
+    std::shared_ptr<spdlog::logger>                      mLogger;
+};
+
+#endif  // CUSTOMCARDLISTREGISTRY_H
@@ -0,0 +1,162 @@
+#include "DeckHashing.h"
+
+#include <QCryptographicHash>
+#include <QRegularExpression>
+
+
+CockatriceDeckHasher::CockatriceDeckHasher()
+  : mHashValid( false )
+{}
+
+
+void
+CockatriceDeckHasher::addCard( const std::string& name, PlayerInventory::ZoneType zone )
+{
+    if( !isHashedZone( zone ) ) return;
+    adjustEntry( getEntryName( name, zone ), 1 );
+}
+
+
+void
+CockatriceDeckHasher::removeCard( const std::string& name, PlayerInventory::ZoneType zone )
+{
+    if( !isHashedZone( zone ) ) return;
+    adjustEntry( getEntryName( name, zone ), -1 );
+}
+
+
+void
+CockatriceDeckHasher::moveCard( const std::string&        name,
+                                PlayerInventory::ZoneType zoneFrom,
+                                PlayerInventory::ZoneType zoneTo )
+{
+    removeCard( name, zoneFrom );
+    addCard( name, zoneTo );
+}
+
+
+void
+CockatriceDeckHasher::adjustBasicLand( BasicLandType basic, PlayerInventory::ZoneType zone, int adj )
+{
+    if( !isHashedZone( zone ) || (adj == 0) ) return;
+
+    // Basic land names are only lowercased.
+    QString entryName = QString::fromStdString( stringify( basic ) ).toLower();
+    if( zone == PlayerInventory::ZONE_SIDEBOARD ) entryName.prepend( "SB:" );
+    adjustEntry( entryName, adj );
+}
+
+
+void
+CockatriceDeckHasher::reset( const PlayerInventory& inv )
+{
+    clear();
+
+    for( auto zone : { PlayerInventory::ZONE_MAIN, PlayerInventory::ZONE_SIDEBOARD } )
+    {
+        for( const auto& kv : inv.getCardGroups( zone ) )
+        {
+            for( std::size_t i = 0; i < kv.second.size(); ++i )
+            {
+                addCard( kv.first.second, zone );
+            }
+        }
+
+        BasicLandQuantities basics = inv.getBasicLandQuantities( zone );
+        for( auto basic : gBasicLandTypeArray )
+        {
+            adjustBasicLand( basic, zone, basics.getQuantity( basic ) );
+        }
+    }
+}
+
+
+void
+CockatriceDeckHasher::clear()
+{
+    mEntries.clear();
+    mHashValid = false;
+}
+
+
+const QString&
+CockatriceDeckHasher::getHash() const
+{
+    if( mHashValid ) return mHash;
+
+    // Hash the sorted entries joined with ';' without building the
+    // joined string.
+    QCryptographicHash sha1( QCryptographicHash::Sha1 );
+    bool first = true;
+    for( const auto& kv : mEntries )
+    {
+        for( int i = 0; i < kv.second.count; ++i )
+        {
+            if( !first ) sha1.addData( ";", 1 );
+            sha1.addData( kv.second.utf8 );
+            first = false;
+        }
+    }
+
+    QByteArray rawHash = sha1.result();
+    quint64 number =  (((quint64) (unsigned char) rawHash[0]) << 32)
+                    + (((quint64) (unsigned char) rawHash[1]) << 24)
+                    + (((quint64) (unsigned char) rawHash[2]) << 16)
+                    + (((quint64) (unsigned char) rawHash[3]) << 8)
+                    +   (quint64) (unsigned char) rawHash[4];
+    mHash = QString::number( number, 32 ).rightJustified( 8, '0' );
+    mHashValid = true;
+
+    return mHash;
+}
+
+
+bool
+CockatriceDeckHasher::isHashedZone( PlayerInventory::ZoneType zone )
+{
+    return (zone == PlayerInventory::ZONE_MAIN) || (zone == PlayerInventory::ZONE_SIDEBOARD);
+}
+
+
+QString
+CockatriceDeckHasher::getEntryName( const std::string& name, PlayerInventory::ZoneType zone )
+{
+    auto iter = mNormalizedNames.find( name );
+    if( iter == mNormalizedNames.end() )
+    {
+        QString normalizedName = QString::fromStdString( name );
+
+        // Replace UTF-8 chars as Cockatrice does (see Cockatrice/common/decklist.cpp).
+        normalizedName.replace( "Æ", "AE" );
+        normalizedName.replace( "’", "'" );
+
+        // Fix slashes for split cards as Cockatrice does.
+        normalizedName.replace( QRegularExpression( "\\s*/+\\s*" ), " // " );
+
+        iter = mNormalizedNames.insert( std::make_pair( name, normalizedName.toLower() ) ).first;
+    }
+
+    return (zone == PlayerInventory::ZONE_SIDEBOARD) ? ("SB:" + iter->second) : iter->second;
+}
+
+
+void
+CockatriceDeckHasher::adjustEntry( const QString& entryName, int adj )
+{
+    Entry& entry = mEntries[entryName];
+    if( entry.utf8.isEmpty() ) entry.utf8 = entryName.toUtf8();
+
+    entry.count += adj;
+    if( entry.count <= 0 ) mEntries.erase( entryName );
+
+    mHashValid = false;
+}
+
+
+QString
+computeCockatriceHash( const PlayerInventory& inv )
+{
+    CockatriceDeckHasher hasher;
+    hasher.reset( inv );
+    return hasher.getHash();
+}
@@ -1,60 +1,61 @@
 #ifndef DECKHASHING_H
 #define DECKHASHING_H
 
+#include <QByteArray>
 #include <QString>
-#include <QStringList>
-#include <QRegularExpression>
-#include <QCryptographicHash>
+#include <map>
+#include <string>
+#include <unordered_map>
 #include "PlayerInventory.h"
 
-inline QString
-computeCockatriceHash( const PlayerInventory& inv )
+// Maintains the Cockatrice hash of a deck as cards move in and out of
+// the main and sideboard zones of an inventory (other zones are ignored).
+// Each card name is normalized once and cached, the sorted list of
+// deck entries is kept up to date as a multiset, and only the SHA-1 is
+// redone when the hash is requested after a change.
+class CockatriceDeckHasher
 {
-    QStringList deck;
+public:
 
-    for( auto zone : { PlayerInventory::ZONE_MAIN, PlayerInventory::ZONE_SIDEBOARD } )
+    CockatriceDeckHasher();
+
+    void addCard( const std::string& name, PlayerInventory::ZoneType zone );
+    void removeCard( const std::string& name, PlayerInventory::ZoneType zone );
+    void moveCard( const std::string& name, PlayerInventory::ZoneType zoneFrom,
+                                            PlayerInventory::ZoneType zoneTo );
+    void adjustBasicLand( BasicLandType basic, PlayerInventory::ZoneType zone, int adj = 1 );
+
+    // Rebuild from the contents of an inventory.
+    void reset( const PlayerInventory& inv );
+    void clear();
+
+    const QString& getHash() const;
+
+private:
+
+    struct Entry
     {
-        for( auto card : inv.getCards( zone ) )
-        {
-            QString name = QString::fromStdString( card->getName() );
-
-            // Replace UTF-8 chars as Cockatrice does (see Cockatrice/common/decklist.cpp).
-            name.replace( "Æ", "AE" );
-            name.replace( "’", "'" );
-
-            // Fix slashes for split cards as Cockatrice does.
-            name.replace( QRegularExpression( "\\s*/+\\s*" ), " // " );
-
-            name = name.toLower();
-            if( zone == PlayerInventory::ZONE_SIDEBOARD ) name.prepend( "SB:" );
-            deck.push_back( name );
-        }
-
-        BasicLandQuantities basics = inv.getBasicLandQuantities( zone );
-        for( auto basic : gBasicLandTypeArray )
-        {
-            for( int i = 0; i < basics.getQuantity( basic ); ++i )
-            {
-                QString name = QString::fromStdString( stringify( basic ) ).toLower();
-                if( zone == PlayerInventory::ZONE_SIDEBOARD ) name.prepend( "SB:" );
-                deck.push_back( name );
-            }
-        }
-    }
-
-    deck.sort();
-    QString joinedDeck = deck.join( ';' );
-
-    QByteArray rawHash = QCryptographicHash::hash( joinedDeck.toUtf8(),
-            QCryptographicHash::Sha1 );
-    quint64 number =  (((quint64) (unsigned char) rawHash[0]) << 32)
-                    + (((quint64) (unsigned char) rawHash[1]) << 24)
-                    + (((quint64) (unsigned char) rawHash[2]) << 16)
-                    + (((quint64) (unsigned char) rawHash[3]) << 8)
-                    +   (quint64) (unsigned char) rawHash[4];
-    QString hash = QString::number( number, 32 ).rightJustified( 8, '0' );
-
-    return hash;
-}
+        Entry() : count( 0 ) {}
+        int        count;
+        QByteArray utf8;
+    };
+
+    static bool isHashedZone( PlayerInventory::ZoneType zone );
+
+    QString getEntryName( const std::string& name, PlayerInventory::ZoneType zone );
+    void adjustEntry( const QString& entryName, int adj );
+
+    // Normalized card names by card name.
+    std::unordered_map<std::string,QString> mNormalizedNames;
+
+    // Deck entries in the order Cockatrice sorts them.
+    std::map<QString,Entry> mEntries;
+
+    mutable bool    mHashValid;
+    mutable QString mHash;
+};
+
+// Compute the Cockatrice hash of the main deck and sideboard from scratch.
+QString computeCockatriceHash( const PlayerInventory& inv );
 
 #endif
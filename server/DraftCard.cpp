@@ -0,0 +1,131 @@
+#include "DraftCard.h"
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+
+struct Entry
+{
+    std::string name;
+    std::string setCode;
+};
+
+// Entries are stored in fixed-size chunks that are never reallocated, so
+// a reader holding a handle (which it can only have obtained after the
+// entry was written) never needs to take the lock.
+const unsigned int CHUNK_SIZE = 4096;
+const unsigned int MAX_CHUNKS = 4096;
+
+class CardTable
+{
+public:
+
+    CardTable() : mSize( 0 ) {}
+
+    DraftCard::Id find( const std::string& name, const std::string& setCode ) const
+    {
+        std::lock_guard<std::mutex> lock( mMutex );
+        return findLocked( name, setCode );
+    }
+
+    DraftCard::Id intern( const std::string& name, const std::string& setCode )
+    {
+        std::lock_guard<std::mutex> lock( mMutex );
+
+        DraftCard::Id id = findLocked( name, setCode );
+        if( id != DraftCard::INVALID_ID ) return id;
+
+        if( mSize >= CHUNK_SIZE * MAX_CHUNKS )
+        {
+            // Not expected in practice; degrade to an invalid card.
+            return DraftCard::INVALID_ID;
+        }
+
+        id = mSize;
+        std::unique_ptr<Entry[]>& chunk = mChunks[id / CHUNK_SIZE];
+        if( !chunk ) chunk.reset( new Entry[CHUNK_SIZE] );
+        Entry& entry = chunk[id % CHUNK_SIZE];
+        entry.name = name;
+        entry.setCode = setCode;
+        mIds[setCode][name] = id;
+        mSize++;
+        return id;
+    }
+
+    const Entry& get( DraftCard::Id id ) const
+    {
+        return mChunks[id / CHUNK_SIZE][id % CHUNK_SIZE];
+    }
+
+    unsigned int size() const
+    {
+        std::lock_guard<std::mutex> lock( mMutex );
+        return mSize;
+    }
+
+private:
+
+    // Lookups are keyed set code first so that an existing card can be
+    // found without building a combined key.
+    DraftCard::Id findLocked( const std::string& name, const std::string& setCode ) const
+    {
+        auto setIter = mIds.find( setCode );
+        if( setIter == mIds.end() ) return DraftCard::INVALID_ID;
+        auto nameIter = setIter->second.find( name );
+        return (nameIter != setIter->second.end()) ? nameIter->second : DraftCard::INVALID_ID;
+    }
+
+    mutable std::mutex                                                             mMutex;
+    std::array<std::unique_ptr<Entry[]>,MAX_CHUNKS>                                mChunks;
+    unsigned int                                                                   mSize;
+    std::unordered_map<std::string,std::unordered_map<std::string,DraftCard::Id>> mIds;
+};
+
+CardTable& getCardTable()
+{
+    static CardTable table;
+    return table;
+}
+
+const std::string gEmptyString;
+
+}
+
+
+DraftCard
+DraftCard::find( const std::string& name, const std::string& setCode )
+{
+    return DraftCard( getCardTable().find( name, setCode ) );
+}
+
+
+DraftCard::Id
+DraftCard::intern( const std::string& name, const std::string& setCode )
+{
+    return getCardTable().intern( name, setCode );
+}
+
+
+const std::string&
+DraftCard::getName() const
+{
+    return isValid() ? getCardTable().get( mId ).name : gEmptyString;
+}
+
+
+const std::string&
+DraftCard::getSetCode() const
+{
+    return isValid() ? getCardTable().get( mId ).setCode : gEmptyString;
+}
+
+
+unsigned int
+DraftCard::getTableSize()
+{
+    return getCardTable().size();
+}
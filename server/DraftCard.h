@@ -0,0 +1,67 @@
+#ifndef DRAFTCARD_H
+#define DRAFTCARD_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+// Handle to an interned (name, set code) pair in a process-wide card
+// table.  Handles are 32 bits and cheap to copy and compare, so drafts
+// pass them around instead of strings; the strings are only needed at
+// the protocol boundary.  Table entries are never removed or modified,
+// so a handle stays valid for the life of the process.
+class DraftCard
+{
+public:
+
+    typedef uint32_t Id;
+
+    static const Id INVALID_ID = 0xFFFFFFFF;
+
+    // Creates an invalid card.
+    DraftCard() : mId( INVALID_ID ) {}
+
+    // Interns the pair if not already in the table.
+    DraftCard( const std::string& name, const std::string& setCode ) : mId( intern( name, setCode ) ) {}
+
+    // Returns the card for a pair only if it's already in the table,
+    // otherwise an invalid card.  Use for untrusted input so that it can't
+    // grow the table.
+    static DraftCard find( const std::string& name, const std::string& setCode );
+
+    Id getId() const { return mId; }
+    bool isValid() const { return mId != INVALID_ID; }
+
+    // Empty strings for an invalid card.
+    const std::string& getName() const;
+    const std::string& getSetCode() const;
+
+    // Number of distinct cards interned.
+    static unsigned int getTableSize();
+
+private:
+
+    explicit DraftCard( Id id ) : mId( id ) {}
+
+    static Id intern( const std::string& name, const std::string& setCode );
+
+    Id mId;
+};
+
+inline bool operator==( const DraftCard& a, const DraftCard& b )
+{
+    return a.getId() == b.getId();
+}
+
+inline bool operator!=( const DraftCard& a, const DraftCard& b )
+{
+    return a.getId() != b.getId();
+}
+
+inline std::ostream& operator<<( std::ostream& os, const DraftCard& d )
+{
+    os << '[' << d.getSetCode() << ',' << d.getName() << ']';
+    return os;
+}
+
+#endif
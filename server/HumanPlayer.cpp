@@ -2,6 +2,7 @@
 #include "SimpleRandGen.h"
 #include "SimpleCardData.h"
 #include "ProtoHelper.h"
+#include "ServerMsgBuilder.h"
 
 
 void
@@ -40,7 +41,7 @@ HumanPlayer::notifyNamedCardSelectionResult( DraftType& draft, uint32_t packId,
     mLogger->debug( "notifyNamedCardSelectionResult" );
 
     // Create card to be added to inventory.
-    auto cardData = std::make_shared<SimpleCardData>( card.name, card.setCode );
+    auto cardData = std::make_shared<SimpleCardData>( card.getName(), card.getSetCode() );
 
     if( result )
     {
@@ -51,13 +52,13 @@ HumanPlayer::notifyNamedCardSelectionResult( DraftType& draft, uint32_t packId,
             // Send autoselect "time expired" indication.
             sendPlayerAutoCardSelectionInd(
                     proto::PlayerAutoCardSelectionInd::AUTO_TIMED_OUT, packId, card );
-            mInventory.add( cardData, PlayerInventory::ZONE_AUTO );
+            addToInventory( cardData, PlayerInventory::ZONE_AUTO );
         }
         else
         {
             // Send affirmative response to request.
             sendPlayerNamedCardSelectionRsp( true, packId, card );
-            mInventory.add( cardData, mNamedSelectionZone );
+            addToInventory( cardData, mNamedSelectionZone );
         }
     }
     else
@@ -93,8 +94,8 @@ HumanPlayer::notifyIndexedCardSelectionResult( DraftType& draft, uint32_t packId
             {
                 sendPlayerAutoCardSelectionInd(
                         proto::PlayerAutoCardSelectionInd::AUTO_TIMED_OUT, packId, card );
-                auto cardData = std::make_shared<SimpleCardData>( card.name, card.setCode );
-                mInventory.add( cardData, PlayerInventory::ZONE_AUTO );
+                auto cardData = std::make_shared<SimpleCardData>( card.getName(), card.getSetCode() );
+                addToInventory( cardData, PlayerInventory::ZONE_AUTO );
             }
         }
         else
@@ -103,8 +104,8 @@ HumanPlayer::notifyIndexedCardSelectionResult( DraftType& draft, uint32_t packId
             sendPlayerIndexedCardSelectionRsp( true, packId, selectionIndices, cards );
             for( const auto& card : cards )
             {
-                auto cardData = std::make_shared<SimpleCardData>( card.name, card.setCode );
-                mInventory.add( cardData, mIndexedSelectionZone );
+                auto cardData = std::make_shared<SimpleCardData>( card.getName(), card.getSetCode() );
+                addToInventory( cardData, mIndexedSelectionZone );
             }
         }
     }
@@ -129,11 +130,11 @@ void
 HumanPlayer::notifyCardAutoselection( DraftType& draft, uint32_t packId, const DraftCard& card )
 {
     // Create card to be added to inventory.
-    auto cardData = std::make_shared<SimpleCardData>( card.name, card.setCode );
+    auto cardData = std::make_shared<SimpleCardData>( card.getName(), card.getSetCode() );
 
     // Send autoselect indication.
     sendPlayerAutoCardSelectionInd( proto::PlayerAutoCardSelectionInd::AUTO_LAST_CARD, packId, card );
-    mInventory.add( cardData, PlayerInventory::ZONE_AUTO );
+    addToInventory( cardData, PlayerInventory::ZONE_AUTO );
 }
 
 
@@ -254,20 +255,22 @@ HumanPlayer::handleMessageFromClient( const proto::ClientToServerMsg& msg )
     if( msg.has_player_named_card_preselection_ind() )
     {
         const proto::PlayerNamedCardPreselectionInd& ind = msg.player_named_card_preselection_ind();
-        mPreselectedCard = std::make_shared<DraftCard>( ind.card().name(), ind.card().set_code() );
+        // Cards not already known can't be in the pack; they are caught when
+        // the preselection is validated.
+        mPreselectedCard = std::make_shared<DraftCard>( DraftCard::find( ind.card().name(), ind.card().set_code() ) );
         mLogger->debug( "client indicated preselection card={}", *mPreselectedCard );
     }
     else if( msg.has_player_named_card_selection_req() )
     {
         const proto::PlayerNamedCardSelectionReq& req = msg.player_named_card_selection_req();
-        DraftCard card( req.card().name(), req.card().set_code() );
-        mLogger->debug( "client requested named selection pack_id={},card={}", req.pack_id(), card );
+        const DraftCard card = DraftCard::find( req.card().name(), req.card().set_code() );
+        mLogger->debug( "client requested named selection pack_id={},card={}", req.pack_id(), req.card().name() );
         mNamedSelectionZone = convertZone( req.zone() );
-        bool result = mDraft->makeNamedCardSelection( getChairIndex(), req.pack_id(), card );
+        bool result = card.isValid() && mDraft->makeNamedCardSelection( getChairIndex(), req.pack_id(), card );
         if( !result )
         {
             // Notify of error (currently always saying invalid card)
-            sendPlayerNamedCardSelectionRsp( false, req.pack_id(), card );
+            sendPlayerNamedCardSelectionRsp( false, req.pack_id(), req.card() );
         }
     }
     else if( msg.has_player_indexed_card_selection_req() )
@@ -306,11 +309,15 @@ HumanPlayer::handleMessageFromClient( const proto::ClientToServerMsg& msg )
                     ind.drafted_card_moves( i );
             const proto::Card& card = move.card();
             mLogger->debug( "  {}: {} -> {}", card.name(), move.zone_from(), move.zone_to() );
-            auto cardData = std::make_shared<SimpleCardData>( card.name(), card.set_code() );
-
-            bool moveOk = mInventory.move( cardData,
-                    convertZone( move.zone_from() ), convertZone( move.zone_to() ) );
-            if( !moveOk )
+            const PlayerInventory::ZoneType zoneFrom = convertZone( move.zone_from() );
+            const PlayerInventory::ZoneType zoneTo = convertZone( move.zone_to() );
+            bool moveOk = mInventory.move( PlayerInventory::CardKey( card.set_code(), card.name() ),
+                    zoneFrom, zoneTo );
+            if( moveOk )
+            {
+                mDeckHasher.moveCard( card.name(), zoneFrom, zoneTo );
+            }
+            else
             {
                 // Error moving a card.  This should never happen, but if
                 // it somehow does, set a flag to resync the client.
@@ -327,9 +334,14 @@ HumanPlayer::handleMessageFromClient( const proto::ClientToServerMsg& msg )
             mLogger->debug( "  {}: {} -> {}", stringify( adj.basic_land() ),
                     stringify( adj.zone() ), adj.adjustment() );
 
-            bool adjOk = mInventory.adjustBasicLand( convertBasicLand( adj.basic_land() ),
-                    convertZone( adj.zone() ), adj.adjustment() );
-            if( !adjOk )
+            const BasicLandType basic = convertBasicLand( adj.basic_land() );
+            const PlayerInventory::ZoneType zone = convertZone( adj.zone() );
+            bool adjOk = mInventory.adjustBasicLand( basic, zone, adj.adjustment() );
+            if( adjOk )
+            {
+                mDeckHasher.adjustBasicLand( basic, zone, adj.adjustment() );
+            }
+            else
             {
                 // Error adjusting a basic land.  This should never happen,
                 // but if it somehow does, set a flag to resync the client.
@@ -355,6 +367,16 @@ HumanPlayer::handleMessageFromClient( const proto::ClientToServerMsg& msg )
 }
 
 
+void
+HumanPlayer::addToInventory( const std::shared_ptr<CardData>& cardData, PlayerInventory::ZoneType zone )
+{
+    if( mInventory.add( cardData, zone ) )
+    {
+        mDeckHasher.addCard( cardData->getName(), zone );
+    }
+}
+
+
 void
 HumanPlayer::setClientConnection( ClientConnection* c )
 {
@@ -388,25 +410,28 @@ void
 HumanPlayer::sendPlayerInventoryInd() const
 {
     mLogger->trace( "sendPlayerInventoryInd" );
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::PlayerInventoryInd* playerInventoryInd = msg.mutable_player_inventory_ind();
 
     for( PlayerInventory::ZoneType zone : PlayerInventory::gZoneTypeArray )
     {
         proto::Zone protoZone = convertZone( zone );
 
-        std::vector< std::shared_ptr<CardData> > cardList = mInventory.getCards( zone );
+        // Cards go out in the order they arrived in the zone so that
+        // clients can show them in pick order.
+        const PlayerInventory::CardList& cardList = mInventory.getCardList( zone );
         if( !cardList.empty() )
         {
             mLogger->debug( "player inventory cards ({}): ", stringify( zone ) );
-            for( auto c : cardList )
+            for( const auto& cardData : cardList )
             {
-                mLogger->debug( "  {}", c->getName() );
+                mLogger->debug( "  {}", cardData->getName() );
                 proto::PlayerInventoryInd::DraftedCard* draftedCard =
                         playerInventoryInd->add_drafted_cards();
                 proto::Card* card = draftedCard->mutable_card();
-                card->set_name( c->getName() );
-                card->set_set_code( c->getSetCode() );
+                card->set_name( cardData->getName() );
+                card->set_set_code( cardData->getSetCode() );
                 draftedCard->set_zone( protoZone );
             }
         }
@@ -443,14 +468,15 @@ HumanPlayer::sendCurrentPackInd() const
     }
 
     // Build the outgoing new pack message from unselected cards in the pack.
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::PlayerCurrentPackInd* packInd = msg.mutable_player_current_pack_ind();
     packInd->set_pack_id( mCurrentPackId );
     for( auto packCard : mCurrentPackUnselectedCards )
     {
         proto::Card* card = packInd->add_cards();
-        card->set_name( packCard.name );
-        card->set_set_code( packCard.setCode );
+        card->set_name( packCard.getName() );
+        card->set_set_code( packCard.getSetCode() );
     }
 
     int protoSize = msg.ByteSize();
@@ -467,13 +493,24 @@ HumanPlayer::sendPlayerNamedCardSelectionRsp( bool             result,
                                               int              packId,
                                               const DraftCard& draftCard )
 {
-    proto::ServerToClientMsg msg;
+    proto::Card card;
+    card.set_name( draftCard.getName() );
+    card.set_set_code( draftCard.getSetCode() );
+    sendPlayerNamedCardSelectionRsp( result, packId, card );
+}
+
+
+void
+HumanPlayer::sendPlayerNamedCardSelectionRsp( bool               result,
+                                              int                packId,
+                                              const proto::Card& card )
+{
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::PlayerNamedCardSelectionRsp* cardSelRsp = msg.mutable_player_named_card_selection_rsp();
     cardSelRsp->set_result( result );
     cardSelRsp->set_pack_id( packId );
-    proto::Card* card = cardSelRsp->mutable_card();
-    card->set_name( draftCard.name );
-    card->set_set_code( draftCard.setCode );
+    cardSelRsp->mutable_card()->CopyFrom( card );
 
     int protoSize = msg.ByteSize();
     mLogger->debug( "sending playerNamedCardSelectionRsp, size={}", protoSize );
@@ -492,7 +529,8 @@ HumanPlayer::sendPlayerIndexedCardSelectionRsp( bool result, int packId, const s
         return;
     }
 
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::PlayerIndexedCardSelectionRsp* cardSelRsp = msg.mutable_player_indexed_card_selection_rsp();
     cardSelRsp->set_result( result );
     cardSelRsp->set_pack_id( packId );
@@ -501,8 +539,8 @@ HumanPlayer::sendPlayerIndexedCardSelectionRsp( bool result, int packId, const s
     {
         cardSelRsp->add_indices( selectionIndices[i] );
         proto::Card* card = cardSelRsp->add_cards();
-        card->set_name( cards[i].name );
-        card->set_set_code( cards[i].setCode );
+        card->set_name( cards[i].getName() );
+        card->set_set_code( cards[i].getSetCode() );
     }
 
     int protoSize = msg.ByteSize();
@@ -516,13 +554,14 @@ HumanPlayer::sendPlayerIndexedCardSelectionRsp( bool result, int packId, const s
 void
 HumanPlayer::sendPlayerAutoCardSelectionInd( proto::PlayerAutoCardSelectionInd::AutoType type, int packId, const DraftCard& draftCard )
 {
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::PlayerAutoCardSelectionInd* autoSelInd = msg.mutable_player_auto_card_selection_ind();
     autoSelInd->set_type( type );
     autoSelInd->set_pack_id( packId );
     proto::Card* card = autoSelInd->mutable_card();
-    card->set_name( draftCard.name );
-    card->set_set_code( draftCard.setCode );
+    card->set_name( draftCard.getName() );
+    card->set_set_code( draftCard.getSetCode() );
 
     int protoSize = msg.ByteSize();
     mLogger->debug( "sending playerCardAutoSelectionInd, size={}", protoSize );
@@ -45,7 +45,7 @@ public:
     void sendInventoryToClient() const { sendPlayerInventoryInd(); }
     void sendCurrentPackToClient() const { sendCurrentPackInd(); }
 
-    QString getCockatriceHash() const { return computeCockatriceHash( mInventory ); }
+    QString getCockatriceHash() const { return mDeckHasher.getHash(); }
 
 signals:
     void readyUpdate( bool ready );
@@ -59,15 +59,20 @@ private:
     void handleTimeExpiredGridRound( DraftType& draft, uint32_t packId );
     void sendPlayerInventoryInd() const;
     void sendPlayerNamedCardSelectionRsp( bool result, int packId, const DraftCard& card );
+    void sendPlayerNamedCardSelectionRsp( bool result, int packId, const proto::Card& card );
     void sendPlayerIndexedCardSelectionRsp( bool result, int packId, const std::vector<int> selectionIndices, const std::vector<DraftCard>& cards );
     void sendCurrentPackInd() const;
     void sendPlayerAutoCardSelectionInd( proto::PlayerAutoCardSelectionInd::AutoType type, int packId, const DraftCard& card );
 
     void sendServerToClientMsg( const proto::ServerToClientMsg& msg ) const;
 
+    // Add to the inventory, keeping the deck hash current.
+    void addToInventory( const std::shared_ptr<CardData>& cardData, PlayerInventory::ZoneType zone );
+
     ClientConnection* mClientConnection;
     DraftType*        mDraft;
     PlayerInventory   mInventory;
+    CockatriceDeckHasher mDeckHasher;
     bool              mTimeExpired;
 
     bool                       mCurrentPackPresent;
@@ -119,12 +119,20 @@ RoomConfigValidator::validate( const proto::RoomConfig& roomConfig, ResultType&
     }
 
     //
-    // Check custom card lists.  Must have non-zero amount of cards.
+    // Check custom card lists.  Must have non-zero amount of cards, all
+    // known by name, or be a reference to a registered list by content
+    // hash.
     //
 
     for( int i = 0; i < draftConfig.custom_card_lists_size(); ++i )
     {
         const proto::DraftConfig::CustomCardList& ccl = draftConfig.custom_card_lists( i );
+        if( (ccl.card_quantities_size() == 0) && ccl.has_content_hash() )
+        {
+            // Contents were checked when the list was registered.
+            continue;
+        }
+
         if( ccl.card_quantities_size() == 0 )
         {
             mLogger->warn( "Custom card list {} has no card quantity entries", i );
@@ -133,10 +141,13 @@ RoomConfigValidator::validate( const proto::RoomConfig& roomConfig, ResultType&
         }
 
         int qty = 0;
+        std::vector<SimpleCardData> cards;
+        cards.reserve( ccl.card_quantities_size() );
         for( int j = 0; j < ccl.card_quantities_size(); ++j )
         {
-            const proto::DraftConfig::CustomCardList::CardQuantity& cq = ccl.card_quantities( i );
+            const proto::DraftConfig::CustomCardList::CardQuantity& cq = ccl.card_quantities( j );
             qty += cq.quantity();
+            cards.push_back( SimpleCardData( cq.name(), cq.set_code() ) );
         }
         if( qty <= 0 )
         {
@@ -144,6 +155,19 @@ RoomConfigValidator::validate( const proto::RoomConfig& roomConfig, ResultType&
             failureResult = proto::CreateRoomFailureRsp::RESULT_INVALID_CUSTOM_CARD_LIST;
             return false;
         }
+
+        const std::vector<AllSetsData::CardResolution> resolutions = mAllSetsData->resolveCards( cards );
+        const auto unresolvedIter = std::find_if( resolutions.begin(), resolutions.end(),
+                []( const AllSetsData::CardResolution& r ) { return !r.isResolved(); } );
+        if( unresolvedIter != resolutions.end() )
+        {
+            const std::size_t unresolvedCount = std::count_if( unresolvedIter, resolutions.end(),
+                    []( const AllSetsData::CardResolution& r ) { return !r.isResolved(); } );
+            mLogger->warn( "Custom card list {} has {} unknown cards, first '{}'", i, unresolvedCount,
+                    cards[unresolvedIter - resolutions.begin()].getName() );
+            failureResult = proto::CreateRoomFailureRsp::RESULT_INVALID_CUSTOM_CARD_LIST;
+            return false;
+        }
     }
 
     //
@@ -0,0 +1,86 @@
+#include "RoomWorkerPool.h"
+
+#include <QThread>
+
+#include "TimerWheelDriver.h"
+
+
+RoomWorkerPool::RoomWorkerPool( int                    threadCount,
+                                unsigned int           timerWheelTickMillis,
+                                const Logging::Config& loggingConfig,
+                                QObject*               parent )
+  : QObject( parent ),
+    mLogger( loggingConfig.createLogger() )
+{
+    for( int i = 0; i < threadCount; ++i )
+    {
+        Worker worker;
+        worker.thread = new QThread();
+        worker.thread->setObjectName( QString( "roomworker-%1" ).arg( i ) );
+        worker.roomCount = 0;
+
+        // The driver lives on the worker thread and is started and
+        // destroyed by its event loop.
+        worker.timerWheelDriver = new TimerWheelDriver( timerWheelTickMillis );
+        worker.timerWheelDriver->moveToThread( worker.thread );
+        connect( worker.thread, &QThread::started, worker.timerWheelDriver, &TimerWheelDriver::start );
+        connect( worker.thread, &QThread::finished, worker.timerWheelDriver, &QObject::deleteLater );
+
+        worker.thread->start();
+        mWorkers.append( worker );
+    }
+
+    mLogger->info( "started {} room worker threads", threadCount );
+}
+
+
+RoomWorkerPool::~RoomWorkerPool()
+{
+    for( const Worker& worker : mWorkers )
+    {
+        worker.thread->quit();
+    }
+    for( const Worker& worker : mWorkers )
+    {
+        worker.thread->wait();
+        delete worker.thread;
+    }
+}
+
+
+int
+RoomWorkerPool::acquireWorker()
+{
+    int workerIndex = -1;
+    for( int i = 0; i < mWorkers.size(); ++i )
+    {
+        if( (workerIndex < 0) || (mWorkers[i].roomCount < mWorkers[workerIndex].roomCount) )
+        {
+            workerIndex = i;
+        }
+    }
+
+    if( workerIndex >= 0 )
+    {
+        mWorkers[workerIndex].roomCount++;
+        mLogger->debug( "worker {} acquired, rooms={}", workerIndex, mWorkers[workerIndex].roomCount );
+    }
+    return workerIndex;
+}
+
+
+void
+RoomWorkerPool::releaseWorker( int workerIndex )
+{
+    if( (workerIndex < 0) || (workerIndex >= mWorkers.size()) ) return;
+
+    mWorkers[workerIndex].roomCount--;
+    mLogger->debug( "worker {} released, rooms={}", workerIndex, mWorkers[workerIndex].roomCount );
+}
+
+
+const std::shared_ptr<TimerWheel>&
+RoomWorkerPool::getTimerWheel( int workerIndex ) const
+{
+    return mWorkers[workerIndex].timerWheelDriver->getTimerWheel();
+}
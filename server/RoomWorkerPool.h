@@ -0,0 +1,61 @@
+#ifndef ROOMWORKERPOOL_H
+#define ROOMWORKERPOOL_H
+
+#include <QObject>
+#include <QVector>
+#include <memory>
+
+#include "TimerWheel.h"
+#include "Logging.h"
+
+QT_BEGIN_NAMESPACE
+class QThread;
+QT_END_NAMESPACE
+
+class TimerWheelDriver;
+
+// Pool of worker threads that rooms run on, each with its own event loop
+// and timer wheel.  Rooms are spread across the workers by room count.
+class RoomWorkerPool : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    RoomWorkerPool( int                    threadCount,
+                    unsigned int           timerWheelTickMillis,
+                    const Logging::Config& loggingConfig = Logging::Config(),
+                    QObject*               parent = 0 );
+
+    // Stops and waits for all worker threads.
+    virtual ~RoomWorkerPool();
+
+    int getThreadCount() const { return mWorkers.size(); }
+
+    // Choose the worker hosting the fewest rooms and count a room against
+    // it.  Returns -1 if the pool has no threads.
+    int acquireWorker();
+
+    // Stop counting a room against a worker.
+    void releaseWorker( int workerIndex );
+
+    QThread* getThread( int workerIndex ) const { return mWorkers[workerIndex].thread; }
+
+    // Timer wheel for objects living on a worker's thread.
+    const std::shared_ptr<TimerWheel>& getTimerWheel( int workerIndex ) const;
+
+private:
+
+    struct Worker
+    {
+        QThread*          thread;
+        TimerWheelDriver* timerWheelDriver;
+        int               roomCount;
+    };
+
+    QVector<Worker> mWorkers;
+
+    std::shared_ptr<spdlog::logger> mLogger;
+};
+
+#endif  // ROOMWORKERPOOL_H
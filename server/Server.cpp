@@ -15,10 +15,18 @@
 #include "ServerSettings.h"
 #include "ClientNotices.h"
 #include "ClientConnection.h"
+#include "ServerMsgBuilder.h"
 #include "ServerRoom.h"
 #include "RoomConfigValidator.h"
+#include "RoomWorkerPool.h"
+#include "TimerWheelDriver.h"
 #include "CardDispenserFactory.h"
 
+static const int TIMER_WHEEL_TICK_MILLIS = 50;
+
+// Custom card lists kept registered after their rooms are gone.
+static const std::size_t CUSTOM_CARD_LIST_RETAINED_COUNT = 32;
+
 Server::Server( unsigned int                              port,
                 const std::shared_ptr<ServerSettings>&    settings,
                 const std::shared_ptr<const AllSetsData>& allSetsData,
@@ -29,11 +37,16 @@ Server::Server( unsigned int                              port,
     mPort( port ),
     mSettings( settings ),
     mAllSetsData( allSetsData ),
+    mBoosterTemplateCache( std::make_shared<BoosterTemplateCache>( allSetsData,
+            loggingConfig.createChildConfig( "boostertemplatecache" ) ) ),
     mClientNotices( clientNotices ),
     mNetworkSession( 0 ),
     mNetConnectionServer( 0 ),
     mRoomConfigValidator( allSetsData, loggingConfig.createChildConfig( "roomconfigvalidator" ) ),
+    mCustomCardListRegistry( CUSTOM_CARD_LIST_RETAINED_COUNT, allSetsData,
+            loggingConfig.createChildConfig( "customcardlistregistry" ) ),
     mNextRoomId( 0 ),
+    mRoomsInfoDiffBroadcastHandle( TimerWheel::INVALID_HANDLE ),
     mTotalDisconnectedClientBytesSent( 0 ),
     mTotalDisconnectedClientBytesReceived( 0 ),
     mLoggingConfig( loggingConfig ),
@@ -42,9 +55,23 @@ Server::Server( unsigned int                              port,
     connect( mClientNotices.get(), &ClientNotices::announcementsUpdate, this, &Server::handleAnnouncementsUpdate );
     connect( mClientNotices.get(), &ClientNotices::alertUpdate, this, &Server::handleAlertUpdate );
 
-    mRoomsInfoDiffBroadcastTimer = new QTimer( this );
-    mRoomsInfoDiffBroadcastTimer->setSingleShot( true );
-    connect( mRoomsInfoDiffBroadcastTimer, &QTimer::timeout, this, &Server::handleRoomsInfoDiffBroadcastTimerTimeout );
+    // Messages and connections cross threads with queued signals and calls.
+    qRegisterMetaType<proto::ClientToServerMsg>();
+    qRegisterMetaType<QAbstractSocket::SocketError>();
+    qRegisterMetaType<ClientConnection*>();
+
+    mTimerWheelDriver = new TimerWheelDriver( TIMER_WHEEL_TICK_MILLIS, this );
+    mTimerWheel = mTimerWheelDriver->getTimerWheel();
+    mTimerWheelDriver->start();
+
+    // By default leave one core for the lobby.
+    int roomWorkerThreadCount = mSettings->getRoomWorkerThreadCount();
+    if( roomWorkerThreadCount < 0 )
+    {
+        roomWorkerThreadCount = std::max( QThread::idealThreadCount() - 1, 1 );
+    }
+    mRoomWorkerPool = new RoomWorkerPool( roomWorkerThreadCount, TIMER_WHEEL_TICK_MILLIS,
+            mLoggingConfig.createChildConfig( "roomworkerpool" ), this );
 }
 
 
@@ -52,7 +79,10 @@ Server::~Server()
 {
     mLogger->trace( "~Server" );
 
-    // Delete rooms.
+    mTimerWheel->cancel( mRoomsInfoDiffBroadcastHandle );
+
+    // Delete rooms.  Rooms on worker threads are deleted as the worker
+    // pool shuts down.
     for( auto iter = mRoomMap.begin(); iter != mRoomMap.end(); ++iter )
     {
         ServerRoom* room = iter.value();
@@ -139,8 +169,13 @@ Server::handleIncomingConnectionSocket( qintptr socketDescriptor )
 {
     Logging::Config loggingConfig = mLoggingConfig.createChildConfig( "clientconnection" );
 
-    ClientConnection* clientConnection = new ClientConnection( loggingConfig, this );
+    // Connections move between threads with the rooms they join, so they
+    // can't be parented; they are deleted when disconnected.
+    ClientConnection* clientConnection = new ClientConnection( loggingConfig );
     clientConnection->setSocketDescriptor( socketDescriptor );
+    clientConnection->setTimerWheel( mTimerWheel );
+    clientConnection->getCompressionPolicy().setLevel( mSettings->getCompressionLevel() );
+    clientConnection->getCompressionPolicy().setThreshold( mSettings->getCompressionThreshold() );
 
     connect( clientConnection, &ClientConnection::protoMsgReceived,
              this,             &Server::handleMessageFromClient );
@@ -164,7 +199,8 @@ void
 Server::sendGreetingInd( ClientConnection* clientConnection )
 {
     mLogger->trace( "sendGreetingInd" );
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::GreetingInd* greetingInd = msg.mutable_greeting_ind();
     greetingInd->set_protocol_version_major( proto::PROTOCOL_VERSION_MAJOR );
     greetingInd->set_protocol_version_minor( proto::PROTOCOL_VERSION_MINOR );
@@ -178,7 +214,8 @@ void
 Server::sendAnnouncementsInd( ClientConnection* clientConnection, const std::string& text )
 {
     mLogger->trace( "sendAnnouncementsInd" );
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::AnnouncementsInd* announcementsInd = msg.mutable_announcements_ind();
     announcementsInd->set_text( text );
     clientConnection->sendProtoMsg( msg );
@@ -189,7 +226,8 @@ void
 Server::sendAlertsInd( ClientConnection* clientConnection, const std::string& text )
 {
     mLogger->trace( "sendAlertsInd" );
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::AlertsInd* alertsInd = msg.mutable_alerts_ind();
     alertsInd->set_text( text );
     clientConnection->sendProtoMsg( msg );
@@ -200,7 +238,8 @@ void
 Server::sendRoomCapabilitiesInd( ClientConnection* clientConnection )
 {
     mLogger->trace( "sendRoomCapabilitiesInd" );
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::RoomCapabilitiesInd* capsInd = msg.mutable_room_capabilities_ind();
     const std::vector<std::string> allSetCodes = mAllSetsData->getSetCodes();
     for( const std::string& code : allSetCodes )
@@ -218,7 +257,8 @@ void
 Server::sendLoginRsp( ClientConnection* clientConnection, const proto::LoginRsp::ResultType& result )
 {
     mLogger->trace( "sendLoginRsp" );
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::LoginRsp* rsp = msg.mutable_login_rsp();
     rsp->set_result( result );
     clientConnection->sendProtoMsg( msg );
@@ -229,7 +269,8 @@ void
 Server::sendCreateRoomFailureRsp( ClientConnection* clientConnection, proto::CreateRoomFailureRsp_ResultType result )
 {
     mLogger->trace( "sendCreateRoomFailureRsp, result={}", result );
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::CreateRoomFailureRsp* createRoomFailureRsp = msg.mutable_create_room_failure_rsp();
     createRoomFailureRsp->set_result( result );
     clientConnection->sendProtoMsg( msg );
@@ -240,7 +281,8 @@ void
 Server::sendJoinRoomFailureRsp( ClientConnection* clientConnection, proto::JoinRoomFailureRsp_ResultType result, int roomId )
 {
     mLogger->trace( "sendJoinRoomFailureRsp, result={}, roomId={}", result, roomId );
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::JoinRoomFailureRsp* joinRoomFailureRsp = msg.mutable_join_room_failure_rsp();
     joinRoomFailureRsp->set_result( result );
     joinRoomFailureRsp->set_room_id( roomId );
@@ -254,7 +296,8 @@ Server::sendBaselineRoomsInfo( ClientConnection* clientConnection )
     mLogger->trace( "sendBaselineRoomsInfo" );
 
     // Assemble the message.
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::RoomsInfoInd* roomsInfoInd = msg.mutable_rooms_info_ind();
 
     auto iter = mRoomMap.constBegin();
@@ -271,11 +314,12 @@ Server::sendBaselineRoomsInfo( ClientConnection* clientConnection )
         abridgeRoomConfig( roomConfig );
         addedRoom->set_abridged( true );
 
-        if( room->getPlayerCount() > 0 )
+        const int roomPlayerCount = mRoomPlayerCountMap.value( iter.key(), 0 );
+        if( roomPlayerCount > 0 )
         {
             proto::RoomsInfoInd::PlayerCount* playerCount = roomsInfoInd->add_player_counts();
             playerCount->set_room_id( iter.key() );
-            playerCount->set_player_count( room->getPlayerCount() );
+            playerCount->set_player_count( roomPlayerCount );
         }
 
         ++iter;
@@ -306,7 +350,8 @@ Server::broadcastRoomsInfoDiffs()
         return;
     }
 
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::RoomsInfoInd* roomsInfoInd = msg.mutable_rooms_info_ind();
 
     for( int roomId : mRoomsInfoDiffAddedRoomIds )
@@ -343,22 +388,20 @@ Server::broadcastRoomsInfoDiffs()
     mRoomsInfoDiffPlayerCountsMap.clear();
 
     // Send the message to each client connection.
-    for( auto clientConn : mClientConnectionLoginMap.keys() )
-    {
-        mLogger->debug( "sending RoomsInfoInd, size={} to client {}",
-                msg.ByteSize(), (std::size_t)clientConn );
-        clientConn->sendProtoMsg( msg );
-    }
+    mLogger->debug( "sending RoomsInfoInd, size={} to {} clients",
+            msg.ByteSize(), mClientConnectionLoginMap.size() );
+    ClientConnection::multicastProtoMsg( msg, mClientConnectionLoginMap.keys() );
 }
 
 
 void
 Server::armRoomsInfoDiffBroadcastTimer()
 {
-    if( !mRoomsInfoDiffBroadcastTimer->isActive() )
+    if( !mTimerWheel->isScheduled( mRoomsInfoDiffBroadcastHandle ) )
     {
         mLogger->debug( "starting room info diffs broadcast timer" );
-        mRoomsInfoDiffBroadcastTimer->start( 1000 );
+        mRoomsInfoDiffBroadcastHandle = mTimerWheel->schedule( 1000,
+                [this] { handleRoomsInfoDiffBroadcastTimerTimeout(); } );
     }
 }
 
@@ -369,7 +412,8 @@ Server::sendBaselineUsersInfo( ClientConnection* clientConnection )
     mLogger->trace( "sendBaselineUsersInfo" );
 
     // Assemble the message.
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::UsersInfoInd* usersInfoInd = msg.mutable_users_info_ind();
 
     auto iter = mClientConnectionLoginMap.constBegin();
@@ -405,7 +449,8 @@ Server::broadcastUsersInfoDiffs()
         return;
     }
 
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::UsersInfoInd* usersInfoInd = msg.mutable_users_info_ind();
 
     for( const std::string& name : mUsersInfoDiffAddedNames )
@@ -424,12 +469,9 @@ Server::broadcastUsersInfoDiffs()
     mUsersInfoDiffRemovedNames.clear();
 
     // Send the message to each client connection.
-    for( auto clientConn : mClientConnectionLoginMap.keys() )
-    {
-        mLogger->debug( "sending UsersInfoInd, size={} to client {}",
-                msg.ByteSize(), (std::size_t)clientConn );
-        clientConn->sendProtoMsg( msg );
-    }
+    mLogger->debug( "sending UsersInfoInd, size={} to {} clients",
+            msg.ByteSize(), mClientConnectionLoginMap.size() );
+    ClientConnection::multicastProtoMsg( msg, mClientConnectionLoginMap.keys() );
 }
 
 
@@ -483,6 +525,8 @@ Server::handleMessageFromClient( const proto::ClientToServerMsg& msg )
 
             mLogger->info( "client logged in: name={}", name );
             mClientConnectionLoginMap.insert( clientConnection, name );
+            clientConnection->setProtocolVersion(
+                    SimpleVersion( req.protocol_version_major(), req.protocol_version_minor() ) );
             sendLoginRsp( clientConnection, proto::LoginRsp::RESULT_SUCCESS );
 
             // OPTIMIZATION: Always send room capabilities at login time
@@ -509,26 +553,13 @@ Server::handleMessageFromClient( const proto::ClientToServerMsg& msg )
             }
 
             // User has logged in.  Check to see if they should be rejoined to a room
-            // they had disconnected from.
-            auto end = mRoomMap.cend();
-            for( auto iter = mRoomMap.cbegin(); iter != end; ++iter )
+            // they had disconnected from.  If the user has logged in with a
+            // unique name, the only way a room could contain that name is if
+            // the user had been previously disconnected.
+            ServerRoom* room = mRoomMap.value( mHumanRoomMap.value( name ), nullptr );
+            if( mHumanRoomMap.contains( name ) && (room != nullptr) )
             {
-                ServerRoom* room = iter.value();
-
-                // If the user has logged in with a unique name, the only
-                // way a room could contain that name is if the user had
-                // been previously disconnected.
-                if( room->containsHumanPlayer( name ) )
-                {
-                    bool result = room->rejoin( clientConnection, name );
-                    if( !result )
-                    {
-                        // This should never happen but it's not critical,
-                        // it just means the user isn't in the room.
-                        mLogger->warn( "{} failed to rejoin room!", name );
-                    }
-                    break;
-                }
+                handOffClientConnection( clientConnection, room, name, std::string(), true );
             }
         }
     }
@@ -539,7 +570,8 @@ Server::handleMessageFromClient( const proto::ClientToServerMsg& msg )
         mLogger->debug( "got chat message from {}, scope={}", loginName, ind.scope() );
 
         // Deliver message to all logged-in users.
-        proto::ServerToClientMsg msg;
+        ServerMsgBuilder msgBuilder;
+        proto::ServerToClientMsg& msg = msgBuilder.getMsg();
         proto::ChatMessageDeliveryInd* deliveryInd = msg.mutable_chat_message_delivery_ind();
         deliveryInd->set_sender( loginName );
         deliveryInd->set_scope( ind.scope() );
@@ -554,16 +586,11 @@ Server::handleMessageFromClient( const proto::ClientToServerMsg& msg )
         }
         else if( ind.scope() == proto::CHAT_SCOPE_ROOM )
         {
-            auto end = mRoomMap.cend();
-            for( auto iter = mRoomMap.cbegin(); iter != end; ++iter )
+            // Send the message to all connections in the sender's room.
+            if( mClientConnectionRoomMap.contains( clientConnection ) )
             {
-                ServerRoom* room = iter.value();
-                if( room->containsHumanPlayer( loginName ) )
-                {
-                    // Found the room.  Get all other connections and
-                    // send them the chat message.
-                    destClientConnections = room->getClientConnections();
-                }
+                destClientConnections = mClientConnectionRoomMap.keys(
+                        mClientConnectionRoomMap.value( clientConnection ) );
             }
         }
         else
@@ -572,17 +599,17 @@ Server::handleMessageFromClient( const proto::ClientToServerMsg& msg )
         }
 
         // Send the message to each destination client connection.
-        for( auto clientConn : destClientConnections )
-        {
-            mLogger->debug( "sending ChatMessageDeliveryInd, size={} to client {}",
-                    msg.ByteSize(), (std::size_t)clientConn );
-            clientConn->sendProtoMsg( msg );
-        }
+        mLogger->debug( "sending ChatMessageDeliveryInd, size={} to {} clients",
+                msg.ByteSize(), destClientConnections.size() );
+        ClientConnection::multicastProtoMsg( msg, destClientConnections );
     }
     else if( msg.has_create_room_req() && loggedIn )
     {
         const proto::CreateRoomReq& req = msg.create_room_req();
-        const proto::RoomConfig& roomConfig = req.room_config();
+
+        // Custom card lists are replaced below with references to their
+        // registered pools, so the room keeps only the hashes.
+        proto::RoomConfig roomConfig = req.room_config();
 
         // Make sure the name is unique.
         const std::string& name = roomConfig.name();
@@ -606,10 +633,46 @@ Server::handleMessageFromClient( const proto::ClientToServerMsg& msg )
             return;
         }
 
+        // Resolve custom card lists to shared pools.  Lists sent in full
+        // are registered (and hashed here, regardless of any hash the
+        // client sent); lists sent by hash alone must already be known.
+        std::vector<CustomCardListRegistry::CardPoolSharedPtr> customCardListPools;
+        proto::DraftConfig* draftConfig = roomConfig.mutable_draft_config();
+        for( int i = 0; i < draftConfig->custom_card_lists_size(); ++i )
+        {
+            proto::DraftConfig::CustomCardList* ccl = draftConfig->mutable_custom_card_lists( i );
+            CustomCardListRegistry::CardPoolSharedPtr pool;
+            std::string contentHash;
+            if( ccl->card_quantities_size() > 0 )
+            {
+                pool = mCustomCardListRegistry.registerList( *ccl, contentHash );
+                if( !pool )
+                {
+                    mLogger->notice( "invalid custom card list {} from client", i );
+                    sendCreateRoomFailureRsp( clientConnection, proto::CreateRoomFailureRsp::RESULT_INVALID_CUSTOM_CARD_LIST );
+                    return;
+                }
+            }
+            else
+            {
+                contentHash = ccl->content_hash();
+                pool = mCustomCardListRegistry.find( contentHash );
+                if( !pool )
+                {
+                    mLogger->debug( "unknown custom card list {} from client", i );
+                    sendCreateRoomFailureRsp( clientConnection, proto::CreateRoomFailureRsp::RESULT_UNKNOWN_CUSTOM_CARD_LIST );
+                    return;
+                }
+            }
+            ccl->clear_card_quantities();
+            ccl->set_content_hash( contentHash );
+            customCardListPools.push_back( pool );
+        }
+
         // Create dispensers.
-        CardDispenserFactory factory( mAllSetsData );
+        CardDispenserFactory factory( mBoosterTemplateCache );
         DraftCardDispenserSharedPtrVector<DraftCard> dispensers =
-                factory.createCardDispensers( roomConfig.draft_config() );
+                factory.createCardDispensers( roomConfig.draft_config(), customCardListPools );
         if( dispensers.empty() )
         {
             mLogger->warn( "error creating configurations" );
@@ -621,12 +684,25 @@ Server::handleMessageFromClient( const proto::ClientToServerMsg& msg )
         const int roomId = mNextRoomId++;
         const std::string& password = req.has_password() ? req.password() : std::string();
         const QString loggingConfigName = "serverroom-" + QString::number( roomId );
-        ServerRoom* room = new ServerRoom( roomId, password, roomConfig, dispensers,
-                mLoggingConfig.createChildConfig( loggingConfigName.toStdString() ), this );
+
+        // Put the room on the least busy worker thread, if there are any.
+        const int workerIndex = mRoomWorkerPool->acquireWorker();
+        const std::shared_ptr<TimerWheel>& roomTimerWheel = (workerIndex >= 0) ?
+                mRoomWorkerPool->getTimerWheel( workerIndex ) : mTimerWheel;
+        ServerRoom* room = new ServerRoom( roomId, password, roomConfig, dispensers, roomTimerWheel,
+                mLoggingConfig.createChildConfig( loggingConfigName.toStdString() ) );
+        if( workerIndex >= 0 )
+        {
+            room->moveToThread( mRoomWorkerPool->getThread( workerIndex ) );
+        }
         mRoomMap[roomId] = room;
+        mRoomWorkerIndexMap[roomId] = workerIndex;
         connect( room, &ServerRoom::playerCountChanged, this, &Server::handleRoomPlayerCountChanged );
         connect( room, &ServerRoom::roomExpired, this, &Server::handleRoomExpired );
         connect( room, &ServerRoom::roomError, this, &Server::handleRoomError );
+        connect( room, &ServerRoom::clientConnectionReleased, this, &Server::handleRoomClientConnectionReleased );
+        connect( room, &ServerRoom::humanPlayerAdded, this, &Server::handleRoomHumanPlayerAdded );
+        connect( room, &ServerRoom::humanPlayerRemoved, this, &Server::handleRoomHumanPlayerRemoved );
 
         // Add the room to the room information differences list.
         mRoomsInfoDiffAddedRoomIds.push_back( roomId );
@@ -634,7 +710,8 @@ Server::handleMessageFromClient( const proto::ClientToServerMsg& msg )
 
         // Send response to client.
         mLogger->debug( "sendCreateRoomSuccessRsp: roomId={}", roomId );
-        proto::ServerToClientMsg msg;
+        ServerMsgBuilder msgBuilder;
+        proto::ServerToClientMsg& msg = msgBuilder.getMsg();
         proto::CreateRoomSuccessRsp* createRoomSuccessRsp = msg.mutable_create_room_success_rsp();
         createRoomSuccessRsp->set_room_id( roomId );
         clientConnection->sendProtoMsg( msg );
@@ -647,15 +724,17 @@ Server::handleMessageFromClient( const proto::ClientToServerMsg& msg )
         const std::string loginName = mClientConnectionLoginMap.value( clientConnection );
 
         ServerRoom* room = mRoomMap.value( roomId, nullptr );
-        if( room != nullptr )
+        if( mClientConnectionRoomMap.contains( clientConnection ) )
         {
-            int chairIndex = -1;
-            bool result = room->join( clientConnection, loginName, password, chairIndex );
-            if( !result )
-            {
-                // This is normal, e.g. room full or bad password.
-                mLogger->info( "{} failed to join room", loginName );
-            }
+            // A connection can only be in one room at a time.
+            mLogger->notice( "{} tried to join room {} while in room {}",
+                    loginName, roomId, mClientConnectionRoomMap.value( clientConnection ) );
+            sendJoinRoomFailureRsp( clientConnection,
+                    proto::JoinRoomFailureRsp::RESULT_GENERAL_ERROR, roomId );
+        }
+        else if( room != nullptr )
+        {
+            handOffClientConnection( clientConnection, room, loginName, password, false );
         }
         else
         {
@@ -666,16 +745,7 @@ Server::handleMessageFromClient( const proto::ClientToServerMsg& msg )
     else if( msg.has_depart_room_ind() && loggedIn )
     {
         // If the client is in a room, remove the client.
-        auto end = mRoomMap.cend();
-        for( auto iter = mRoomMap.cbegin(); iter != end; ++iter )
-        {
-            ServerRoom* room = iter.value();
-            if( room->containsConnection( clientConnection ) )
-            {
-                room->leave( clientConnection );
-                break;
-            }
-        }
+        requestRoomLeave( clientConnection );
     }
     else
     {
@@ -705,21 +775,7 @@ void
 Server::handleClientDisconnected()
 {
     ClientConnection *clientConnection = qobject_cast<ClientConnection *>(QObject::sender());
-    const int localPort = clientConnection->localPort();
-    mLogger->debug( "client {} disconnected, peerAddr={}, localPort={}",
-            (std::size_t)clientConnection, clientConnection->peerAddress().toString(), localPort );
-
-    // If the client is in a room, remove it.
-    auto end = mRoomMap.cend();
-    for( auto iter = mRoomMap.cbegin(); iter != end; ++iter )
-    {
-        ServerRoom* room = iter.value();
-        if( room->containsConnection( clientConnection ) )
-        {
-            room->leave( clientConnection );
-            break;
-        }
-    }
+    mLogger->debug( "client {} disconnected", (std::size_t)clientConnection );
 
     // If the client was logged in, broadcast that the user is gone.
     auto iter = mClientConnectionLoginMap.find( clientConnection );
@@ -732,6 +788,30 @@ Server::handleClientDisconnected()
     // Remove client from login map.
     mClientConnectionLoginMap.remove( clientConnection );
 
+    // If the client is in a room, remove it.  The rest of the cleanup
+    // waits until the room hands the connection back to this thread.
+    if( requestRoomLeave( clientConnection ) )
+    {
+        mDisconnectedClientConnections.insert( clientConnection );
+        return;
+    }
+
+    finishClientDisconnect( clientConnection );
+}
+
+
+void
+Server::finishClientDisconnect( ClientConnection* clientConnection )
+{
+    const int localPort = clientConnection->localPort();
+    mLogger->debug( "client {} finishing disconnect, peerAddr={}, localPort={}",
+            (std::size_t)clientConnection, clientConnection->peerAddress().toString(), localPort );
+
+    const CompressionPolicy::Stats& stats = clientConnection->getCompressionPolicy().getStats();
+    mLogger->debug( "client {} compression: {}/{} msgs compressed, {} -> {} bytes, {} us",
+            (std::size_t)clientConnection, stats.compressedMessages, stats.messages,
+            stats.uncompressedBytes, stats.compressedBytes, stats.compressionNanos / 1000 );
+
     // Log network activity for diagnostics.
     mTotalDisconnectedClientBytesSent += clientConnection->getBytesSent();
     mTotalDisconnectedClientBytesReceived += clientConnection->getBytesReceived();
@@ -773,43 +853,51 @@ Server::handleAlertUpdate( const QString& text )
 
 
 void
-Server::handleRoomPlayerCountChanged( int playerCount )
+Server::handleRoomPlayerCountChanged( unsigned int roomId, int playerCount )
 {
-    ServerRoom *room = qobject_cast<ServerRoom*>( QObject::sender() );
-    const int roomId = room->getRoomId();
+    // Signals from a room's thread can arrive after it was torn down.
+    if( !mRoomMap.contains( roomId ) ) return;
 
     mLogger->debug( "player count changed: roomId={}, playerCount={}", roomId, playerCount );
 
+    mRoomPlayerCountMap.insert( roomId, playerCount );
     mRoomsInfoDiffPlayerCountsMap.insert( roomId, playerCount );
     armRoomsInfoDiffBroadcastTimer();
 }
 
 
 void
-Server::handleRoomExpired()
+Server::handleRoomExpired( unsigned int roomId )
 {
-    ServerRoom* room = qobject_cast<ServerRoom*>( QObject::sender() );
-    mLogger->info( "room expired: roomId={}", room->getRoomId() );
-    teardownRoom( room );
+    mLogger->info( "room expired: roomId={}", roomId );
+    teardownRoom( roomId );
 }
 
 
 void
-Server::handleRoomError()
+Server::handleRoomError( unsigned int roomId )
 {
-    ServerRoom* room = qobject_cast<ServerRoom*>( QObject::sender() );
-    mLogger->error( "room error! roomId={}", room->getRoomId() );
-    teardownRoom( room );
+    mLogger->error( "room error! roomId={}", roomId );
+    teardownRoom( roomId );
 }
 
 
 void
-Server::teardownRoom( ServerRoom* room )
+Server::teardownRoom( unsigned int roomId )
 {
-    const int roomId = room->getRoomId();
+    // A room can report more than one reason to tear it down.  Once it's
+    // out of the map it may already be destroyed.
+    ServerRoom* room = mRoomMap.value( roomId, nullptr );
+    if( room == nullptr ) return;
 
-    // Remove room from room map.
+    // Remove room from room maps.
     mRoomMap.remove( roomId );
+    mRoomPlayerCountMap.remove( roomId );
+    mRoomWorkerPool->releaseWorker( mRoomWorkerIndexMap.take( roomId ) );
+    for( auto iter = mHumanRoomMap.begin(); iter != mHumanRoomMap.end(); )
+    {
+        iter = (iter.value() == roomId) ? mHumanRoomMap.erase( iter ) : ++iter;
+    }
 
     // Update room differences and ready an update.
     if( mRoomsInfoDiffAddedRoomIds.contains( roomId ) )
@@ -825,11 +913,130 @@ Server::teardownRoom( ServerRoom* room )
     }
     armRoomsInfoDiffBroadcastTimer();
 
-    // Destroy the room.
+    // Have the room hand back any connections it still has, then destroy
+    // it.  Both happen in order on the room's thread.
+    QMetaObject::invokeMethod( room, "releaseClientConnections", Qt::QueuedConnection );
     room->deleteLater();
 }
 
 
+void
+Server::handOffClientConnection( ClientConnection* clientConnection, ServerRoom* room,
+                                 const std::string& name, const std::string& password, bool rejoin )
+{
+    mLogger->debug( "handing client {} off to room {}", (std::size_t)clientConnection, room->getRoomId() );
+
+    // Claim the connection for the room now so that it can't be handed
+    // off twice, but don't move it until the connection's own slot that
+    // delivered this request has returned.
+    mClientConnectionRoomMap.insert( clientConnection, room->getRoomId() );
+    mPendingHandOffClientConnections.insert( clientConnection );
+
+    QMetaObject::invokeMethod( this, "completeClientConnectionHandOff", Qt::QueuedConnection,
+            Q_ARG( ClientConnection*, clientConnection ),
+            Q_ARG( unsigned int, room->getRoomId() ),
+            Q_ARG( QString, QString::fromStdString( name ) ),
+            Q_ARG( QString, QString::fromStdString( password ) ),
+            Q_ARG( bool, rejoin ) );
+}
+
+
+void
+Server::completeClientConnectionHandOff( ClientConnection* clientConnection, unsigned int roomId,
+                                         const QString& name, const QString& password, bool rejoin )
+{
+    // The handoff was cancelled if the connection left or disconnected
+    // in the meantime; it may no longer exist.
+    if( !mPendingHandOffClientConnections.remove( clientConnection ) ) return;
+
+    ServerRoom* room = mRoomMap.value( roomId, nullptr );
+    if( room == nullptr )
+    {
+        // The room was torn down in the meantime.
+        mLogger->debug( "room {} gone before client {} handoff", roomId, (std::size_t)clientConnection );
+        mClientConnectionRoomMap.remove( clientConnection );
+        if( !rejoin )
+        {
+            sendJoinRoomFailureRsp( clientConnection, proto::JoinRoomFailureRsp::RESULT_INVALID_ROOM, roomId );
+        }
+        return;
+    }
+
+    clientConnection->moveToOwnerThread( room->thread() );
+
+    if( rejoin )
+    {
+        QMetaObject::invokeMethod( room, "handleRejoinRequest", Qt::QueuedConnection,
+                Q_ARG( ClientConnection*, clientConnection ),
+                Q_ARG( QString, name ) );
+    }
+    else
+    {
+        QMetaObject::invokeMethod( room, "handleJoinRequest", Qt::QueuedConnection,
+                Q_ARG( ClientConnection*, clientConnection ),
+                Q_ARG( QString, name ),
+                Q_ARG( QString, password ) );
+    }
+}
+
+
+bool
+Server::requestRoomLeave( ClientConnection* clientConnection )
+{
+    if( !mClientConnectionRoomMap.contains( clientConnection ) ) return false;
+
+    // A handoff that hasn't happened yet is simply cancelled.
+    if( mPendingHandOffClientConnections.remove( clientConnection ) )
+    {
+        mClientConnectionRoomMap.remove( clientConnection );
+        return false;
+    }
+
+    // If the room is already being torn down it will hand the connection
+    // back on its own.
+    ServerRoom* room = mRoomMap.value( mClientConnectionRoomMap.value( clientConnection ), nullptr );
+    if( room != nullptr )
+    {
+        QMetaObject::invokeMethod( room, "handleLeaveRequest", Qt::QueuedConnection,
+                Q_ARG( ClientConnection*, clientConnection ) );
+    }
+    return true;
+}
+
+
+void
+Server::handleRoomClientConnectionReleased( ClientConnection* clientConnection )
+{
+    mLogger->debug( "client {} handed back from room {}", (std::size_t)clientConnection,
+            mClientConnectionRoomMap.value( clientConnection ) );
+
+    mClientConnectionRoomMap.remove( clientConnection );
+    clientConnection->setTimerWheel( mTimerWheel );
+
+    if( mDisconnectedClientConnections.remove( clientConnection ) )
+    {
+        finishClientDisconnect( clientConnection );
+    }
+}
+
+
+void
+Server::handleRoomHumanPlayerAdded( unsigned int roomId, const QString& name )
+{
+    // Ignore rooms that were torn down before this arrived.
+    if( !mRoomMap.contains( roomId ) ) return;
+
+    mHumanRoomMap.insert( name.toStdString(), roomId );
+}
+
+
+void
+Server::handleRoomHumanPlayerRemoved( const QString& name )
+{
+    mHumanRoomMap.remove( name.toStdString() );
+}
+
+
 void
 Server::handleRoomsInfoDiffBroadcastTimerTimeout()
 {
@@ -840,6 +1047,7 @@ Server::handleRoomsInfoDiffBroadcastTimerTimeout()
 }
 
 
+
 void
 Server::abridgeRoomConfig( proto::RoomConfig* roomConfig )
 {
@@ -5,17 +5,20 @@
 
 QT_BEGIN_NAMESPACE
 class QNetworkSession;
-class QTimer;
 QT_END_NAMESPACE
 
 #include <QAbstractSocket>
 #include <QList>
 #include <QMap>
+#include <QSet>
 #include <memory>
 
 #include "messages.pb.h"
 #include "AllSetsData.h"
+#include "BoosterTemplate.h"
+#include "CustomCardListRegistry.h"
 #include "RoomConfigValidator.h"
+#include "TimerWheel.h"
 
 #include "Logging.h"
 
@@ -24,6 +27,8 @@ class ClientConnection;
 class ServerRoom;
 class ServerSettings;
 class ClientNotices;
+class RoomWorkerPool;
+class TimerWheelDriver;
 
 class Server : public QObject
 {
@@ -59,11 +64,16 @@ private slots:
     void handleAnnouncementsUpdate( const QString& text );
     void handleAlertUpdate( const QString& text );
 
-    void handleRoomPlayerCountChanged( int playerCount );
-    void handleRoomExpired();
-    void handleRoomError();
+    void handleRoomPlayerCountChanged( unsigned int roomId, int playerCount );
+    void handleRoomExpired( unsigned int roomId );
+    void handleRoomError( unsigned int roomId );
+    void handleRoomClientConnectionReleased( ClientConnection* clientConnection );
+    void handleRoomHumanPlayerAdded( unsigned int roomId, const QString& name );
+    void handleRoomHumanPlayerRemoved( const QString& name );
 
-    void handleRoomsInfoDiffBroadcastTimerTimeout();
+    // Second half of handOffClientConnection(), run from the event loop.
+    void completeClientConnectionHandOff( ClientConnection* clientConnection, unsigned int roomId,
+                                          const QString& name, const QString& password, bool rejoin );
 
 private:  // Methods
 
@@ -87,6 +97,7 @@ private:  // Methods
     // Arms the timer to send out a rooms info diff broadcast, unless
     // it was already armed.
     void armRoomsInfoDiffBroadcastTimer();
+    void handleRoomsInfoDiffBroadcastTimerTimeout();
 
     // Send a baseline users information message to a client.
     void sendBaselineUsersInfo( ClientConnection* clientConnection );
@@ -94,8 +105,22 @@ private:  // Methods
     // Broadcast users information differences to all clients.
     void broadcastUsersInfoDiffs();
 
-    // Teardown a room after expiration or error.
-    void teardownRoom( ServerRoom* room );
+    // Teardown a room after expiration or error.  Does nothing if the
+    // room was already torn down.
+    void teardownRoom( unsigned int roomId );
+
+    // Move a connection to a room's thread and have the room join it.
+    // The move is deferred to the event loop since this is reached from
+    // within the connection's own message handling.
+    void handOffClientConnection( ClientConnection* clientConnection, ServerRoom* room,
+                                  const std::string& name, const std::string& password, bool rejoin );
+
+    // Ask the room a connection was handed off to, if any, to hand it back.
+    // Returns false if the connection isn't in a room.
+    bool requestRoomLeave( ClientConnection* clientConnection );
+
+    // Final cleanup of a disconnected connection once it's back on this thread.
+    void finishClientDisconnect( ClientConnection* clientConnection );
 
     // Remove detailed information from a room configuration.
     static void abridgeRoomConfig( proto::RoomConfig* roomConfig );
@@ -105,6 +130,9 @@ private:  // Data
     const quint16                      mPort;
     std::shared_ptr<ServerSettings>    mSettings;
     std::shared_ptr<const AllSetsData> mAllSetsData;
+
+    // Booster templates are shared by the dispensers of all rooms.
+    std::shared_ptr<const BoosterTemplateCache> mBoosterTemplateCache;
     std::shared_ptr<ClientNotices>     mClientNotices;
 
     QNetworkSession*                    mNetworkSession;
@@ -112,17 +140,43 @@ private:  // Data
     QMap<ClientConnection*,std::string> mClientConnectionLoginMap;
 
     RoomConfigValidator                 mRoomConfigValidator;
+
+    // Custom card lists are shared by rooms and referred to by clients
+    // by content hash.
+    CustomCardListRegistry              mCustomCardListRegistry;
     unsigned int                        mNextRoomId;
     QMap<unsigned int,ServerRoom*>      mRoomMap;
 
+    // Rooms run on worker threads, so the lobby keeps its own view of
+    // what it needs from them, updated by their signals.
+    QMap<unsigned int,int>                mRoomWorkerIndexMap;
+    QMap<unsigned int,int>                mRoomPlayerCountMap;
+    QMap<std::string,unsigned int>        mHumanRoomMap;
+
+    // Connections handed off to rooms, by room ID, until handed back.
+    // Disconnections of handed-off connections are finished when the
+    // connection comes back.
+    QMap<ClientConnection*,unsigned int>  mClientConnectionRoomMap;
+    QSet<ClientConnection*>               mDisconnectedClientConnections;
+
+    // Connections claimed by a room but not yet moved to its thread.
+    QSet<ClientConnection*>               mPendingHandOffClientConnections;
+
     QList<int>       mRoomsInfoDiffAddedRoomIds;
     QList<int>       mRoomsInfoDiffRemovedRoomIds;
-    QMap<int,int>    mRoomsInfoDiffPlayerCountsMap;
-    QTimer*          mRoomsInfoDiffBroadcastTimer;
+    QMap<int,int>       mRoomsInfoDiffPlayerCountsMap;
+    TimerWheel::Handle  mRoomsInfoDiffBroadcastHandle;
 
     QList<std::string> mUsersInfoDiffAddedNames;
     QList<std::string> mUsersInfoDiffRemovedNames;
 
+    // Timer wheel for the lobby thread, shared by the connections living
+    // on it.  Each room worker thread has its own.
+    TimerWheelDriver*           mTimerWheelDriver;
+    std::shared_ptr<TimerWheel> mTimerWheel;
+
+    RoomWorkerPool*             mRoomWorkerPool;
+
     uint64_t mTotalDisconnectedClientBytesSent;
     uint64_t mTotalDisconnectedClientBytesReceived;
 
@@ -0,0 +1,63 @@
+#include "ServerMsgBuilder.h"
+
+#include <QThreadStorage>
+#include <google/protobuf/arena.h>
+#include <vector>
+
+// Size of the block each thread's arena starts on.  Large enough for all
+// but the biggest messages (e.g. full rooms lists).
+static const std::size_t ARENA_BLOCK_SIZE = 32 * 1024;
+
+
+struct ServerMsgBuilder::ArenaState
+{
+    ArenaState()
+      : block( ARENA_BLOCK_SIZE ),
+        arena( makeArenaOptions( block ) ),
+        depth( 0 )
+    {}
+
+    static google::protobuf::ArenaOptions makeArenaOptions( std::vector<char>& block )
+    {
+        google::protobuf::ArenaOptions options;
+        options.initial_block = block.data();
+        options.initial_block_size = block.size();
+        return options;
+    }
+
+    std::vector<char>       block;
+    google::protobuf::Arena arena;
+    int                     depth;
+};
+
+
+ServerMsgBuilder::ServerMsgBuilder()
+  : mArenaState( getArenaState() )
+{
+    mArenaState->depth++;
+    mMsg = google::protobuf::Arena::CreateMessage<proto::ServerToClientMsg>( &mArenaState->arena );
+}
+
+
+ServerMsgBuilder::~ServerMsgBuilder()
+{
+    // Messages from enclosing builders are still in use until the
+    // outermost one is done.
+    if( --mArenaState->depth == 0 )
+    {
+        mArenaState->arena.Reset();
+    }
+}
+
+
+ServerMsgBuilder::ArenaState*
+ServerMsgBuilder::getArenaState()
+{
+    // Deleted by QThreadStorage when the thread exits.
+    static QThreadStorage<ArenaState*> sArenaStates;
+    if( !sArenaStates.hasLocalData() )
+    {
+        sArenaStates.setLocalData( new ArenaState() );
+    }
+    return sArenaStates.localData();
+}
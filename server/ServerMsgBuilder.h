@@ -0,0 +1,36 @@
+#ifndef SERVERMSGBUILDER_H
+#define SERVERMSGBUILDER_H
+
+#include "messages.pb.h"
+
+// Builds an outgoing message on a per-thread protobuf arena instead of the
+// heap.  The arena starts on a preallocated block and is reset once the
+// outermost builder on the thread goes away, so building typical messages
+// doesn't allocate.  Builders may nest; each message lives as long as its
+// builder.
+//
+//     ServerMsgBuilder msgBuilder;
+//     proto::ServerToClientMsg& msg = msgBuilder.getMsg();
+//
+class ServerMsgBuilder
+{
+public:
+
+    ServerMsgBuilder();
+    ~ServerMsgBuilder();
+
+    proto::ServerToClientMsg& getMsg() { return *mMsg; }
+
+private:
+
+    ServerMsgBuilder( const ServerMsgBuilder& );
+    ServerMsgBuilder& operator=( const ServerMsgBuilder& );
+
+    struct ArenaState;
+    static ArenaState* getArenaState();
+
+    ArenaState* const         mArenaState;
+    proto::ServerToClientMsg* mMsg;
+};
+
+#endif  // SERVERMSGBUILDER_H
@@ -3,20 +3,24 @@
 #include <stdlib.h>
 #include <memory>
 
+#include <QCoreApplication>
 #include <QTimer>
 
 #include "ClientConnection.h"
+#include "ServerMsgBuilder.h"
 #include "HumanPlayer.h"
 #include "BotPlayer.h"
 #include "StupidBotPlayer.h"
 
 static const int CREATED_ROOM_EXPIRATION_SECONDS   =  10;
 static const int ABANDONED_ROOM_EXPIRATION_SECONDS = 120;
+static const int DECK_INFO_BROADCAST_DELAY_MILLIS  = 500;
 
 ServerRoom::ServerRoom( unsigned int                      roomId,
                         const std::string&                password,
                         const proto::RoomConfig&          roomConfig,
                         const DraftCardDispenserSharedPtrVector<DraftCard>& dispensers,
+                        const std::shared_ptr<TimerWheel>& timerWheel,
                         const Logging::Config&            loggingConfig,
                         QObject*                          parent )
 :   QObject( parent ),
@@ -27,9 +31,15 @@ ServerRoom::ServerRoom( unsigned int                      roomId,
     mChairCount( mRoomConfig.draft_config().chair_count() ),
     mBotPlayerCount( mRoomConfig.bot_count() ),
     mDraftComplete( false ),
+    mTimerWheel( timerWheel ),
+    mRoomExpirationHandle( TimerWheel::INVALID_HANDLE ),
+    mDraftTickHandle( TimerWheel::INVALID_HANDLE ),
+    mDraftTickDueMillis( 0 ),
     mPublicStatePresent( false ),
     mPostRoundTimerActive( false ),
     mPostRoundTimerTicksRemaining( 0 ),
+    mBoosterDraftStateTicksSinceFull( 0 ),
+    mDeckInfoBroadcastHandle( TimerWheel::INVALID_HANDLE ),
     mLoggingConfig( loggingConfig ),
     mLogger( mLoggingConfig.createLogger() )
 {
@@ -46,7 +56,7 @@ ServerRoom::initialize()
     if( (mChairCount <= 0) )
     {
         mLogger->error( "invalid room configuration!" );
-        emit roomExpired();
+        emit roomExpired( mRoomId );
         return;
     }
 
@@ -59,16 +69,10 @@ ServerRoom::initialize()
     mDraftPtr = new DraftType( mRoomConfig.draft_config(), mDispensers );
     mDraftPtr->addObserver( this );
 
-    mRoomExpirationTimer = new QTimer( this );
-    connect( mRoomExpirationTimer, &QTimer::timeout, this, &ServerRoom::roomExpired );
-
     // Start the room expiration timer immediately.  Normally the creating
     // client will join it immediately, but if that doesn't happen the room
     // needs to be cleaned up.
-    mRoomExpirationTimer->start( CREATED_ROOM_EXPIRATION_SECONDS * 1000 );
-
-    mDraftTimer = new QTimer( this );
-    connect(mDraftTimer, SIGNAL(timeout()), this, SLOT(handleDraftTimerTick()));
+    startRoomExpirationTimer( CREATED_ROOM_EXPIRATION_SECONDS );
 
     // Add in the bots.
     unsigned int botPlayerCount = mBotPlayerCount;
@@ -89,7 +93,7 @@ ServerRoom::initialize()
         mChairStateList[ chairIndex ] = CHAIR_STATE_READY;
 
         // The bot must observe the draft to get the observation callbacks.
-        mDraftPtr->addObserver( bot );
+        mDraftPtr->addChairObserver( chairIndex, bot );
 
         // Slot the bots into every other chair to be as fair as possible
         // to the real players.
@@ -104,7 +108,7 @@ ServerRoom::initialize()
 
     if( botPlayerCount > 0 )
     {
-        emit playerCountChanged( getPlayerCount() );
+        emit playerCountChanged( mRoomId, getPlayerCount() );
     }
 }
 
@@ -112,6 +116,9 @@ ServerRoom::initialize()
 ServerRoom::~ServerRoom()
 {
     mLogger->trace( "~ServerRoom" );
+    stopRoomExpirationTimer();
+    stopDraftTimer();
+    mTimerWheel->cancel( mDeckInfoBroadcastHandle );
     for (int i = 0; i < mBotList.size(); ++i)
     {
         delete mBotList.at(i);
@@ -168,15 +175,17 @@ ServerRoom::join( ClientConnection* clientConnection, const std::string& name, c
     }
 
     // With at least one connection don't let the room expire.
-    mRoomExpirationTimer->stop();
+    stopRoomExpirationTimer();
 
     // The human must observe the draft to get the observation callbacks.
-    mDraftPtr->addObserver( human );
+    mDraftPtr->addChairObserver( human->getChairIndex(), human );
+
+    emit humanPlayerAdded( mRoomId, QString::fromStdString( name ) );
 
     // Inform the client that the room join was successful.
     sendJoinRoomSuccessRspInd( clientConnection, mRoomId, false, chairIndex );
 
-    emit playerCountChanged( getPlayerCount() );
+    emit playerCountChanged( mRoomId, getPlayerCount() );
 
     // Inform all client connections of the room occupants changes.
     broadcastRoomOccupantsInfo();
@@ -210,7 +219,7 @@ ServerRoom::leave( ClientConnection* clientConnection )
             if( mClientConnectionMap.isEmpty() )
             {
                 mLogger->debug( "starting room expiration timer" );
-                mRoomExpirationTimer->start( ABANDONED_ROOM_EXPIRATION_SECONDS * 1000 );
+                startRoomExpirationTimer( ABANDONED_ROOM_EXPIRATION_SECONDS );
             }
         }
         else
@@ -219,6 +228,7 @@ ServerRoom::leave( ClientConnection* clientConnection )
 
             mDraftPtr->removeObserver( human );
             mHumanList.removeOne( human );
+            emit humanPlayerRemoved( QString::fromStdString( human->getName() ) );
             delete human;
 
             // Null out player list entry and mark chair state as empty
@@ -229,11 +239,11 @@ ServerRoom::leave( ClientConnection* clientConnection )
             // connections treat it as expired.
             if( mClientConnectionMap.isEmpty() )
             {
-                emit roomExpired();
+                emit roomExpired( mRoomId );
             }
         }
 
-        emit playerCountChanged( getPlayerCount() );
+        emit playerCountChanged( mRoomId, getPlayerCount() );
 
         // Inform all client connections of the room occupants changes.
         broadcastRoomOccupantsInfo();
@@ -278,12 +288,12 @@ ServerRoom::rejoin( ClientConnection* clientConnection, const std::string& name
     }
 
     // With at least one connection don't let the room expire.
-    mRoomExpirationTimer->stop();
+    stopRoomExpirationTimer();
 
     // Send the user a room join success indication with the rejoin flag set.
     sendJoinRoomSuccessRspInd( clientConnection, mRoomId, true, chairIndex );
 
-    emit playerCountChanged( getPlayerCount() );
+    emit playerCountChanged( mRoomId, getPlayerCount() );
 
     // Inform all occupants (including the new user) of user states.
     broadcastRoomOccupantsInfo();
@@ -292,7 +302,8 @@ ServerRoom::rejoin( ClientConnection* clientConnection, const std::string& name
     humanPlayer->sendInventoryToClient();
 
     // Send user a room stage update indication.
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::RoomStageInd* roomStageInd = msg.mutable_room_stage_ind();
     switch( mDraftPtr->getState() )
     {
@@ -330,6 +341,12 @@ ServerRoom::rejoin( ClientConnection* clientConnection, const std::string& name
 
         // Update the client's public state, if any.
         sendPublicState( { clientConnection } );
+
+        // Update the client's booster draft chair states.
+        if( mDraftPtr->isBoosterRound() )
+        {
+            sendBoosterDraftState( { clientConnection } );
+        }
     }
 
     // Send all current hashes if the round is complete.
@@ -397,7 +414,8 @@ ServerRoom::sendJoinRoomSuccessRspInd( ClientConnection* clientConnection,
                                        int               chairIndex )
 {
     mLogger->trace( "sendJoinRoomSuccessRspInd" );
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::JoinRoomSuccessRspInd* joinRoomSuccessRspInd = msg.mutable_join_room_success_rspind();
     joinRoomSuccessRspInd->set_room_id( roomId );
     joinRoomSuccessRspInd->set_rejoin( rejoin );
@@ -415,7 +433,8 @@ void
 ServerRoom::sendJoinRoomFailureRsp( ClientConnection* clientConnection, proto::JoinRoomFailureRsp_ResultType result, int roomId )
 {
     mLogger->trace( "sendJoinRoomFailureRsp, result={}, roomId={}", result, roomId );
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::JoinRoomFailureRsp* joinRoomFailureRsp = msg.mutable_join_room_failure_rsp();
     joinRoomFailureRsp->set_result( result );
     joinRoomFailureRsp->set_room_id( roomId );
@@ -429,7 +448,8 @@ ServerRoom::broadcastRoomOccupantsInfo()
     mLogger->trace( "broadcastRoomOccupantsInfo" );
 
     // Assemble the message.
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::RoomOccupantsInfoInd* roomOccupantsInfoInd = msg.mutable_room_occupants_info_ind();
     roomOccupantsInfoInd->set_room_id( mRoomId );
 
@@ -456,26 +476,25 @@ ServerRoom::broadcastRoomOccupantsInfo()
     const int protoSize = msg.ByteSize();
 
     // Send the message to each client connection.
-    for( auto clientConn : mClientConnectionMap.keys())
-    {
-        mLogger->debug( "sending roomOccupantsInfoInd, size={} to client {}",
-                protoSize, (std::size_t)clientConn );
-        clientConn->sendProtoMsg( msg );
-    }
+    mLogger->debug( "sending roomOccupantsInfoInd, size={} to {} clients",
+            protoSize, mClientConnectionMap.size() );
+    ClientConnection::multicastProtoMsg( msg, mClientConnectionMap.keys() );
 }
 
 
+// Interval at which a full booster draft state goes out regardless of
+// changes, to correct any drift in client countdowns.
+static const int BOOSTER_DRAFT_STATE_FULL_INTERVAL_TICKS = 30;
+
+
 void
-ServerRoom::broadcastBoosterDraftState()
+ServerRoom::sendBoosterDraftState( const QList<ClientConnection*> clientConnections )
 {
-    // OPTIMIZATION - could cache the outgoing message to cut down on
-    // redundant messages going out.  Pack queue size changes create at least
-    // two redundant message per event.
-
     // Build the message.
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::BoosterDraftStateInd* ind = msg.mutable_booster_draft_state_ind();
-    ind->set_millis_until_next_sec( mDraftTimer->remainingTime() );
+    ind->set_millis_until_next_sec( getMillisUntilNextDraftTick() );
 
     for( int i = 0; i < mDraftPtr->getChairCount(); ++i )
     {
@@ -487,13 +506,100 @@ ServerRoom::broadcastBoosterDraftState()
 
     const int protoSize = msg.ByteSize();
 
-    // Send the message to all active client connections.
-    for( ClientConnection* clientConnection : mClientConnectionMap.keys() )
+    mLogger->debug( "sending boosterDraftStateInd, size={} to {} clients",
+            protoSize, clientConnections.size() );
+    ClientConnection::multicastProtoMsg( msg, clientConnections );
+}
+
+
+void
+ServerRoom::broadcastBoosterDraftStateChanges()
+{
+    const int chairCount = mDraftPtr->getChairCount();
+
+    // Send everything if there's nothing to compare against or if it's
+    // time for a periodic full update.
+    const bool full = (mBoosterDraftStateSnapshot.size() != static_cast<std::size_t>( chairCount )) ||
+                      (mBoosterDraftStateTicksSinceFull >= BOOSTER_DRAFT_STATE_FULL_INTERVAL_TICKS);
+    if( full )
     {
-        mLogger->debug( "sending roomChairsInfoInd, size={} to client {}",
-                protoSize, (std::size_t)clientConnection );
-        clientConnection->sendProtoMsg( msg );
+        mBoosterDraftStateSnapshot.assign( chairCount, { -1, -1 } );
+        mBoosterDraftStateTicksSinceFull = 0;
+    }
+
+    // Build the message from the chairs that changed.
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
+    proto::BoosterDraftStateInd* ind = msg.mutable_booster_draft_state_ind();
+    ind->set_millis_until_next_sec( getMillisUntilNextDraftTick() );
+    ind->set_delta( !full );
+
+    for( int i = 0; i < chairCount; ++i )
+    {
+        BoosterDraftChairState& state = mBoosterDraftStateSnapshot[i];
+        const int queuedPacks = mDraftPtr->getPackQueueSize( i );
+        const int timeRemaining = mDraftPtr->getTicksRemaining( i );
+
+        if( !full && (queuedPacks == state.queuedPacks) && (timeRemaining == state.timeRemaining) ) continue;
+
+        state.queuedPacks = queuedPacks;
+        state.timeRemaining = timeRemaining;
+
+        proto::BoosterDraftStateInd::Chair* chair = ind->add_chairs();
+        chair->set_chair_index( i );
+        chair->set_queued_packs( queuedPacks );
+        chair->set_time_remaining( timeRemaining );
+    }
+
+    // Clients older than 4.1 don't count chairs down on their own, so
+    // they get the full state every time as before.
+    QList<ClientConnection*> deltaClientConnections;
+    QList<ClientConnection*> fullClientConnections;
+    for( auto clientConnection : mClientConnectionMap.keys() )
+    {
+        if( full || !clientConnection->getProtocolVersion().olderThan( 4, 1 ) )
+        {
+            deltaClientConnections.push_back( clientConnection );
+        }
+        else
+        {
+            fullClientConnections.push_back( clientConnection );
+        }
+    }
+
+    if( !fullClientConnections.isEmpty() )
+    {
+        sendBoosterDraftState( fullClientConnections );
+    }
+
+    if( ind->chairs_size() == 0 )
+    {
+        mLogger->trace( "booster draft state unchanged" );
+        return;
     }
+
+    const int protoSize = msg.ByteSize();
+
+    // Send the message to the rest of the client connections.
+    mLogger->debug( "sending boosterDraftStateInd, delta={} chairs={} size={} to {} clients",
+            ind->delta(), ind->chairs_size(), protoSize, deltaClientConnections.size() );
+    ClientConnection::multicastProtoMsg( msg, deltaClientConnections );
+}
+
+
+void
+ServerRoom::advanceBoosterDraftStateSnapshot()
+{
+    // Count down the same way clients do: a second off every chair that
+    // has packs queued and time left.
+    for( auto& state : mBoosterDraftStateSnapshot )
+    {
+        if( (state.queuedPacks > 0) && (state.timeRemaining > 0) )
+        {
+            state.timeRemaining--;
+        }
+    }
+    mBoosterDraftStateTicksSinceFull++;
 }
 
 
@@ -506,7 +612,8 @@ ServerRoom::sendPublicState( const QList<ClientConnection*> clientConnections )
         return;
     }
 
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::PublicStateInd* publicStateInd = msg.mutable_public_state_ind();
 
     publicStateInd->set_pack_id( mPublicPackId );
@@ -514,49 +621,49 @@ ServerRoom::sendPublicState( const QList<ClientConnection*> clientConnections )
     {
         proto::PublicStateInd::CardState* cardState = publicStateInd->add_card_states();
         proto::Card* card = cardState->mutable_card();
-        card->set_name( state.getCard().name );
-        card->set_set_code( state.getCard().setCode );
+        card->set_name( state.getCard().getName() );
+        card->set_set_code( state.getCard().getSetCode() );
         cardState->set_selected_chair_index( state.getSelectedChairIndex() );
         cardState->set_selected_order( state.getSelectedOrder() );
     }
     publicStateInd->set_active_chair_index( mPublicActiveChairIndex );
 
     publicStateInd->set_time_remaining_secs( mDraftPtr->getTicksRemaining( mPublicActiveChairIndex ) );
-    publicStateInd->set_millis_until_next_sec( mDraftTimer->remainingTime() );
+    publicStateInd->set_millis_until_next_sec( getMillisUntilNextDraftTick() );
 
     const int protoSize = msg.ByteSize();
 
     // Send the message to all active client connections.
-    for( ClientConnection* clientConnection : clientConnections )
-    {
-        mLogger->debug( "sending PublicStateInd, size={} to client {}",
-                protoSize, (std::size_t)clientConnection );
-        clientConnection->sendProtoMsg( msg );
-    }
+    mLogger->debug( "sending PublicStateInd, size={} to {} clients",
+            protoSize, clientConnections.size() );
+    ClientConnection::multicastProtoMsg( msg, clientConnections );
 }
 
 
 void
-ServerRoom::broadcastRoomChairsDeckInfo( const HumanPlayer& human )
+ServerRoom::broadcastRoomChairsDeckInfo( const QList<HumanPlayer*>& humans )
 {
+    if( humans.isEmpty() ) return;
+
     // Build the message.
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::RoomChairsDeckInfoInd* ind = msg.mutable_room_chairs_deck_info_ind();
 
-    proto::RoomChairsDeckInfoInd::Chair* chair = ind->add_chairs();
-    chair->set_chair_index( human.getChairIndex() );
-    chair->set_cockatrice_hash( human.getCockatriceHash().toStdString() );
-    chair->set_mws_hash( "" );
+    for( const HumanPlayer* human : humans )
+    {
+        proto::RoomChairsDeckInfoInd::Chair* chair = ind->add_chairs();
+        chair->set_chair_index( human->getChairIndex() );
+        chair->set_cockatrice_hash( human->getCockatriceHash().toStdString() );
+        chair->set_mws_hash( "" );
+    }
 
     const int protoSize = msg.ByteSize();
 
     // Send the message to all active client connections.
-    for( ClientConnection* clientConnection : mClientConnectionMap.keys() )
-    {
-        mLogger->debug( "sending roomChairsDeckInfoInd, size={} to client {}",
-                protoSize, (std::size_t)clientConnection );
-        clientConnection->sendProtoMsg( msg );
-    }
+    mLogger->debug( "sending roomChairsDeckInfoInd, size={} to {} clients",
+            protoSize, mClientConnectionMap.size() );
+    ClientConnection::multicastProtoMsg( msg, mClientConnectionMap.keys() );
 }
 
 
@@ -567,11 +674,15 @@ ServerRoom::handleDraftTimerTick()
 
     if( mPostRoundTimerActive ) mPostRoundTimerTicksRemaining--;
 
+    // Advance the snapshot before ticking so that any changes made by the
+    // tick itself are measured against what clients have counted down to.
+    advanceBoosterDraftStateSnapshot();
+
     mDraftPtr->tick();
 
     if( (mDraftPtr->getState() == DraftType::STATE_RUNNING) && (mDraftPtr->isBoosterRound()) )
     {
-        broadcastBoosterDraftState();
+        broadcastBoosterDraftStateChanges();
     }
 }
 
@@ -625,7 +736,7 @@ ServerRoom::handleHumanReadyUpdate( bool ready )
     if( allChairsReady )
     {
         mLogger->info( "starting the draft!" );
-        mDraftTimer->start( 1000 );
+        startDraftTimer();
         mDraftPtr->start();
     }
 }
@@ -636,24 +747,41 @@ ServerRoom::handleHumanDeckUpdate()
 {
     mLogger->trace( "handleHumanDeckUpdate" );
 
-    // If the draft is complete, broadcast the deck update message.
+    // If the draft is complete, queue the deck update message.
     if( mDraftComplete )
     {
         HumanPlayer *human = qobject_cast<HumanPlayer*>( QObject::sender() );
-        broadcastRoomChairsDeckInfo( *human );
+        if( !mDeckInfoPendingHumans.contains( human ) )
+        {
+            mDeckInfoPendingHumans.append( human );
+        }
 
-        // OPTIMIZATION - this is going to send a lot of messages as
-        // players manipulate decks.  Bundle updates an send out on a timer.
+        if( !mTimerWheel->isScheduled( mDeckInfoBroadcastHandle ) )
+        {
+            mDeckInfoBroadcastHandle = mTimerWheel->schedule( DECK_INFO_BROADCAST_DELAY_MILLIS,
+                    [this] { handleDeckInfoBroadcastTimeout(); } );
+        }
     }
 }
 
 
+void
+ServerRoom::handleDeckInfoBroadcastTimeout()
+{
+    mDeckInfoBroadcastHandle = TimerWheel::INVALID_HANDLE;
+
+    QList<HumanPlayer*> humans;
+    humans.swap( mDeckInfoPendingHumans );
+    broadcastRoomChairsDeckInfo( humans );
+}
+
+
 void
 ServerRoom::notifyPackQueueSizeChanged( DraftType& draft, int chairIndex, int packQueueSize )
 {
     mLogger->trace( "chair {} packQueueSize={}", chairIndex, packQueueSize );
 
-    broadcastBoosterDraftState();
+    broadcastBoosterDraftStateChanges();
 }
 
 
@@ -689,7 +817,8 @@ ServerRoom::notifyPostRoundTimerStarted( DraftType& draft, int roundIndex, int t
     const uint32_t postRoundTimeRemainingMillis = getPostRoundTimeRemainingMillis();
 
     // Send user a room stage update indication.
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::RoomStageInd* roomStageInd = msg.mutable_room_stage_ind();
     roomStageInd->set_stage( proto::RoomStageInd::STAGE_RUNNING );
     proto::RoomStageInd::RoundInfo* roundInfo = roomStageInd->mutable_round_info();
@@ -701,11 +830,7 @@ ServerRoom::notifyPostRoundTimerStarted( DraftType& draft, int roundIndex, int t
             protoSize, roomStageInd->round_info().round(), postRoundTimeRemainingMillis );
 
     // Send the message to all active client connections.
-    for( ClientConnection* clientConnection : mClientConnectionMap.keys() )
-    {
-        mLogger->debug( "sending to client {}", (std::size_t)clientConnection );
-        clientConnection->sendProtoMsg( msg );
-    }
+    ClientConnection::multicastProtoMsg( msg, mClientConnectionMap.keys() );
 }
 
 
@@ -716,8 +841,13 @@ ServerRoom::notifyNewRound( DraftType& draft, int roundIndex )
     mPublicStatePresent = false;
     mPostRoundTimerActive = false;
 
+    // Clients stop their countdowns on a new round, so start over with a
+    // full booster draft state.
+    mBoosterDraftStateSnapshot.clear();
+
     // Send user a room stage update indication.
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::RoomStageInd* roomStageInd = msg.mutable_room_stage_ind();
     roomStageInd->set_stage( proto::RoomStageInd::STAGE_RUNNING );
     proto::RoomStageInd::RoundInfo* roundInfo = roomStageInd->mutable_round_info();
@@ -728,11 +858,7 @@ ServerRoom::notifyNewRound( DraftType& draft, int roundIndex )
             protoSize, roomStageInd->round_info().round() );
 
     // Send the message to all active client connections.
-    for( ClientConnection* clientConnection : mClientConnectionMap.keys() )
-    {
-        mLogger->debug( "sending to client {}", (std::size_t)clientConnection );
-        clientConnection->sendProtoMsg( msg );
-    }
+    ClientConnection::multicastProtoMsg( msg, mClientConnectionMap.keys() );
 }
 
 
@@ -740,7 +866,7 @@ void
 ServerRoom::notifyDraftComplete( DraftType& draft )
 {
     mLogger->debug( "draft complete, stopping timer" );
-    mDraftTimer->stop();
+    stopDraftTimer();
 
     // This may not have been active, but safe to set false.
     mPostRoundTimerActive = false;
@@ -748,7 +874,8 @@ ServerRoom::notifyDraftComplete( DraftType& draft )
     mDraftComplete = true;
 
     // Send user a room stage update indication.
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     proto::RoomStageInd* roomStageInd = msg.mutable_room_stage_ind();
     roomStageInd->set_stage( proto::RoomStageInd::STAGE_COMPLETE );
 
@@ -756,19 +883,10 @@ ServerRoom::notifyDraftComplete( DraftType& draft )
     mLogger->debug( "sending RoomStageInd (STAGE_COMPLETE), size={}", protoSize );
 
     // Send the message to all active client connections.
-    for( ClientConnection* clientConnection : mClientConnectionMap.keys() )
-    {
-        mLogger->debug( "sending to client {}", (std::size_t)clientConnection );
-        clientConnection->sendProtoMsg( msg );
-    }
+    ClientConnection::multicastProtoMsg( msg, mClientConnectionMap.keys() );
 
     // Send out all current hash values.
-    // OPTIMIZATION - the message allows for multiple hashes, so this
-    // could easily go out as a single message.
-    for( auto human : mHumanList )
-    {
-        broadcastRoomChairsDeckInfo( *human );
-    }
+    broadcastRoomChairsDeckInfo( mHumanList );
 }
 
 
@@ -776,19 +894,16 @@ void
 ServerRoom::notifyDraftError( DraftType& draft )
 {
     // Send user a room error indication.
-    proto::ServerToClientMsg msg;
+    ServerMsgBuilder msgBuilder;
+    proto::ServerToClientMsg& msg = msgBuilder.getMsg();
     (void*) msg.mutable_room_error_ind();
     int protoSize = msg.ByteSize();
     mLogger->debug( "sending RoomErrorInd, size={}", protoSize );
 
     // Send the message to all active client connections.
-    for( ClientConnection* clientConnection : mClientConnectionMap.keys() )
-    {
-        mLogger->debug( "sending to client {}", (std::size_t)clientConnection );
-        clientConnection->sendProtoMsg( msg );
-    }
+    ClientConnection::multicastProtoMsg( msg, mClientConnectionMap.keys() );
 
-    emit roomError();
+    emit roomError( mRoomId );
 }
 
 int
@@ -816,6 +931,140 @@ ServerRoom::getPostRoundTimeRemainingMillis() const
     if( !mPostRoundTimerActive ) return -1;
 
     // Convert ticks to milliseconds and subtract off the 1-second timer value.
-    return (mPostRoundTimerTicksRemaining * 1000) - (1000 - mDraftTimer->remainingTime());
+    return (mPostRoundTimerTicksRemaining * 1000) - (1000 - getMillisUntilNextDraftTick());
+}
+
+
+void
+ServerRoom::handleJoinRequest( ClientConnection* clientConnection, const QString& name, const QString& password )
+{
+    adoptClientConnection( clientConnection );
+
+    int chairIndex = -1;
+    if( !join( clientConnection, name.toStdString(), password.toStdString(), chairIndex ) )
+    {
+        // This is normal, e.g. room full or bad password.
+        mLogger->info( "{} failed to join room", name.toStdString() );
+        releaseClientConnection( clientConnection );
+    }
+}
+
+
+void
+ServerRoom::handleRejoinRequest( ClientConnection* clientConnection, const QString& name )
+{
+    adoptClientConnection( clientConnection );
+
+    if( !rejoin( clientConnection, name.toStdString() ) )
+    {
+        // This should never happen but it's not critical, it just means
+        // the user isn't in the room.
+        mLogger->warn( "{} failed to rejoin room!", name.toStdString() );
+        releaseClientConnection( clientConnection );
+    }
+}
+
+
+void
+ServerRoom::handleLeaveRequest( ClientConnection* clientConnection )
+{
+    // The connection may have already been handed back after a failed
+    // join; if so it's no longer ours to touch.
+    if( !mClientConnectionMap.contains( clientConnection ) )
+    {
+        mLogger->debug( "leave request for connection {} not in room", (std::size_t)clientConnection );
+        return;
+    }
+
+    leave( clientConnection );
+    releaseClientConnection( clientConnection );
+}
+
+
+void
+ServerRoom::releaseClientConnections()
+{
+    for( auto iter = mClientConnectionMap.begin(); iter != mClientConnectionMap.end(); ++iter )
+    {
+        iter.value()->removeClientConnection();
+        releaseClientConnection( iter.key() );
+    }
+    mClientConnectionMap.clear();
+}
+
+
+void
+ServerRoom::adoptClientConnection( ClientConnection* clientConnection )
+{
+    clientConnection->setTimerWheel( mTimerWheel );
+}
+
+
+void
+ServerRoom::releaseClientConnection( ClientConnection* clientConnection )
+{
+    clientConnection->moveToOwnerThread( QCoreApplication::instance()->thread() );
+    emit clientConnectionReleased( clientConnection );
+}
+
+
+void
+ServerRoom::startRoomExpirationTimer( int seconds )
+{
+    mTimerWheel->cancel( mRoomExpirationHandle );
+    mRoomExpirationHandle = mTimerWheel->schedule( seconds * 1000,
+            [this]
+            {
+                mRoomExpirationHandle = TimerWheel::INVALID_HANDLE;
+                emit roomExpired( mRoomId );
+            } );
+}
+
+
+void
+ServerRoom::stopRoomExpirationTimer()
+{
+    mTimerWheel->cancel( mRoomExpirationHandle );
+    mRoomExpirationHandle = TimerWheel::INVALID_HANDLE;
+}
+
+
+void
+ServerRoom::startDraftTimer()
+{
+    // First tick on the whole second at least a second from now.
+    mDraftTickDueMillis = ((mTimerWheel->getNowMillis() + 1999) / 1000) * 1000;
+
+    mTimerWheel->cancel( mDraftTickHandle );
+    mDraftTickHandle = mTimerWheel->scheduleAt( mDraftTickDueMillis,
+            [this] { handleDraftTimerWheelTimeout(); } );
+}
+
+
+void
+ServerRoom::stopDraftTimer()
+{
+    mTimerWheel->cancel( mDraftTickHandle );
+    mDraftTickHandle = TimerWheel::INVALID_HANDLE;
+}
+
+
+void
+ServerRoom::handleDraftTimerWheelTimeout()
+{
+    // Re-arm from the due time rather than the current time so that the
+    // tick stays on whole seconds even if the wheel ran late.
+    mDraftTickDueMillis += 1000;
+    mDraftTickHandle = mTimerWheel->scheduleAt( mDraftTickDueMillis,
+            [this] { handleDraftTimerWheelTimeout(); } );
+
+    handleDraftTimerTick();
+}
+
+
+int
+ServerRoom::getMillisUntilNextDraftTick() const
+{
+    return mTimerWheel->getMillisRemaining( mDraftTickHandle );
 }
 
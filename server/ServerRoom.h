@@ -3,10 +3,6 @@
 
 #include <QObject>
 
-QT_BEGIN_NAMESPACE
-class QTimer;
-QT_END_NAMESPACE
-
 #include <QList>
 #include <QMap>
 #include <memory>
@@ -16,6 +12,7 @@ QT_END_NAMESPACE
 
 #include "Logging.h"
 #include "DraftTypes.h"
+#include "TimerWheel.h"
 
 class ConnectionServer;
 class ClientConnection;
@@ -44,6 +41,7 @@ public:
                 const std::string&                                  password,
                 const proto::RoomConfig&                            roomConfig,
                 const DraftCardDispenserSharedPtrVector<DraftCard>& dispensers,
+                const std::shared_ptr<TimerWheel>&                  timerWheel,
                 const Logging::Config&                              loggingConfig = Logging::Config(),
                 QObject*                                            parent = 0 );
 
@@ -58,10 +56,6 @@ public:
     // Count of players currently in room.
     unsigned int getPlayerCount() const { return mBotList.size() + mHumanList.size(); }
 
-    bool containsConnection( ClientConnection* clientConnection ) const { return mClientConnectionMap.contains( clientConnection ); }
-    bool containsHumanPlayer( const std::string& name ) const { return getHumanPlayer( name ) != nullptr; }
-    QList<ClientConnection*> getClientConnections() const { return mClientConnectionMap.keys(); }
-
     // Join a user connection to the room.
     bool join( ClientConnection* clientConnection, const std::string& name, const std::string& password, int& chairIndex );
 
@@ -83,11 +77,34 @@ public:
         return mRoomConfig;
     }
 
+public slots:
+
+    // Requests from the lobby.  A room may live on a worker thread, so
+    // these are invoked as queued calls.  A connection passed to a join or
+    // rejoin request has already been moved to the room's thread; the room
+    // hands it back to the lobby thread, signalling clientConnectionReleased(),
+    // if the join fails or when the connection leaves.
+    void handleJoinRequest( ClientConnection* clientConnection, const QString& name, const QString& password );
+    void handleRejoinRequest( ClientConnection* clientConnection, const QString& name );
+    void handleLeaveRequest( ClientConnection* clientConnection );
+
+    // Hand back all connections, e.g. before the room is destroyed.
+    void releaseClientConnections();
+
 signals:
 
-    void playerCountChanged( int playerCount );
-    void roomExpired();
-    void roomError();
+    // Room signals carry the room ID since they may be delivered after
+    // the room has been destroyed on its thread.
+    void playerCountChanged( unsigned int roomId, int playerCount );
+    void roomExpired( unsigned int roomId );
+    void roomError( unsigned int roomId );
+
+    void clientConnectionReleased( ClientConnection* clientConnection );
+
+    // Human players are kept by name while in the room, including while
+    // departed so that they can rejoin.
+    void humanPlayerAdded( unsigned int roomId, const QString& name );
+    void humanPlayerRemoved( const QString& name );
 
 private slots:
 
@@ -106,15 +123,31 @@ private:  // Methods
                                  proto::JoinRoomFailureRsp_ResultType result,
                                  int                                  roomId );
     void broadcastRoomOccupantsInfo();
-    void broadcastBoosterDraftState();
+    void sendBoosterDraftState( const QList<ClientConnection*> clientConnections );
+    void broadcastBoosterDraftStateChanges();
+    void advanceBoosterDraftStateSnapshot();
     void sendPublicState( const QList<ClientConnection*> clientConnections );
-    void broadcastRoomChairsDeckInfo( const HumanPlayer& human );
+    void broadcastRoomChairsDeckInfo( const QList<HumanPlayer*>& humans );
+    void handleDeckInfoBroadcastTimeout();
 
     int getNextAvailablePlayerIndex() const;
     HumanPlayer* getHumanPlayer( const std::string& name ) const;
 
     int getPostRoundTimeRemainingMillis() const;
 
+    void adoptClientConnection( ClientConnection* clientConnection );
+    void releaseClientConnection( ClientConnection* clientConnection );
+
+    void startRoomExpirationTimer( int seconds );
+    void stopRoomExpirationTimer();
+
+    // Draft ticks are aligned to whole seconds of the timer wheel so that
+    // the ticks of all rooms are handled together.
+    void startDraftTimer();
+    void stopDraftTimer();
+    void handleDraftTimerWheelTimeout();
+    int getMillisUntilNextDraftTick() const;
+
     // --- Draft Observer BEGIN ---
     virtual void notifyPackQueueSizeChanged( DraftType& draft, int chairIndex, int packQueueSize ) override;
     virtual void notifyNewPack( DraftType& draft, int chairIndex, uint32_t packId, const std::vector<DraftCard>& unselectedCards ) override {}
@@ -141,8 +174,10 @@ private:  // Data
     DraftType* mDraftPtr;
     bool       mDraftComplete;
 
-    QTimer *mRoomExpirationTimer;
-    QTimer *mDraftTimer;
+    std::shared_ptr<TimerWheel> mTimerWheel;
+    TimerWheel::Handle          mRoomExpirationHandle;
+    TimerWheel::Handle          mDraftTickHandle;
+    uint64_t                    mDraftTickDueMillis;
 
     // Lists of specific occupant types.
     QList<BotPlayer*>   mBotList;
@@ -171,6 +206,22 @@ private:  // Data
     bool mPostRoundTimerActive;
     int  mPostRoundTimerTicksRemaining;
 
+    // Booster draft chair state as last sent to clients, advanced each
+    // tick the same way clients count down locally.  Only chairs that
+    // differ from it need to be sent.
+    struct BoosterDraftChairState
+    {
+        int queuedPacks;
+        int timeRemaining;
+    };
+    std::vector<BoosterDraftChairState> mBoosterDraftStateSnapshot;
+    int                                 mBoosterDraftStateTicksSinceFull;
+
+    // Deck changes come in bursts while players build; hashes of changed
+    // decks are broadcast together after a short delay.
+    QList<HumanPlayer*> mDeckInfoPendingHumans;
+    TimerWheel::Handle  mDeckInfoBroadcastHandle;
+
     Logging::Config                 mLoggingConfig;
     std::shared_ptr<spdlog::logger> mLogger;
 };
@@ -1,8 +1,12 @@
 #include "ServerSettings.h"
 
 #include <QSettings>
+#include "CompressionPolicy.h"
 
 const QString KEY_SERVER_NAME = "servername";
+const QString KEY_COMPRESSION_LEVEL = "compressionlevel";
+const QString KEY_COMPRESSION_THRESHOLD = "compressionthreshold";
+const QString KEY_ROOM_WORKER_THREADS = "roomworkerthreads";
 
 
 static void
@@ -21,6 +25,9 @@ ServerSettings::ServerSettings( QObject* parent )
     mSettings = new QSettings( "thicketserver.ini", QSettings::IniFormat, this );
 
     setValueIfEmpty( mSettings, KEY_SERVER_NAME, "Thicket Server" );
+    setValueIfEmpty( mSettings, KEY_COMPRESSION_LEVEL, CompressionPolicy::DEFAULT_LEVEL );
+    setValueIfEmpty( mSettings, KEY_COMPRESSION_THRESHOLD, CompressionPolicy::DEFAULT_THRESHOLD );
+    setValueIfEmpty( mSettings, KEY_ROOM_WORKER_THREADS, -1 );
 }
 
 
@@ -29,3 +36,24 @@ ServerSettings::getServerName()
 {
     return mSettings->value( KEY_SERVER_NAME ).toString();
 }
+
+
+int
+ServerSettings::getCompressionLevel()
+{
+    return mSettings->value( KEY_COMPRESSION_LEVEL ).toInt();
+}
+
+
+int
+ServerSettings::getCompressionThreshold()
+{
+    return mSettings->value( KEY_COMPRESSION_THRESHOLD ).toInt();
+}
+
+
+int
+ServerSettings::getRoomWorkerThreadCount()
+{
+    return mSettings->value( KEY_ROOM_WORKER_THREADS ).toInt();
+}
@@ -17,6 +17,14 @@ public:
 
     QString getServerName();
 
+    // zlib level and minimum payload size for compressing client messages.
+    int getCompressionLevel();
+    int getCompressionThreshold();
+
+    // Threads to run rooms on; 0 runs rooms on the main thread and a
+    // negative value picks a count from the number of cores.
+    int getRoomWorkerThreadCount();
+
 private:
 
     QSettings* mSettings;
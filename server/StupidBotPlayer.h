@@ -21,11 +21,11 @@ public:
         SimpleRandGen rng;
         const int index = rng.generateInRange( 0, unselectedCards.size() - 1 );
         DraftCard stupidCardToSelect = unselectedCards[index];
-        mLogger->info( "StupidBot<{}> selecting card {} ({})", getChairIndex(), stupidCardToSelect.name, index );
+        mLogger->info( "StupidBot<{}> selecting card {} ({})", getChairIndex(), stupidCardToSelect.getName(), index );
         bool result = draft.makeNamedCardSelection( getChairIndex(), packId, stupidCardToSelect );
         if( !result )
         {
-            mLogger->warn( "error selecting card {}", stupidCardToSelect.name );
+            mLogger->warn( "error selecting card {}", stupidCardToSelect.getName() );
         }
     }
 
@@ -0,0 +1,31 @@
+#include "TimerWheelDriver.h"
+
+#include <QTimer>
+
+
+TimerWheelDriver::TimerWheelDriver( unsigned int tickMillis, QObject* parent )
+  : QObject( parent ),
+    mTimerWheel( std::make_shared<TimerWheel>( tickMillis ) ),
+    mTimer( 0 )
+{}
+
+
+void
+TimerWheelDriver::start()
+{
+    if( mTimer ) return;
+
+    mClock.start();
+    mTimer = new QTimer( this );
+    connect( mTimer, &QTimer::timeout, this, &TimerWheelDriver::handleTimerTimeout );
+    mTimer->start( mTimerWheel->getTickMillis() );
+}
+
+
+void
+TimerWheelDriver::handleTimerTimeout()
+{
+    // Fire everything that came due since the last tick, including any
+    // ticks this timer was late for.
+    mTimerWheel->advanceTo( mClock.elapsed() );
+}
@@ -0,0 +1,42 @@
+#ifndef TIMERWHEELDRIVER_H
+#define TIMERWHEELDRIVER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <memory>
+
+#include "TimerWheel.h"
+
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
+// Advances a timer wheel from a single periodic QTimer.  The wheel and
+// everything scheduled on it belong to the thread this object lives in.
+class TimerWheelDriver : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    TimerWheelDriver( unsigned int tickMillis, QObject* parent = 0 );
+
+    const std::shared_ptr<TimerWheel>& getTimerWheel() const { return mTimerWheel; }
+
+public slots:
+
+    // Must be called from the owning thread.
+    void start();
+
+private slots:
+
+    void handleTimerTimeout();
+
+private:
+
+    const std::shared_ptr<TimerWheel> mTimerWheel;
+    QTimer*                           mTimer;
+    QElapsedTimer                     mClock;
+};
+
+#endif  // TIMERWHEELDRIVER_H
@@ -12,6 +12,7 @@
 #include "qtutils_core.h"
 
 #include "MtgJsonAllSetsData.h"
+#include "SnapshotAllSetsData.h"
 #include "CardPoolSelector.h"
 #include "SimpleRandGen.h"
 
@@ -22,6 +23,53 @@
 
 static std::shared_ptr<spdlog::logger> gLogger;
 
+
+// Write a set data snapshot to a new file in the same directory, check
+// that it loads, and swap it into place.  A reader never maps a partially
+// written snapshot, even if this process dies or another server is
+// writing one at the same time.
+static bool
+writeAllSetsSnapshot( const MtgJsonAllSetsData& allSetsData,
+                      const QString&            snapshotFilePath,
+                      const std::string&        version,
+                      const Logging::Config&    loggingConfig )
+{
+    const QString newSnapshotFilePath = QString( "%1.new.%2" )
+            .arg( snapshotFilePath ).arg( QCoreApplication::applicationPid() );
+    const std::string newSnapshotFilePathStr = newSnapshotFilePath.toStdString();
+
+    FILE* fp = fopen( newSnapshotFilePathStr.c_str(), "wb" );
+    if( fp == NULL )
+    {
+        gLogger->warn( "Unable to create set data snapshot {}", newSnapshotFilePathStr );
+        return false;
+    }
+    bool writeOk = allSetsData.writeSnapshot( fp, version );
+    writeOk = (fclose( fp ) == 0) && writeOk;
+
+    if( writeOk )
+    {
+        SnapshotAllSetsData snapshotAllSetsData( loggingConfig );
+        writeOk = snapshotAllSetsData.load( newSnapshotFilePathStr, version );
+    }
+    if( !writeOk )
+    {
+        gLogger->warn( "Failed to write set data snapshot {}", newSnapshotFilePathStr );
+        QFile::remove( newSnapshotFilePath );
+        return false;
+    }
+
+    QFile::remove( snapshotFilePath );
+    if( !QFile::rename( newSnapshotFilePath, snapshotFilePath ) )
+    {
+        gLogger->warn( "Failed to rename {} to {}", newSnapshotFilePathStr, snapshotFilePath );
+        QFile::remove( newSnapshotFilePath );
+        return false;
+    }
+    return true;
+}
+
+
 int main(int argc, char *argv[])
 {
     qsrand( QTime(0,0,0).secsTo( QTime::currentTime() ) );
@@ -29,6 +77,7 @@ int main(int argc, char *argv[])
     Logging::Config loggingConfig;
     loggingConfig.setName( "server" );
     loggingConfig.setStdoutLogging( true );
+    loggingConfig.setAsyncLogging( true );
     loggingConfig.setLevel( spdlog::level::info );
 
     gLogger = loggingConfig.createLogger();
@@ -164,19 +213,47 @@ int main(int argc, char *argv[])
     }
 
     //
-    // Create the JSON set data instance.
+    // Create the set data instance.
     //
 
-    // Raw non-const pointer is for initial parse, shared pointer to const
-    // is used later but ensures cleanup on error.
-    auto allSetsData = new MtgJsonAllSetsData();
-    auto allSetsDataSharedPtr = std::shared_ptr<const AllSetsData>( allSetsData );
-    bool parseResult = allSetsData->parse( allSetsDataFile );
-    fclose( allSetsDataFile );
-    if( !parseResult )
+    // A precompiled snapshot is used if one exists for this exact
+    // AllSets.json, keyed by the file's size and modification time.
+    // Otherwise the JSON is parsed and a snapshot written for next time.
+    const QFileInfo allSetsFileInfo( QString::fromStdString( allSetsFilePath ) );
+    const std::string allSetsDataVersion = QString( "%1-%2" )
+            .arg( allSetsFileInfo.size() )
+            .arg( allSetsFileInfo.lastModified().toMSecsSinceEpoch() ).toStdString();
+    const std::string allSetsSnapshotFilePath = allSetsDir.filePath( "AllSets.snapshot" ).toStdString();
+
+    std::shared_ptr<const AllSetsData> allSetsDataSharedPtr;
+    auto snapshotAllSetsData = new SnapshotAllSetsData( loggingConfig.createChildConfig( "snapshot" ) );
+    if( snapshotAllSetsData->load( allSetsSnapshotFilePath, allSetsDataVersion ) )
+    {
+        gLogger->info( "Loaded set data snapshot {}", allSetsSnapshotFilePath );
+        allSetsDataSharedPtr.reset( snapshotAllSetsData );
+        fclose( allSetsDataFile );
+    }
+    else
     {
-        gLogger->critical( "Failed to parse AllSets.json!" );
-        return ERROR_CODE_DATAERR;
+        delete snapshotAllSetsData;
+
+        // Raw non-const pointer is for initial parse, shared pointer to const
+        // is used later but ensures cleanup on error.
+        auto allSetsData = new MtgJsonAllSetsData();
+        allSetsDataSharedPtr.reset( allSetsData );
+        bool parseResult = allSetsData->parse( allSetsDataFile );
+        fclose( allSetsDataFile );
+        if( !parseResult )
+        {
+            gLogger->critical( "Failed to parse AllSets.json!" );
+            return ERROR_CODE_DATAERR;
+        }
+
+        if( writeAllSetsSnapshot( *allSetsData, QString::fromStdString( allSetsSnapshotFilePath ),
+                                  allSetsDataVersion, loggingConfig.createChildConfig( "snapshot" ) ) )
+        {
+            gLogger->info( "Wrote set data snapshot {}", allSetsSnapshotFilePath );
+        }
     }
 
     //
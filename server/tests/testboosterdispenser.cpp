@@ -28,6 +28,7 @@ CATCH_TEST_CASE( "BoosterDispenser", "[boosterdispenser]" )
         fclose( allSetsDataFile );
         CATCH_REQUIRE( parseResult );
     }
+    static auto boosterTemplateCache = std::make_shared<const BoosterTemplateCache>( allSetsSharedPtr );
 
     //
     // Create baseline proto messages that test cases can tweak.
@@ -38,20 +39,20 @@ CATCH_TEST_CASE( "BoosterDispenser", "[boosterdispenser]" )
 
     CATCH_SECTION( "Sunny Day" )
     {
-        BoosterDispenser disp( dispenserSpec, allSetsSharedPtr, loggingConfig );
+        BoosterDispenser disp( dispenserSpec, boosterTemplateCache, loggingConfig );
         CATCH_REQUIRE( disp.isValid() );
     }
 
     CATCH_SECTION( "Bad Set Code" )
     {
         dispenserSpec.set_source_booster_set_codes( 0, "" );
-        BoosterDispenser disp( dispenserSpec, allSetsSharedPtr, loggingConfig );
+        BoosterDispenser disp( dispenserSpec, boosterTemplateCache, loggingConfig );
         CATCH_REQUIRE( !disp.isValid() );
     }
 
     CATCH_SECTION( "Dispensing all" )
     {
-        BoosterDispenser disp( dispenserSpec, allSetsSharedPtr, loggingConfig );
+        BoosterDispenser disp( dispenserSpec, boosterTemplateCache, loggingConfig );
         CATCH_REQUIRE( disp.isValid() );
         std::vector<DraftCard> cardsDispensed;
         for( int i = 0; i < 10; ++i )
@@ -65,7 +66,7 @@ CATCH_TEST_CASE( "BoosterDispenser", "[boosterdispenser]" )
 
     CATCH_SECTION( "Dispensing one" )
     {
-        BoosterDispenser disp( dispenserSpec, allSetsSharedPtr, loggingConfig );
+        BoosterDispenser disp( dispenserSpec, boosterTemplateCache, loggingConfig );
         CATCH_REQUIRE( disp.isValid() );
         std::vector<DraftCard> cardsDispensed;
         for( int i = 0; i < 100; ++i )
@@ -32,7 +32,8 @@ CATCH_TEST_CASE( "CardDispenserFactory", "[carddispenserfactory]" )
     }
 
     // Static to avoid reconstruction/parsing for every test case.
-    static CardDispenserFactory factory( allSetsSharedPtr, loggingConfig );
+    static auto boosterTemplateCache = std::make_shared<const BoosterTemplateCache>( allSetsSharedPtr );
+    static CardDispenserFactory factory( boosterTemplateCache, loggingConfig );
 
     CATCH_SECTION( "Booster Dispensers" )
     {
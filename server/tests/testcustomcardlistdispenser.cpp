@@ -1,6 +1,8 @@
 #include "catch.hpp"
 #include "messages.pb.h"
 #include "CustomCardListDispenser.h"
+#include "MtgJsonAllSetsData.h"
+#include <cstdio>
 
 using namespace proto;
 
@@ -61,8 +63,81 @@ CATCH_TEST_CASE( "CustomCardListDispenser", "[customcardlistdispenser]" )
             cardsDispensed.insert( cardsDispensed.end(), d.begin(), d.end() );
         }
         CATCH_REQUIRE( cardsDispensed.size() == 60 );
-        CATCH_REQUIRE( std::count_if( cardsDispensed.begin(), cardsDispensed.end(), [] (const DraftCard& dc) { return dc.name == "card1"; } ) == 10 );
-        CATCH_REQUIRE( std::count_if( cardsDispensed.begin(), cardsDispensed.end(), [] (const DraftCard& dc) { return dc.name == "card2"; } ) == 20 );
-        CATCH_REQUIRE( std::count_if( cardsDispensed.begin(), cardsDispensed.end(), [] (const DraftCard& dc) { return dc.name == "card3"; } ) == 30 );
+        CATCH_REQUIRE( std::count_if( cardsDispensed.begin(), cardsDispensed.end(), [] (const DraftCard& dc) { return dc.getName() == "card1"; } ) == 10 );
+        CATCH_REQUIRE( std::count_if( cardsDispensed.begin(), cardsDispensed.end(), [] (const DraftCard& dc) { return dc.getName() == "card2"; } ) == 20 );
+        CATCH_REQUIRE( std::count_if( cardsDispensed.begin(), cardsDispensed.end(), [] (const DraftCard& dc) { return dc.getName() == "card3"; } ) == 30 );
+    }
+
+    CATCH_SECTION( "Dispensing Remainder" )
+    {
+        customCardListSpec.clear_card_quantities();
+
+        for( int i = 0; i < 3; ++i )
+        {
+            int cardNum = i + 1;
+            DraftConfig::CustomCardList::CardQuantity* cardQty = customCardListSpec.add_card_quantities();
+            cardQty->set_quantity( cardNum );
+            cardQty->set_set_code( "TST" );
+            cardQty->set_name( "card" + std::to_string(cardNum) );
+        }
+        CustomCardListDispenser disp( dispenserSpec, customCardListSpec, loggingConfig );
+        CATCH_REQUIRE( disp.isValid() );
+
+        // Dispensing all after a partial dispense yields the rest of the pool.
+        std::vector<DraftCard> cardsDispensed = disp.dispense( 4 );
+        CATCH_REQUIRE( cardsDispensed.size() == 4 );
+        auto rest = disp.dispenseAll();
+        CATCH_REQUIRE( rest.size() == 2 );
+        cardsDispensed.insert( cardsDispensed.end(), rest.begin(), rest.end() );
+        CATCH_REQUIRE( std::count_if( cardsDispensed.begin(), cardsDispensed.end(), [] (const DraftCard& dc) { return dc.getName() == "card1"; } ) == 1 );
+        CATCH_REQUIRE( std::count_if( cardsDispensed.begin(), cardsDispensed.end(), [] (const DraftCard& dc) { return dc.getName() == "card2"; } ) == 2 );
+        CATCH_REQUIRE( std::count_if( cardsDispensed.begin(), cardsDispensed.end(), [] (const DraftCard& dc) { return dc.getName() == "card3"; } ) == 3 );
+
+        // The pool is then whole again.
+        CATCH_REQUIRE( disp.dispenseAll().size() == 6 );
+        CATCH_REQUIRE( disp.dispense( 12 ).size() == 12 );
+        CATCH_REQUIRE( disp.getPoolSize() == 6 );
+    }
+
+    CATCH_SECTION( "Set Codes Filled In" )
+    {
+        auto allSetsData = std::make_shared<MtgJsonAllSetsData>();
+        FILE* jsonFile = tmpfile();
+        CATCH_REQUIRE( jsonFile != NULL );
+        fputs( R"({ "TST": { "name": "Test", "type": "core", "releaseDate": "2000-01-01",
+                              "cards": [ { "name": "Test Card", "rarity": "Common" } ] } })", jsonFile );
+        rewind( jsonFile );
+        CATCH_REQUIRE( allSetsData->parse( jsonFile ) );
+        fclose( jsonFile );
+
+        customCardListSpec.clear_card_quantities();
+        const std::vector<std::pair<std::string,std::string>> cards = {
+                { "Test Card", "" }, { "test card", "" }, { "Test Card", "XXX" }, { "No Such Card", "" } };
+        for( const auto& card : cards )
+        {
+            DraftConfig::CustomCardList::CardQuantity* cardQty = customCardListSpec.add_card_quantities();
+            cardQty->set_quantity( 1 );
+            cardQty->set_name( card.first );
+            cardQty->set_set_code( card.second );
+        }
+
+        // Known cards get the set they resolve to, replacing unknown set
+        // codes; unknown cards are left alone.
+        auto pool = CustomCardListDispenser::createCardPool( customCardListSpec, allSetsData );
+        CATCH_REQUIRE( pool->size() == 4 );
+        CATCH_REQUIRE( (*pool)[0].getSetCode() == "TST" );
+        CATCH_REQUIRE( (*pool)[1].getSetCode() == "TST" );
+        CATCH_REQUIRE( (*pool)[1].getName() == "test card" );
+        CATCH_REQUIRE( (*pool)[2].getSetCode() == "TST" );
+        CATCH_REQUIRE( (*pool)[3].getSetCode() == "" );
+        CATCH_REQUIRE_FALSE( DraftCard::find( "Test Card", "XXX" ).isValid() );
+
+        // Fresh unknown set codes don't grow the card table.
+        customCardListSpec.mutable_card_quantities( 2 )->set_set_code( "YYY" );
+        CustomCardListDispenser::createCardPool( customCardListSpec, allSetsData );
+        CATCH_REQUIRE_FALSE( DraftCard::find( "Test Card", "YYY" ).isValid() );
+
+        pool = CustomCardListDispenser::createCardPool( customCardListSpec );
+        CATCH_REQUIRE( (*pool)[0].getSetCode() == "" );
     }
 }
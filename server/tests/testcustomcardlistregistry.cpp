@@ -0,0 +1,100 @@
+#include "catch.hpp"
+#include "messages.pb.h"
+#include "CustomCardListRegistry.h"
+
+using namespace proto;
+
+CATCH_TEST_CASE( "CustomCardListRegistry", "[customcardlistregistry]" )
+{
+    Logging::Config loggingConfig;
+    loggingConfig.setName( "customcardlistregistry" );
+    loggingConfig.setStdoutLogging( true );
+    loggingConfig.setLevel( spdlog::level::debug );
+
+    DraftConfig::CustomCardList customCardListSpec;
+    customCardListSpec.set_name( "Test List" );
+    for( int i = 0; i < 3; ++i )
+    {
+        DraftConfig::CustomCardList::CardQuantity* cardQty = customCardListSpec.add_card_quantities();
+        cardQty->set_quantity( i + 1 );
+        cardQty->set_set_code( "TST" );
+        cardQty->set_name( "card" + std::to_string( i + 1 ) );
+    }
+
+    std::string contentHash;
+
+    CATCH_SECTION( "Register and Find" )
+    {
+        CustomCardListRegistry registry( 1, nullptr, loggingConfig );
+        auto pool = registry.registerList( customCardListSpec, contentHash );
+        CATCH_REQUIRE( pool );
+        CATCH_REQUIRE( pool->size() == 6 );
+        CATCH_REQUIRE( !contentHash.empty() );
+        CATCH_REQUIRE( registry.getCount() == 1 );
+
+        CATCH_REQUIRE( registry.find( contentHash ) == pool );
+        CATCH_REQUIRE( !registry.find( "bogus" ) );
+    }
+
+    CATCH_SECTION( "Same Cards Share a Pool" )
+    {
+        CustomCardListRegistry registry( 1, nullptr, loggingConfig );
+        auto pool = registry.registerList( customCardListSpec, contentHash );
+
+        // Renamed, reordered and split entries are the same list.
+        DraftConfig::CustomCardList otherSpec;
+        otherSpec.set_name( "Other Name" );
+        for( int i = customCardListSpec.card_quantities_size() - 1; i >= 0; --i )
+        {
+            const DraftConfig::CustomCardList::CardQuantity& cardQty = customCardListSpec.card_quantities( i );
+            for( unsigned int q = 0; q < cardQty.quantity(); ++q )
+            {
+                DraftConfig::CustomCardList::CardQuantity* otherQty = otherSpec.add_card_quantities();
+                *otherQty = cardQty;
+                otherQty->set_quantity( 1 );
+            }
+        }
+
+        std::string otherContentHash;
+        auto otherPool = registry.registerList( otherSpec, otherContentHash );
+        CATCH_REQUIRE( otherContentHash == contentHash );
+        CATCH_REQUIRE( otherPool == pool );
+        CATCH_REQUIRE( registry.getCount() == 1 );
+
+        // Different cards are a different list.
+        customCardListSpec.mutable_card_quantities( 0 )->set_quantity( 5 );
+        auto differentPool = registry.registerList( customCardListSpec, otherContentHash );
+        CATCH_REQUIRE( otherContentHash != contentHash );
+        CATCH_REQUIRE( differentPool != pool );
+    }
+
+    CATCH_SECTION( "Empty List" )
+    {
+        CustomCardListRegistry registry( 1, nullptr, loggingConfig );
+        customCardListSpec.clear_card_quantities();
+        CATCH_REQUIRE( !registry.registerList( customCardListSpec, contentHash ) );
+        CATCH_REQUIRE( registry.getCount() == 0 );
+    }
+
+    CATCH_SECTION( "Retention" )
+    {
+        // Nothing is retained beyond its users.
+        CustomCardListRegistry registry( 0, nullptr, loggingConfig );
+        auto pool = registry.registerList( customCardListSpec, contentHash );
+        CATCH_REQUIRE( registry.find( contentHash ) );
+        pool.reset();
+        CATCH_REQUIRE( !registry.find( contentHash ) );
+        CATCH_REQUIRE( registry.getCount() == 0 );
+
+        // The most recently used list is retained.
+        CustomCardListRegistry retainingRegistry( 1, nullptr, loggingConfig );
+        retainingRegistry.registerList( customCardListSpec, contentHash );
+        CATCH_REQUIRE( retainingRegistry.find( contentHash ) );
+
+        customCardListSpec.mutable_card_quantities( 0 )->set_quantity( 5 );
+        std::string otherContentHash;
+        retainingRegistry.registerList( customCardListSpec, otherContentHash );
+        CATCH_REQUIRE( !retainingRegistry.find( contentHash ) );
+        CATCH_REQUIRE( retainingRegistry.find( otherContentHash ) );
+    }
+}
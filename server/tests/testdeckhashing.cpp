@@ -113,3 +113,59 @@ CATCH_TEST_CASE( "DeckHashing", "[deckhashing]" )
         CATCH_REQUIRE( hash == "g233t401" );
     }
 }
+
+
+CATCH_TEST_CASE( "DeckHashing incremental", "[deckhashing]" )
+{
+    CockatriceDeckHasher hasher;
+    CATCH_REQUIRE( hasher.getHash() == "r8sq7riu" );
+
+    CATCH_SECTION( "Matches a full computation as cards move" )
+    {
+        hasher.addCard( "Fireball", PlayerInventory::ZONE_MAIN );
+        hasher.addCard( "Chainer's Edict", PlayerInventory::ZONE_AUTO );
+        hasher.addCard( "Disenchant", PlayerInventory::ZONE_SIDEBOARD );
+        hasher.moveCard( "Chainer's Edict", PlayerInventory::ZONE_AUTO, PlayerInventory::ZONE_MAIN );
+        hasher.moveCard( "Disenchant", PlayerInventory::ZONE_SIDEBOARD, PlayerInventory::ZONE_MAIN );
+        CATCH_REQUIRE( hasher.getHash() == "9ed4d2v3" );
+
+        hasher.addCard( "Fireball", PlayerInventory::ZONE_SIDEBOARD );
+        hasher.addCard( "Chainer's Edict", PlayerInventory::ZONE_SIDEBOARD );
+        hasher.addCard( "Disenchant", PlayerInventory::ZONE_SIDEBOARD );
+        CATCH_REQUIRE( hasher.getHash() == "fi8ie39c" );
+
+        // Junk doesn't count.
+        hasher.moveCard( "Fireball", PlayerInventory::ZONE_SIDEBOARD, PlayerInventory::ZONE_JUNK );
+        hasher.moveCard( "Fireball", PlayerInventory::ZONE_JUNK, PlayerInventory::ZONE_SIDEBOARD );
+        CATCH_REQUIRE( hasher.getHash() == "fi8ie39c" );
+    }
+
+    CATCH_SECTION( "Split cards and duplicates" )
+    {
+        hasher.addCard( "Fire/Ice", PlayerInventory::ZONE_MAIN );
+        hasher.addCard( "Fire / Ice", PlayerInventory::ZONE_MAIN );
+        hasher.addCard( "Fire//Ice", PlayerInventory::ZONE_MAIN );
+        hasher.addCard( "Fire // Ice", PlayerInventory::ZONE_MAIN );
+        CATCH_REQUIRE( hasher.getHash() == "iq0uqup7" );
+
+        hasher.removeCard( "Fire/Ice", PlayerInventory::ZONE_MAIN );
+        hasher.addCard( "Fire // Ice", PlayerInventory::ZONE_MAIN );
+        CATCH_REQUIRE( hasher.getHash() == "iq0uqup7" );
+    }
+
+    CATCH_SECTION( "Basic lands" )
+    {
+        for( auto basic : gBasicLandTypeArray )
+        {
+            hasher.adjustBasicLand( basic, PlayerInventory::ZONE_SIDEBOARD, 2 );
+            hasher.adjustBasicLand( basic, PlayerInventory::ZONE_SIDEBOARD, -1 );
+        }
+        CATCH_REQUIRE( hasher.getHash() == "g233t401" );
+
+        for( auto basic : gBasicLandTypeArray )
+        {
+            hasher.adjustBasicLand( basic, PlayerInventory::ZONE_SIDEBOARD, -1 );
+        }
+        CATCH_REQUIRE( hasher.getHash() == "r8sq7riu" );
+    }
+}
@@ -0,0 +1,57 @@
+#include "catch.hpp"
+#include "DraftCard.h"
+
+CATCH_TEST_CASE( "DraftCard", "[draftcard]" )
+{
+    CATCH_SECTION( "Interning" )
+    {
+        DraftCard a( "Lightning Bolt", "LEA" );
+        DraftCard b( "Lightning Bolt", "LEA" );
+        DraftCard c( "Lightning Bolt", "LEB" );
+        DraftCard d( "Black Lotus", "LEA" );
+
+        CATCH_REQUIRE( a.isValid() );
+        CATCH_REQUIRE( a == b );
+        CATCH_REQUIRE( a.getId() == b.getId() );
+        CATCH_REQUIRE( a != c );
+        CATCH_REQUIRE( a != d );
+
+        CATCH_REQUIRE( a.getName() == "Lightning Bolt" );
+        CATCH_REQUIRE( a.getSetCode() == "LEA" );
+        CATCH_REQUIRE( c.getSetCode() == "LEB" );
+        CATCH_REQUIRE( d.getName() == "Black Lotus" );
+    }
+
+    CATCH_SECTION( "Find doesn't intern" )
+    {
+        DraftCard a( "Counterspell", "LEA" );
+        const unsigned int tableSize = DraftCard::getTableSize();
+
+        CATCH_REQUIRE( DraftCard::find( "Counterspell", "LEA" ) == a );
+
+        DraftCard unknown = DraftCard::find( "No Such Card", "XXX" );
+        CATCH_REQUIRE_FALSE( unknown.isValid() );
+        CATCH_REQUIRE( unknown != a );
+        CATCH_REQUIRE( unknown.getName().empty() );
+        CATCH_REQUIRE( unknown.getSetCode().empty() );
+        CATCH_REQUIRE( DraftCard::getTableSize() == tableSize );
+    }
+
+    CATCH_SECTION( "Default is invalid" )
+    {
+        DraftCard card;
+        CATCH_REQUIRE_FALSE( card.isValid() );
+        CATCH_REQUIRE( card == DraftCard() );
+    }
+
+    CATCH_SECTION( "Many cards" )
+    {
+        // Cross a storage chunk boundary.
+        for( int i = 0; i < 5000; ++i )
+        {
+            DraftCard card( "Card " + std::to_string( i ), "MNY" );
+            CATCH_REQUIRE( card.getName() == "Card " + std::to_string( i ) );
+        }
+        CATCH_REQUIRE( DraftCard::find( "Card 4999", "MNY" ).getName() == "Card 4999" );
+    }
+}
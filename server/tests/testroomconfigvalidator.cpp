@@ -262,8 +262,8 @@ CATCH_TEST_CASE( "RoomConfigPrototype", "[roomconfigprototype]" )
         ccl->set_name( "test list" );
         DraftConfig::CustomCardList::CardQuantity* q = ccl->add_card_quantities();
         q->set_quantity( 1 );
-        q->set_name( "test card" );
-        q->set_name( "TST" );
+        q->set_name( "Lightning Bolt" );
+        q->set_set_code( "LEA" );
 
         DraftConfig::CardDispenser* dispenser = draftConfig->add_dispensers();
         dispenser->set_source_custom_card_list_index( 0 );
@@ -303,5 +303,25 @@ CATCH_TEST_CASE( "RoomConfigPrototype", "[roomconfigprototype]" )
             CATCH_REQUIRE_FALSE( roomConfigValidator.validate( roomConfig, failureResult ) );
             CATCH_REQUIRE( failureResult == CreateRoomFailureRsp::RESULT_INVALID_CUSTOM_CARD_LIST );
         }
+        CATCH_SECTION( "Bad List (unknown card)" )
+        {
+            DraftConfig::CustomCardList::CardQuantity* q2 = ccl->add_card_quantities();
+            q2->set_quantity( 1 );
+            q2->set_name( "No Such Card" );
+            CATCH_REQUIRE_FALSE( roomConfigValidator.validate( roomConfig, failureResult ) );
+            CATCH_REQUIRE( failureResult == CreateRoomFailureRsp::RESULT_INVALID_CUSTOM_CARD_LIST );
+        }
+        CATCH_SECTION( "Card not in its set" )
+        {
+            // Resolved by name in another set.
+            q->set_set_code( "XXX" );
+            CATCH_REQUIRE( roomConfigValidator.validate( roomConfig, failureResult ) );
+        }
+        CATCH_SECTION( "Reference (hash, no cards)" )
+        {
+            ccl->clear_card_quantities();
+            ccl->set_content_hash( "0123456789abcdef" );
+            CATCH_REQUIRE( roomConfigValidator.validate( roomConfig, failureResult ) );
+        }
     }
 }